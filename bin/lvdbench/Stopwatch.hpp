@@ -0,0 +1,28 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include <chrono>
+
+namespace lvd {
+
+// Measures elapsed wall-clock time, for reporting benchmark results.
+class Stopwatch {
+public:
+
+    Stopwatch () : m_start(std::chrono::steady_clock::now()) { }
+
+    // Returns the number of seconds since construction or the previous call to lap, and starts timing the next lap.
+    double lap () {
+        auto now = std::chrono::steady_clock::now();
+        auto retval = std::chrono::duration<double>(now - m_start).count();
+        m_start = now;
+        return retval;
+    }
+
+private:
+
+    std::chrono::steady_clock::time_point m_start;
+};
+
+} // end namespace lvd
@@ -0,0 +1,57 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#include "lvd/BlockFramed.hpp"
+#include "lvd/ByteReader.hpp"
+#include "lvd/ByteWriter.hpp"
+#include "lvd/read_bin_vector.hpp"
+#include "lvd/req.hpp"
+#include "Stopwatch.hpp"
+#include "lvd/test.hpp"
+#include <vector>
+#include "lvd/write_bin_vector.hpp"
+
+namespace lvd {
+
+LVD_TEST_BEGIN(234__BlockFramed__00__throughput)
+    std::vector<uint64_t> values(size_t(1) << 21);
+    for (size_t i = 0; i < values.size(); ++i)
+        values[i] = i*0x9E3779B97F4A7C15;
+
+    ByteWriter out;
+    Stopwatch stopwatch;
+    out << bin_lil_e.out(values);
+    auto unframed_write_seconds = stopwatch.lap();
+    {
+        ByteReader in(out.range());
+        LVD_TEST_REQ_IS_TRUE(bin_lil_e.read<std::vector<uint64_t>>(in) == values);
+    }
+    auto unframed_read_seconds = stopwatch.lap();
+    auto size = double(out.size());
+
+    ByteWriter framed_out;
+    // So that the comparison isn't of ByteWriter reallocation.
+    framed_out.reserve(2*out.size());
+    stopwatch.lap();
+    {
+        BlockFramedWriter_t framed(framed_out);
+        framed << bin_lil_e.out(values);
+        framed.finish();
+    }
+    auto framed_write_seconds = stopwatch.lap();
+    {
+        ByteReader in(framed_out.range());
+        BlockFramedReader_t framed_in(in);
+        LVD_TEST_REQ_IS_TRUE(bin_lil_e.read<std::vector<uint64_t>>(framed_in) == values);
+    }
+    auto framed_read_seconds = stopwatch.lap();
+    LVD_TEST_REQ_IS_TRUE(find_corrupt_blocks(framed_out.range()).empty());
+    auto verify_seconds = stopwatch.lap();
+
+    req_context.log() << Log::inf() << "writing " << size << " bytes, unframed: " << size / unframed_write_seconds / 1e9 << " GB/s"
+                      << ", block-framed: " << size / framed_write_seconds / 1e9 << " GB/s\n"
+                      << "reading, unframed: " << size / unframed_read_seconds / 1e9 << " GB/s"
+                      << ", block-framed: " << size / framed_read_seconds / 1e9 << " GB/s"
+                      << ", find_corrupt_blocks: " << size / verify_seconds / 1e9 << " GB/s\n";
+LVD_TEST_END
+
+} // end namespace lvd
@@ -0,0 +1,56 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#include "lvd/ByteWriter.hpp"
+#include "lvd/read_bin_string.hpp"
+#include "lvd/read_bin_tuple.hpp"
+#include "lvd/read_bin_type.hpp"
+#include "lvd/read_bin_vector.hpp"
+#include "lvd/RecordLog.hpp"
+#include "lvd/req.hpp"
+#include "Stopwatch.hpp"
+#include "lvd/test.hpp"
+#include "lvd/write_bin_string.hpp"
+#include "lvd/write_bin_tuple.hpp"
+#include "lvd/write_bin_type.hpp"
+#include "lvd/write_bin_vector.hpp"
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace lvd {
+
+LVD_TEST_BEGIN(233__RecordLog__00__random_access)
+    using Record = std::tuple<uint32_t,std::string,std::vector<uint16_t>>;
+    auto make_record = [](uint32_t i){
+        return Record{3*i, "record " + std::to_string(i), std::vector<uint16_t>(i % 7, uint16_t(i))};
+    };
+
+    size_t record_count = 20000;
+    ByteWriter out;
+    {
+        RecordLogWriter_t<ByteWriter,decltype(bin_lil_e)> writer(out, bin_lil_e);
+        for (size_t i = 0; i < record_count; ++i)
+            writer.append(make_record(uint32_t(i)));
+    }
+    RecordLogReader_t<decltype(bin_lil_e)> reader(out.range(), bin_lil_e);
+    LVD_TEST_REQ_EQ(reader.record_count(), record_count);
+
+    // Compare reaching a record near the end via the index with decoding every record up to it.
+    size_t record_index = record_count - 10;
+    Stopwatch stopwatch;
+    auto indexed = reader.read<Record>(record_index);
+    auto indexed_seconds = stopwatch.lap();
+
+    Record scanned;
+    for (reader.seek(0); reader.position() <= record_index; )
+        scanned = reader.read_next<Record>();
+    auto scanned_seconds = stopwatch.lap();
+
+    LVD_TEST_REQ_IS_TRUE(indexed == make_record(uint32_t(record_index)));
+    LVD_TEST_REQ_IS_TRUE(scanned == indexed);
+    req_context.log() << Log::inf() << "reading record " << record_index << " of " << record_count
+                      << ": via index: " << indexed_seconds*1e6 << " us"
+                      << ", decoding all preceding records: " << scanned_seconds*1e6 << " us\n";
+LVD_TEST_END
+
+} // end namespace lvd
@@ -0,0 +1,35 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#include "lvd/crc32c.hpp"
+#include "lvd/random.hpp"
+#include "lvd/req.hpp"
+#include "Stopwatch.hpp"
+#include "lvd/test.hpp"
+#include <random>
+#include <vector>
+
+namespace lvd {
+
+LVD_TEST_BEGIN(225__crc32c__00__throughput)
+    std::vector<std::byte> bytes(size_t(1) << 24);
+    auto rng = std::mt19937{42};
+    for (auto &b : bytes)
+        b = std::byte(make_random<uint8_t>(rng));
+
+    auto bytes_per_second = [&bytes](auto const &crc_function, uint32_t &crc){
+        size_t constexpr ITERATION_COUNT = 4;
+        Stopwatch stopwatch;
+        for (size_t i = 0; i < ITERATION_COUNT; ++i)
+            crc = crc_function(bytes.data(), bytes.size(), crc);
+        return double(ITERATION_COUNT*bytes.size()) / stopwatch.lap();
+    };
+    uint32_t crc = 0;
+    uint32_t crc_portable = 0;
+    auto rate = bytes_per_second([](void const *data, size_t size, uint32_t crc){ return crc32c(data, size, crc); }, crc);
+    auto rate_portable = bytes_per_second([](void const *data, size_t size, uint32_t crc){ return crc32c_portable(data, size, crc); }, crc_portable);
+    LVD_TEST_REQ_EQ(crc, crc_portable);
+    req_context.log() << Log::inf() << "crc32c (hardware accelerated: " << crc32c_is_hardware_accelerated() << "): " << rate / 1e9 << " GB/s"
+                      << ", crc32c_portable: " << rate_portable / 1e9 << " GB/s\n";
+LVD_TEST_END
+
+} // end namespace lvd
@@ -0,0 +1,112 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#include "lvd/ByteReader.hpp"
+#include "lvd/ByteWriter.hpp"
+#include "lvd/Columnar_t.hpp"
+#include "lvd/LazyValue_t.hpp"
+#include <map>
+#include "lvd/read_bin_Columnar_t.hpp"
+#include "lvd/read_bin_LazyValue_t.hpp"
+#include "lvd/read_bin_map.hpp"
+#include "lvd/read_bin_string.hpp"
+#include "lvd/read_bin_tuple.hpp"
+#include "lvd/read_bin_vector.hpp"
+#include "lvd/req.hpp"
+#include "Stopwatch.hpp"
+#include <string>
+#include "lvd/test.hpp"
+#include <tuple>
+#include <vector>
+#include "lvd/write_bin_Columnar_t.hpp"
+#include "lvd/write_bin_map.hpp"
+#include "lvd/write_bin_string.hpp"
+#include "lvd/write_bin_tuple.hpp"
+#include "lvd/write_bin_vector.hpp"
+
+namespace lvd {
+
+// Compares the row-wise and columnar encodings, including reading just one column.
+LVD_TEST_BEGIN(231__read_write_bin__00__columnar)
+    using Rows = std::vector<std::tuple<uint32_t,float,uint64_t>>;
+    Rows rows;
+    for (uint32_t i = 0; i < 1000000; ++i)
+        rows.emplace_back(i, float(i), uint64_t(i)*i);
+
+    ByteWriter row_out;
+    ByteWriter column_out;
+    Stopwatch stopwatch;
+    row_out << bin_big_e.out(rows);
+    auto row_write_seconds = stopwatch.lap();
+    column_out << bin_big_e.out(as_columnar(rows));
+    auto column_write_seconds = stopwatch.lap();
+    Rows actual;
+    {
+        ByteReader in(row_out.range());
+        in >> bin_big_e.in(actual);
+    }
+    auto row_read_seconds = stopwatch.lap();
+    LVD_TEST_REQ_IS_TRUE(actual == rows);
+    stopwatch.lap();
+    {
+        ByteReader in(column_out.range());
+        in >> bin_big_e.in(as_columnar(actual));
+    }
+    auto column_read_seconds = stopwatch.lap();
+    LVD_TEST_REQ_IS_TRUE(actual == rows);
+    std::vector<uint64_t> column;
+    stopwatch.lap();
+    {
+        ByteReader in(column_out.range());
+        column = std::get<0>(read_bin_columns<Rows,2>(in, bin_big_e));
+    }
+    auto one_column_read_seconds = stopwatch.lap();
+    LVD_TEST_REQ_EQ(column.size(), rows.size());
+
+    req_context.log() << Log::inf() << rows.size() << " rows, big-endian; row-wise: write " << row_write_seconds << " s, read " << row_read_seconds
+                      << " s; columnar: write " << column_write_seconds << " s, read " << column_read_seconds << " s, read one column " << one_column_read_seconds << " s\n";
+LVD_TEST_END
+
+// Measures how much decoding is saved by length-framing when only one field of each record is used.
+LVD_TEST_BEGIN(231__read_write_bin__01__length_framed)
+    using Record = std::tuple<std::vector<std::string>,std::vector<double>,std::map<uint32_t,std::string>,uint64_t>;
+    using LazyRecord = std::tuple<LazyValue_t<std::vector<std::string>>,LazyValue_t<std::vector<double>>,LazyValue_t<std::map<uint32_t,std::string>>,uint64_t>;
+    std::vector<Record> records;
+    for (uint64_t i = 0; i < 20000; ++i) {
+        Record record;
+        for (uint32_t j = 0; j < 10; ++j) {
+            std::get<0>(record).push_back(std::to_string(i*j));
+            std::get<1>(record).push_back(double(i)/(j+1));
+            std::get<2>(record).emplace(j, std::to_string(i+j));
+        }
+        std::get<3>(record) = i;
+        records.push_back(std::move(record));
+    }
+    ByteWriter unframed_out;
+    ByteWriter framed_out;
+    for (auto const &record : records) {
+        unframed_out << vbin_lil_e.out(record);
+        framed_out << fvbin_lil_e.out(record);
+    }
+
+    Stopwatch stopwatch;
+    uint64_t unframed_sum = 0;
+    {
+        ByteReader in(unframed_out.range());
+        for (size_t i = 0; i < records.size(); ++i)
+            unframed_sum += std::get<3>(vbin_lil_e.read<Record>(in));
+    }
+    auto unframed_seconds = stopwatch.lap();
+    uint64_t framed_sum = 0;
+    {
+        ByteReader in(framed_out.range());
+        for (size_t i = 0; i < records.size(); ++i)
+            framed_sum += std::get<3>(fvbin_lil_e.read<LazyRecord>(in));
+    }
+    auto framed_seconds = stopwatch.lap();
+    LVD_TEST_REQ_EQ(framed_sum, unframed_sum);
+
+    req_context.log() << Log::inf() << records.size() << " records, using one field of each; unframed: " << unframed_out.size() << " bytes, read "
+                      << unframed_seconds << " s; length-framed: " << framed_out.size() << " bytes, read " << framed_seconds << " s\n";
+LVD_TEST_END
+
+} // end namespace lvd
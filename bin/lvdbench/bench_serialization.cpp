@@ -0,0 +1,93 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#include <map>
+#include "lvd/random.hpp"
+#include "lvd/req.hpp"
+#include "lvd/serialization.hpp"
+#include <set>
+#include "Stopwatch.hpp"
+#include "lvd/test.hpp"
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace lvd {
+
+namespace {
+
+// Deserializes a large associative container, and logs how long that takes compared to inserting the same
+// elements without the end hint (for sorted containers) or bucket pre-sizing (for hashed ones).
+template <typename Container_>
+void large_associative_container_case (req::Context &req_context, char const *name, Container_ const &expected) {
+    auto buffer = serialized_from(expected);
+
+    Stopwatch stopwatch;
+    auto actual = deserialized_to<Container_>(lvd::range(buffer));
+    auto deserialize_seconds = stopwatch.lap();
+    LVD_TEST_REQ_IS_TRUE(actual == expected);
+
+    // For comparison, do what deserialization used to do.
+    stopwatch.lap();
+    {
+        using ValueType = remove_cv_recursive_t<typename Container_::value_type>;
+        auto source_range = lvd::range(buffer);
+        size_t size = deserialized_to<uint32_t>(std::move(source_range));
+        Container_ baseline;
+        for (size_t i = 0; i < size; ++i)
+            baseline.emplace(deserialized_to<ValueType>(std::move(source_range)));
+        LVD_TEST_REQ_EQ(baseline.size(), expected.size());
+    }
+    auto baseline_seconds = stopwatch.lap();
+
+    req_context.log() << Log::inf() << name << " with " << expected.size() << " elements: "
+                      << deserialize_seconds << " s (vs " << baseline_seconds << " s unhinted)\n";
+}
+
+} // end of anonymous namespace
+
+LVD_TEST_BEGIN(323__serialization__00__large_associative)
+    size_t constexpr SIZE = 1000000;
+    auto rng = std::mt19937{42};
+    std::map<uint32_t,uint32_t> m;
+    std::unordered_map<uint32_t,uint32_t> um;
+    std::set<uint64_t> s;
+    std::unordered_set<uint64_t> us;
+    while (m.size() < SIZE) {
+        auto key = make_random<uint32_t>(rng);
+        m.emplace(key, ~key);
+        um.emplace(key, ~key);
+        s.emplace(uint64_t(key) << 16);
+        us.emplace(uint64_t(key) << 16);
+    }
+    large_associative_container_case(req_context, "std::map", m);
+    large_associative_container_case(req_context, "std::unordered_map", um);
+    large_associative_container_case(req_context, "std::set", s);
+    large_associative_container_case(req_context, "std::unordered_set", us);
+LVD_TEST_END
+
+// Compares serializing fixed-layout elements as a block against serializing them field by field.
+LVD_TEST_BEGIN(323__serialization__01__fixed_layout)
+    std::vector<std::pair<int32_t,float>> pairs(size_t(1) << 22);
+    for (size_t i = 0; i < pairs.size(); ++i)
+        pairs[i] = {int32_t(i*i) - 1000, float(i) / 8.0f};
+
+    Stopwatch stopwatch;
+    auto buffer = serialized_from(pairs);
+    auto block_seconds = stopwatch.lap();
+    std::vector<std::byte> field_buffer(buffer.size());
+    std::byte *cursor = field_buffer.data();
+    serialize_from<uint32_t>(pairs.size(), ByteInserter_t(cursor));
+    for (auto const &pair : pairs) {
+        serialize_from(pair.first, ByteInserter_t(cursor));
+        serialize_from(pair.second, ByteInserter_t(cursor));
+    }
+    auto field_seconds = stopwatch.lap();
+    LVD_TEST_REQ_IS_TRUE(field_buffer == buffer);
+
+    req_context.log() << Log::inf() << "serializing " << pairs.size() << " std::pair<int32_t,float> as a block: " << block_seconds
+                      << " s, field by field: " << field_seconds << " s\n";
+LVD_TEST_END
+
+} // end namespace lvd
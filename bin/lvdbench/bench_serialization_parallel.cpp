@@ -0,0 +1,69 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#include "lvd/parallel.hpp"
+#include "lvd/random.hpp"
+#include "lvd/req.hpp"
+#include "lvd/serialization.hpp"
+#include "lvd/serialization_parallel.hpp"
+#include "Stopwatch.hpp"
+#include "lvd/test.hpp"
+#include <random>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace lvd {
+
+namespace {
+
+// Compares serialized_from/deserialized_to against their parallel counterparts.
+template <typename Container_>
+void parallel_case (req::Context &req_context, char const *name, Container_ const &value) {
+    Stopwatch stopwatch;
+    auto buffer = serialized_from(value);
+    auto serialize_seconds = stopwatch.lap();
+    auto actual = deserialized_to<Container_>(lvd::range(buffer));
+    auto deserialize_seconds = stopwatch.lap();
+    LVD_TEST_REQ_IS_TRUE(actual == value);
+
+    stopwatch.lap();
+    auto parallel_buffer = serialized_from_parallel(value);
+    auto parallel_serialize_seconds = stopwatch.lap();
+    Container_ parallel_actual;
+    deserialize_to_parallel(parallel_actual, lvd::range(parallel_buffer));
+    auto parallel_deserialize_seconds = stopwatch.lap();
+    LVD_TEST_REQ_IS_TRUE(parallel_actual == value);
+
+    req_context.log() << Log::inf() << name << " with " << value.size() << " elements, using " << default_thread_count() << " threads:\n"
+                      << "    serialized_from: " << serialize_seconds << " s, serialized_from_parallel: " << parallel_serialize_seconds << " s\n"
+                      << "    deserialized_to: " << deserialize_seconds << " s, deserialize_to_parallel: " << parallel_deserialize_seconds << " s\n";
+}
+
+} // end of anonymous namespace
+
+LVD_TEST_BEGIN(324__serialization_parallel__00__throughput)
+    size_t constexpr SIZE = 1000000;
+    auto rng = std::mt19937{42};
+    std::vector<std::pair<uint64_t,double>> pairs(8*SIZE);
+    for (auto &pair : pairs)
+        pair = {make_random<uint64_t>(rng), make_random<double>(rng)};
+    parallel_case(req_context, "std::vector<std::pair<uint64_t,double>>", pairs);
+
+    std::vector<std::string> strings(SIZE);
+    for (auto &string : strings)
+        string = std::string(make_random<uint8_t>(rng) % 32, 's');
+    parallel_case(req_context, "std::vector<std::string>", strings);
+
+    std::unordered_map<uint64_t,double> um;
+    um.reserve(SIZE);
+    for (auto const &pair : pairs) {
+        if (um.size() == SIZE)
+            break;
+        um.emplace(pair);
+    }
+    parallel_case(req_context, "std::unordered_map<uint64_t,double>", um);
+LVD_TEST_END
+
+} // end namespace lvd
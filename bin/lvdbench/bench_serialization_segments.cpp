@@ -0,0 +1,62 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#include <cstdio>
+#include "lvd/req.hpp"
+#include "lvd/serialization.hpp"
+#include "lvd/serialization_segments.hpp"
+#include "Stopwatch.hpp"
+#include "lvd/test.hpp"
+#include <unistd.h>
+#include <vector>
+
+namespace lvd {
+
+// Compares writing and reading a large vector through a contiguous buffer against scattering/gathering it
+// directly from/to its elements.
+LVD_TEST_BEGIN(324__serialization_segments__00__throughput)
+    std::vector<uint64_t> values(size_t(1) << 23);
+    for (size_t i = 0; i < values.size(); ++i)
+        values[i] = i*0x9E3779B97F4A7C15;
+
+    std::FILE *file = std::tmpfile();
+    LVD_TEST_REQ_IS_TRUE(file != nullptr);
+    int fd = ::fileno(file);
+
+    Stopwatch stopwatch;
+    {
+        auto bytes = serialized_from(values);
+        write_segments(fd, {iovec{bytes.data(), bytes.size()}});
+    }
+    auto copied_write_seconds = stopwatch.lap();
+    pwrite_segments(fd, serialized_segments_from(values).iovecs(), 0);
+    auto scattered_write_seconds = stopwatch.lap();
+
+    std::vector<uint64_t> dest;
+    stopwatch.lap();
+    {
+        std::vector<std::byte> bytes(sizeof(uint32_t) + values.size()*sizeof(uint64_t));
+        pread_segments(fd, {iovec{bytes.data(), bytes.size()}}, 0);
+        deserialize_to(dest, range(bytes));
+    }
+    auto copied_read_seconds = stopwatch.lap();
+    LVD_TEST_REQ_IS_TRUE(dest == values);
+
+    dest.clear();
+    dest.resize(values.size());
+    stopwatch.lap();
+    {
+        auto segments = gather_segments_for(dest);
+        pread_segments(fd, segments.iovecs(), 0);
+        deserialize_gathered(dest, segments);
+    }
+    auto gathered_read_seconds = stopwatch.lap();
+    LVD_TEST_REQ_IS_TRUE(dest == values);
+    std::fclose(file);
+
+    req_context.log() << Log::inf() << "writing " << values.size()*sizeof(uint64_t) << " bytes, via serialized_from: " << copied_write_seconds << " s"
+                      << ", via serialized_segments_from: " << scattered_write_seconds << " s\n"
+                      << "reading, via deserialize_to: " << copied_read_seconds << " s"
+                      << ", via deserialize_gathered: " << gathered_read_seconds << " s\n";
+LVD_TEST_END
+
+} // end namespace lvd
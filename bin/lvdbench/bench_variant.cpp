@@ -0,0 +1,78 @@
+// 2021.01.10 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#include "lvd/Log.hpp"
+#include "lvd/req.hpp"
+#include "Stopwatch.hpp"
+#include "lvd/test.hpp"
+#include "lvd/variant.hpp"
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace lvd {
+
+namespace {
+
+// This is how call_on_indexed_type used to dispatch, kept here as a baseline for comparison.
+template <size_t TRY_INDEX_, typename... Types_, typename Function_>
+void call_on_indexed_type_linearly (size_t index, Function_ const &function) {
+    if (index == TRY_INDEX_) {
+        function(ty<std::tuple_element_t<TRY_INDEX_,std::tuple<Types_...>>>);
+    } else if constexpr (TRY_INDEX_+1 < sizeof...(Types_)) {
+        call_on_indexed_type_linearly<TRY_INDEX_+1,Types_...>(index, function);
+    } else {
+        throw std::runtime_error("invalid index for variadic type sequence");
+    }
+}
+
+// Dispatches on each of indices over the types std::integral_constant<size_t,0>, ..., and sums their values,
+// logging how long that takes via call_on_indexed_type and via call_on_indexed_type_linearly.
+template <size_t... INDICES_>
+void call_on_indexed_type_case (req::Context &req_context, std::vector<size_t> const &indices, std::index_sequence<INDICES_...>) {
+    size_t constexpr TYPE_COUNT = sizeof...(INDICES_);
+    size_t expected_sum = 0;
+    for (auto index : indices)
+        expected_sum += index % TYPE_COUNT;
+
+    auto add_value = [](size_t &sum){
+        return [&sum](auto &&t){
+            sum += std::decay_t<decltype(t)>::T::value;
+        };
+    };
+
+    size_t sum = 0;
+    Stopwatch stopwatch;
+    for (auto index : indices)
+        call_on_indexed_type<0,std::integral_constant<size_t,INDICES_>...>(index % TYPE_COUNT, add_value(sum));
+    auto table_seconds = stopwatch.lap();
+    LVD_TEST_REQ_EQ(sum, expected_sum);
+
+    sum = 0;
+    stopwatch.lap();
+    for (auto index : indices)
+        call_on_indexed_type_linearly<0,std::integral_constant<size_t,INDICES_>...>(index % TYPE_COUNT, add_value(sum));
+    auto linear_seconds = stopwatch.lap();
+    LVD_TEST_REQ_EQ(sum, expected_sum);
+
+    req_context.log() << Log::inf() << TYPE_COUNT << " types, " << indices.size() << " dispatches: "
+                      << table_seconds << " s (vs " << linear_seconds << " s linearly)\n";
+}
+
+} // end of anonymous namespace
+
+LVD_TEST_BEGIN(020__variant__00__call_on_indexed_type)
+    auto rng = std::mt19937{42};
+    std::vector<size_t> indices(1000000);
+    for (auto &index : indices)
+        index = std::uniform_int_distribution<size_t>()(rng);
+
+    call_on_indexed_type_case(req_context, indices, std::make_index_sequence<1>());
+    call_on_indexed_type_case(req_context, indices, std::make_index_sequence<4>());
+    call_on_indexed_type_case(req_context, indices, std::make_index_sequence<16>());
+    call_on_indexed_type_case(req_context, indices, std::make_index_sequence<40>());
+    call_on_indexed_type_case(req_context, indices, std::make_index_sequence<100>());
+LVD_TEST_END
+
+} // end namespace lvd
@@ -0,0 +1,7 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#include "lvd/test.hpp"
+
+int main (int argc, char **argv) {
+    return lvd::test::basic_test_main("lvdbench -- benchmarks for liblvd", argc, argv);
+}
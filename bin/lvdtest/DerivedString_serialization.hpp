@@ -13,18 +13,22 @@ namespace lvd {
 
 template <> struct SerializeFrom_t<DerivedString_DC_EP> : public SerializeFrom_t<std::string> { };
 template <> struct DeserializeTo_t<DerivedString_DC_EP> : public DeserializeTo_t<std::string> { };
+template <> struct SerializedSize_t<DerivedString_DC_EP> : public SerializedSize_t<std::string> { };
 
 template <> struct SerializeFrom_t<DerivedString_DC_IP> : public SerializeFrom_t<std::string> { };
 template <> struct DeserializeTo_t<DerivedString_DC_IP> : public DeserializeTo_t<std::string> { };
+template <> struct SerializedSize_t<DerivedString_DC_IP> : public SerializedSize_t<std::string> { };
 
 // For non-default-constructible types, have to explicitly define DeserializedTo_t.
 
 template <> struct SerializeFrom_t<DerivedString_NDC_EP> : public SerializeFrom_t<std::string> { };
 template <> struct DeserializeTo_t<DerivedString_NDC_EP> : public DeserializeTo_t<std::string> { };
+template <> struct SerializedSize_t<DerivedString_NDC_EP> : public SerializedSize_t<std::string> { };
 template <> struct DeserializedTo_t<DerivedString_NDC_EP> : public DeserializedTo_t<std::string> { };
 
 template <> struct SerializeFrom_t<DerivedString_NDC_IP> : public SerializeFrom_t<std::string> { };
 template <> struct DeserializeTo_t<DerivedString_NDC_IP> : public DeserializeTo_t<std::string> { };
+template <> struct SerializedSize_t<DerivedString_NDC_IP> : public SerializedSize_t<std::string> { };
 template <> struct DeserializedTo_t<DerivedString_NDC_IP> : public DeserializedTo_t<std::string> { };
 
 } // end namespace lvd
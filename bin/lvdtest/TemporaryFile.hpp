@@ -0,0 +1,20 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <unistd.h>
+
+namespace lvd {
+
+// A path in the temporary directory (distinguished by name and by process id) for a test to write a file to.
+// Removes the file upon destruction.
+struct TemporaryFile {
+    std::string path;
+    explicit TemporaryFile (std::string const &name) : path((std::filesystem::temp_directory_path() / ("lvdtest_" + name + '_' + std::to_string(::getpid()))).string()) { }
+    ~TemporaryFile () { std::remove(path.c_str()); }
+};
+
+} // end namespace lvd
@@ -8,6 +8,7 @@
 #include "lvd/IndexedTuple_t.hpp"
 #include "lvd/variant.hpp"
 #include <map>
+#include <optional>
 #include <ostream>
 #include <set>
 #include <typeindex>
@@ -0,0 +1,178 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#include "lvd/BlockFramed.hpp"
+#include "lvd/ByteReader.hpp"
+#include "lvd/ByteWriter.hpp"
+#include "lvd/read_bin_string.hpp"
+#include "lvd/read_bin_vector.hpp"
+#include "lvd/req.hpp"
+#include <sstream>
+#include <string>
+#include "lvd/test.hpp"
+#include <vector>
+#include "lvd/write_bin_string.hpp"
+#include "lvd/write_bin_vector.hpp"
+
+namespace lvd {
+
+namespace {
+
+std::string const EXPECTED_STRING{"The quick brown fox jumps over the lazy dog"};
+std::vector<uint32_t> const EXPECTED_VECTOR{1, 1, 2, 3, 5, 8, 13, 21, 34, 55, 89, 144, 233, 377, 610, 987};
+uint64_t const EXPECTED_TRAILER = 0xDEADBEEFCAFEF00D;
+
+// Writes block-framed values, followed by an unframed trailer.
+template <typename Ostream_>
+void write_framed_values (Ostream_ &out, size_t block_size) {
+    {
+        BlockFramedWriter_t framed_out(out, block_size);
+        framed_out << bin_lil_e.out(EXPECTED_STRING) << bin_big_e.out(EXPECTED_VECTOR);
+        framed_out.put('!');
+    }
+    out << bin_lil_e.out(EXPECTED_TRAILER);
+}
+
+template <typename Istream_>
+void read_framed_values (req::Context &req_context, Istream_ &in, size_t max_block_size = BLOCK_FRAMED_DEFAULT_BLOCK_SIZE) {
+    BlockFramedReader_t framed_in(in, max_block_size);
+    LVD_TEST_REQ_EQ(bin_lil_e.read<std::string>(framed_in), EXPECTED_STRING);
+    LVD_TEST_REQ_IS_TRUE(bin_big_e.read<std::vector<uint32_t>>(framed_in) == EXPECTED_VECTOR);
+    LVD_TEST_REQ_EQ(framed_in.peek(), int('!'));
+    LVD_TEST_REQ_EQ(framed_in.get(), int('!'));
+    LVD_TEST_REQ_IS_TRUE(framed_in.good());
+    // Reading past the terminating empty block fails, and leaves `in` just after it.
+    LVD_TEST_REQ_EQ(framed_in.get(), std::char_traits<char>::eof());
+    LVD_TEST_REQ_IS_TRUE(framed_in.fail());
+    LVD_TEST_REQ_IS_TRUE(framed_in.is_at_end());
+    LVD_TEST_REQ_EQ(bin_lil_e.read<uint64_t>(in), EXPECTED_TRAILER);
+    LVD_TEST_REQ_IS_TRUE(in.good());
+}
+
+} // end of anonymous namespace
+
+// 234 must be >= 231 (which is read_write_bin), since block framing is tested with bin encodings.
+LVD_TEST_BEGIN(234__BlockFramed__00__round_trip)
+    for (size_t block_size : {size_t(1), size_t(7), size_t(8), size_t(64), BLOCK_FRAMED_DEFAULT_BLOCK_SIZE}) {
+        req_context.log() << Log::trc() << "block_size: " << block_size << '\n';
+        ByteWriter out;
+        write_framed_values(out, block_size);
+        // The framed bytes are the unframed bytes with a header per block, and the terminating empty block.
+        auto payload_size = (8 + EXPECTED_STRING.size()) + (8 + 4*EXPECTED_VECTOR.size()) + 1;
+        auto block_count = (payload_size + block_size - 1) / block_size;
+        LVD_TEST_REQ_EQ(out.size(), payload_size + (block_count + 1)*BLOCK_FRAMED_HEADER_SIZE + 8);
+        ByteReader in(out.range());
+        read_framed_values(req_context, in);
+
+        std::stringstream ss;
+        write_framed_values(ss, block_size);
+        LVD_TEST_REQ_EQ(ss.str(), std::string(reinterpret_cast<char const *>(out.bytes().data()), out.size()));
+        read_framed_values(req_context, ss);
+
+        LVD_TEST_REQ_IS_TRUE(find_corrupt_blocks(out.range()).empty());
+    }
+
+    // Blocks bigger than max_block_size are rejected.
+    ByteWriter out;
+    write_framed_values(out, 64);
+    test::call_function_and_expect_exception<CorruptBlockError>([&req_context, &out](){
+        ByteReader in(out.range());
+        read_framed_values(req_context, in, 63);
+    });
+LVD_TEST_END
+
+LVD_TEST_BEGIN(234__BlockFramed__01__corrupt)
+    size_t block_size = 16;
+    ByteWriter out;
+    write_framed_values(out, block_size);
+    auto framed_size = out.size() - 8;
+    auto const &bytes = out.bytes();
+
+    // Flipping any bit of any block must be detected, and reported at the offset of that block.
+    for (size_t i = 0; i < framed_size; ++i) {
+        // The last block is short, so the terminating empty block doesn't start at a multiple of the block stride.
+        auto terminator_offset = framed_size - BLOCK_FRAMED_HEADER_SIZE;
+        auto block_offset = i >= terminator_offset ? terminator_offset : i / (BLOCK_FRAMED_HEADER_SIZE + block_size) * (BLOCK_FRAMED_HEADER_SIZE + block_size);
+        for (size_t bit = 0; bit < 8; ++bit) {
+            auto corrupted = bytes;
+            corrupted[i] ^= std::byte(1u << bit);
+            auto range = Range_t<std::byte const *>(corrupted.data(), corrupted.data() + corrupted.size());
+            bool was_detected = false;
+            try {
+                ByteReader in(range);
+                read_framed_values(req_context, in);
+            } catch (CorruptBlockError const &e) {
+                was_detected = true;
+                LVD_TEST_REQ_EQ(e.offset(), block_offset);
+            }
+            LVD_TEST_REQ_IS_TRUE(was_detected);
+            auto corrupt_offsets = find_corrupt_blocks(range);
+            LVD_TEST_REQ_IS_TRUE(!corrupt_offsets.empty());
+            LVD_TEST_REQ_EQ(corrupt_offsets.front(), block_offset);
+        }
+    }
+
+    // A corrupt payload (but not size) is reported without stopping the scan.
+    {
+        auto corrupted = bytes;
+        corrupted[1*(BLOCK_FRAMED_HEADER_SIZE + block_size) + BLOCK_FRAMED_HEADER_SIZE] ^= std::byte{0x01};
+        corrupted[3*(BLOCK_FRAMED_HEADER_SIZE + block_size) + BLOCK_FRAMED_HEADER_SIZE + 5] ^= std::byte{0x80};
+        auto corrupt_offsets = find_corrupt_blocks(Range_t<std::byte const *>(corrupted.data(), corrupted.data() + framed_size));
+        LVD_TEST_REQ_IS_TRUE((corrupt_offsets == std::vector<uint64_t>{1*(BLOCK_FRAMED_HEADER_SIZE + block_size), 3*(BLOCK_FRAMED_HEADER_SIZE + block_size)}));
+    }
+
+    // The scan stops at an empty block, even a corrupt one, rather than reporting whatever follows it.
+    {
+        auto terminator_offset = framed_size - BLOCK_FRAMED_HEADER_SIZE;
+        auto corrupted = bytes;
+        corrupted[terminator_offset + BLOCK_FRAMED_HEADER_SIZE - 1] ^= std::byte{0x01};
+        auto corrupt_offsets = find_corrupt_blocks(Range_t<std::byte const *>(corrupted.data(), corrupted.data() + framed_size));
+        LVD_TEST_REQ_IS_TRUE((corrupt_offsets == std::vector<uint64_t>{terminator_offset}));
+
+        corrupted = bytes;
+        corrupted[BLOCK_FRAMED_HEADER_SIZE + block_size] = std::byte{0};
+        corrupt_offsets = find_corrupt_blocks(Range_t<std::byte const *>(corrupted.data(), corrupted.data() + framed_size));
+        LVD_TEST_REQ_IS_TRUE((corrupt_offsets == std::vector<uint64_t>{BLOCK_FRAMED_HEADER_SIZE + block_size}));
+    }
+
+    // Truncation anywhere (including at a block boundary) must be detected.
+    for (size_t size = 0; size < framed_size; ++size) {
+        auto range = Range_t<std::byte const *>(bytes.data(), bytes.data() + size);
+        test::call_function_and_expect_exception<CorruptBlockError>([&req_context, &range](){
+            ByteReader in(range);
+            read_framed_values(req_context, in);
+        });
+        LVD_TEST_REQ_EQ(find_corrupt_blocks(range).size(), size_t(1));
+    }
+LVD_TEST_END
+
+LVD_TEST_BEGIN(234__BlockFramed__02__abandoned)
+    // A writer destroyed by stack unwinding doesn't write the terminating empty block, so what was written so far
+    // can't be mistaken for a complete stream.
+    ByteWriter out;
+    test::call_function_and_expect_exception<std::domain_error>([&out](){
+        BlockFramedWriter_t framed_out(out, 16);
+        framed_out << bin_lil_e.out(EXPECTED_STRING);
+        throw std::domain_error("abandoning the stream");
+    });
+    auto payload_size = 8 + EXPECTED_STRING.size();
+    LVD_TEST_REQ_EQ(out.size(), payload_size/16*(BLOCK_FRAMED_HEADER_SIZE + 16));
+    LVD_TEST_REQ_IS_TRUE((find_corrupt_blocks(out.range()) == std::vector<uint64_t>{out.size()}));
+LVD_TEST_END
+
+LVD_TEST_BEGIN(234__BlockFramed__03__length_framed)
+    // The bytes a length-framed value took are counted across blocks, so its frame is checked as for other streams.
+    ByteWriter out;
+    {
+        BlockFramedWriter_t framed_out(out, 7);
+        framed_out << fbin_lil_e.out(EXPECTED_VECTOR) << bin_lil_e.out(size_t(9)) << bin_lil_e.out(std::vector<uint8_t>{}) << bin_lil_e.out(uint8_t(0));
+    }
+    ByteReader in(out.range());
+    BlockFramedReader_t framed_in(in);
+    LVD_TEST_REQ_IS_TRUE(fbin_lil_e.read<std::vector<uint32_t>>(framed_in) == EXPECTED_VECTOR);
+    LVD_TEST_REQ_EQ(framed_in.tellg(), std::streampos(8 + 8 + 4*EXPECTED_VECTOR.size()));
+    test::call_function_and_expect_exception<std::runtime_error>([&framed_in](){
+        fbin_lil_e.read<std::vector<uint8_t>>(framed_in);
+    });
+LVD_TEST_END
+
+} // end namespace lvd
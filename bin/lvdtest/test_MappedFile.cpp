@@ -0,0 +1,136 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#include <array>
+#include "lvd/ByteReader.hpp"
+#include "lvd/ByteWriter.hpp"
+#include <cerrno>
+#include <fstream>
+#include "lvd/MappedFile.hpp"
+#include "lvd/read_bin_string.hpp"
+#include "lvd/read_bin_vector.hpp"
+#include "lvd/read_bin_view.hpp"
+#include "lvd/req.hpp"
+#include "TemporaryFile.hpp"
+#include "lvd/test.hpp"
+#include "lvd/write_bin_array.hpp"
+#include "lvd/write_bin_string.hpp"
+#include "lvd/write_bin_vector.hpp"
+#include <string>
+#include <vector>
+
+namespace lvd {
+
+// Returns true iff p points into the given mapping.
+template <typename T_>
+bool points_into (T_ const *p, MappedFile const &mapped_file) {
+    auto b = reinterpret_cast<std::byte const *>(p);
+    return mapped_file.data() <= b && b < mapped_file.data() + mapped_file.size();
+}
+
+// 232 must be >= 231 (which is read_write_bin), since MappedFile decoding depends on it.
+LVD_TEST_BEGIN(232__MappedFile__00)
+    TemporaryFile file("MappedFile");
+    auto expected_string = std::string("hippo");
+    auto expected_vector = std::vector<uint64_t>{10, 20, 30, 0xDEADBEEFCAFEF00D};
+    auto expected_array = std::array<uint16_t,3>{1, 2, 3};
+    {
+        std::ofstream out(file.path, std::ios_base::binary);
+        for (int i = 0; i < 2; ++i) {
+            // The size_t size prefix keeps the uint64_t elements 8-byte aligned, since the mapping is page-aligned.
+            out << bin_lil_e.out(expected_vector) << bin_lil_e.out(expected_string) << bin_big_e.out(expected_array);
+        }
+    }
+
+    MappedFile mapped_file(file.path);
+    LVD_TEST_REQ_EQ(mapped_file.size(), size_t(2*((8 + 4*8) + (8 + 5) + 3*2)));
+
+    // Decoding owning values.
+    {
+        auto in = mapped_file.reader();
+        LVD_TEST_REQ_IS_TRUE(bin_lil_e.read<std::vector<uint64_t>>(in) == expected_vector);
+        LVD_TEST_REQ_EQ(bin_lil_e.read<std::string>(in), expected_string);
+    }
+
+    // Decoding views.
+    {
+        auto in = mapped_file.reader();
+        auto v = read_bin_vector_view<uint64_t>(in, bin_lil_e);
+        auto s = read_bin_string_view(in, bin_lil_e);
+        auto a = read_bin_array_view<uint16_t,3>(in, bin_big_e);
+        // The vector now starts at offset 8 + 32 + 13 + 6, so it's misaligned, and must be copied.
+        auto v2 = read_bin_vector_view<uint64_t>(in, bin_lil_e);
+        auto s2 = read_bin_string_view(in, bin_lil_e);
+        LVD_TEST_REQ_IS_TRUE(in.good());
+        LVD_TEST_REQ_EQ(in.range().size(), ptrdiff_t(3*2));
+
+        LVD_TEST_REQ_IS_TRUE(v.to_vector() == expected_vector);
+        LVD_TEST_REQ_EQ(v.is_zero_copy(), machine_endianness() == Endianness::LIL);
+        LVD_TEST_REQ_EQ(points_into(v.data(), mapped_file), v.is_zero_copy());
+        LVD_TEST_REQ_EQ(s, std::string_view(expected_string));
+        LVD_TEST_REQ_IS_TRUE(points_into(s.data(), mapped_file));
+        LVD_TEST_REQ_IS_TRUE(a.to_vector() == std::vector<uint16_t>(expected_array.begin(), expected_array.end()));
+        LVD_TEST_REQ_EQ(a.is_zero_copy(), machine_endianness() == Endianness::BIG);
+        LVD_TEST_REQ_IS_TRUE(v2.to_vector() == expected_vector);
+        LVD_TEST_REQ_IS_TRUE(!v2.is_zero_copy());
+        LVD_TEST_REQ_EQ(s2, std::string_view(expected_string));
+
+        // Reading past the end must fail.
+        read_bin_vector_view<uint64_t>(in, bin_lil_e);
+        LVD_TEST_REQ_IS_TRUE(in.fail());
+    }
+
+    // Moving must transfer the mapping.
+    {
+        auto data = mapped_file.data();
+        auto moved_mapped_file = std::move(mapped_file);
+        LVD_TEST_REQ_EQ(moved_mapped_file.data(), data);
+        LVD_TEST_REQ_EQ(mapped_file.size(), size_t(0));
+    }
+
+    test::call_function_and_expect_exception<std::runtime_error>([](){
+        MappedFile("/nonexistent/lvdtest/file");
+    });
+    // Don't leak the expected failure's errno into other tests.
+    errno = 0;
+LVD_TEST_END
+
+LVD_TEST_BEGIN(232__MappedFile__01__length_framed_views)
+    auto expected_vector = std::vector<uint64_t>{10, 20, 30};
+    auto expected_array = std::array<uint16_t,3>{1, 2, 3};
+    {
+        ByteWriter out;
+        out << fbin_lil_e.out(expected_vector) << fbin_lil_e.out(std::string("hippo")) << fbin_lil_e.out(expected_array);
+        ByteReader in(out.range());
+        LVD_TEST_REQ_IS_TRUE(read_bin_vector_view<uint64_t>(in, fbin_lil_e).to_vector() == expected_vector);
+        LVD_TEST_REQ_EQ(read_bin_string_view(in, fbin_lil_e), std::string_view("hippo"));
+        LVD_TEST_REQ_IS_TRUE((read_bin_array_view<uint16_t,3>(in, fbin_lil_e).to_vector() == std::vector<uint16_t>(expected_array.begin(), expected_array.end())));
+        LVD_TEST_REQ_IS_TRUE(in.good());
+        LVD_TEST_REQ_IS_TRUE(in.range().empty());
+    }
+
+    // A view must be exactly the extent of its frame.
+    {
+        ByteWriter out;
+        out << bin_lil_e.out(size_t(9)) << bin_lil_e.out(std::vector<uint8_t>{}) << bin_lil_e.out(uint8_t(0));
+        ByteReader in(out.range());
+        test::call_function_and_expect_exception<std::runtime_error>([&in](){
+            read_bin_vector_view<uint8_t>(in, fbin_lil_e);
+        });
+
+        ByteWriter short_out;
+        short_out << bin_lil_e.out(size_t(8)) << bin_lil_e.out(std::vector<uint16_t>{1, 2, 3});
+        ByteReader truncated_in(short_out.range());
+        auto v = read_bin_vector_view<uint16_t>(truncated_in, fbin_lil_e);
+        LVD_TEST_REQ_IS_TRUE(truncated_in.fail());
+        LVD_TEST_REQ_EQ(v.size(), size_t(0));
+
+        ByteWriter string_out;
+        string_out << bin_lil_e.out(size_t(14)) << bin_lil_e.out(std::string("hippo")) << bin_lil_e.out(uint8_t(0));
+        ByteReader string_in(string_out.range());
+        test::call_function_and_expect_exception<std::runtime_error>([&string_in](){
+            read_bin_string_view(string_in, fbin_lil_e);
+        });
+    }
+LVD_TEST_END
+
+} // end namespace lvd
@@ -0,0 +1,212 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#include <fstream>
+#include "lvd/MappedFile.hpp"
+#include "lvd/read_bin_string.hpp"
+#include "lvd/read_bin_tuple.hpp"
+#include "lvd/read_bin_type.hpp"
+#include "lvd/read_bin_vector.hpp"
+#include "lvd/RecordLog.hpp"
+#include "lvd/req.hpp"
+#include "TemporaryFile.hpp"
+#include "lvd/test.hpp"
+#include "lvd/write_bin_string.hpp"
+#include "lvd/write_bin_tuple.hpp"
+#include "lvd/write_bin_type.hpp"
+#include "lvd/write_bin_vector.hpp"
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace lvd {
+
+namespace {
+
+using Record = std::tuple<uint32_t,std::string,std::vector<uint16_t>>;
+
+Record make_record (uint32_t i) {
+    return Record{3*i, "record " + std::to_string(i), std::vector<uint16_t>(i % 7, uint16_t(i))};
+}
+
+Range_t<std::byte const *> log_range (std::vector<std::byte> const &bytes) {
+    return Range_t<std::byte const *>(bytes.data(), bytes.data() + bytes.size());
+}
+
+template <typename Encoding_>
+void test_record_log_random_access (req::Context &req_context, Encoding_ const &enc, size_t record_count) {
+    ByteWriter out;
+    {
+        RecordLogWriter_t<ByteWriter,Encoding_> writer(out, enc);
+        for (size_t i = 0; i < record_count; ++i)
+            writer.append(make_record(uint32_t(i)));
+        LVD_TEST_REQ_EQ(writer.record_count(), record_count);
+    }
+
+    RecordLogReader_t<Encoding_> reader(log_range(out.bytes()), enc);
+    LVD_TEST_REQ_EQ(reader.record_count(), record_count);
+    // Random access, in an order that isn't sequential.
+    for (size_t i = 0; i < record_count; ++i) {
+        auto record_index = (i*7) % record_count;
+        LVD_TEST_REQ_IS_TRUE(reader.template read<Record>(record_index) == make_record(uint32_t(record_index)));
+    }
+    // Sequential access from the middle.
+    reader.seek(record_count / 2);
+    for (size_t i = record_count / 2; i < record_count; ++i) {
+        LVD_TEST_REQ_EQ(reader.position(), i);
+        LVD_TEST_REQ_IS_TRUE(reader.template read_next<Record>() == make_record(uint32_t(i)));
+    }
+    LVD_TEST_REQ_IS_TRUE(reader.is_at_end());
+
+    test::call_function_and_expect_exception<std::out_of_range>([&reader, record_count](){
+        reader.template read<Record>(record_count);
+    });
+    test::call_function_and_expect_exception<std::out_of_range>([&reader, record_count](){
+        reader.seek(record_count + 1);
+    });
+}
+
+} // end of anonymous namespace
+
+// 233 must be >= 232 (which is MappedFile), since record logs are read via MappedFile.
+LVD_TEST_BEGIN(233__RecordLog__00__random_access)
+    for (size_t record_count : {size_t(0), size_t(1), size_t(2), size_t(100)}) {
+        test_record_log_random_access(req_context, bin_lil_e, record_count);
+        test_record_log_random_access(req_context, bin_big_e, record_count);
+        test_record_log_random_access(req_context, vbin_lil_e, record_count);
+        test_record_log_random_access(req_context, tbin_big_e, record_count);
+        test_record_log_random_access(req_context, fbin_lil_e, record_count);
+    }
+
+    // Reading a record as the wrong type must throw, rather than silently leaving bytes unread.
+    ByteWriter out;
+    {
+        RecordLogWriter_t<ByteWriter,decltype(bin_lil_e)> writer(out, bin_lil_e);
+        writer.append(uint64_t(123));
+    }
+    RecordLogReader_t<decltype(bin_lil_e)> reader(log_range(out.bytes()), bin_lil_e);
+    LVD_TEST_REQ_EQ(reader.read<uint64_t>(0), uint64_t(123));
+    LVD_TEST_REQ_EQ(reader.record_bytes(0).size(), ptrdiff_t(8));
+    test::call_function_and_expect_exception<std::runtime_error>([&reader](){
+        reader.read<uint32_t>(0);
+    });
+    test::call_function_and_expect_exception<std::runtime_error>([&reader](){
+        reader.read<std::string>(0);
+    });
+
+    // A writer destroyed by stack unwinding doesn't finish the log, so it can't be mistaken for a complete one.
+    ByteWriter abandoned_out;
+    test::call_function_and_expect_exception<std::runtime_error>([&abandoned_out](){
+        RecordLogWriter_t<ByteWriter,decltype(bin_lil_e)> writer(abandoned_out, bin_lil_e);
+        writer.append(uint64_t(123));
+        throw std::runtime_error("abandoning the log");
+    });
+    LVD_TEST_REQ_EQ(abandoned_out.size(), size_t(2*sizeof(uint64_t)));
+LVD_TEST_END
+
+LVD_TEST_BEGIN(233__RecordLog__01__key_samples)
+    auto enc = vbin_lil_e;
+    size_t record_count = 1000;
+    size_t key_sample_interval = 16;
+    ByteWriter out;
+    {
+        RecordLogWriter_t<ByteWriter,decltype(enc),uint32_t> writer(out, enc, key_sample_interval);
+        // The key is the first element of the record, which is increasing.
+        for (size_t i = 0; i < record_count; ++i) {
+            auto record = make_record(uint32_t(i));
+            writer.append(record, std::get<0>(record));
+        }
+    }
+
+    RecordLogReader_t<decltype(enc),uint32_t> reader(log_range(out.bytes()), enc);
+    LVD_TEST_REQ_EQ(reader.key_sample_interval(), key_sample_interval);
+    LVD_TEST_REQ_EQ(reader.key_samples().size(), (record_count + key_sample_interval - 1) / key_sample_interval);
+    for (uint32_t key : {0u, 1u, 2u, 3u, 47u, 48u, 49u, 1500u, 2997u, 2998u, 5000u}) {
+        auto position = reader.seek_to_key(key);
+        LVD_TEST_REQ_EQ(position % key_sample_interval, size_t(0));
+        // Scan forward for the first record with key >= the given key.
+        size_t scanned = 0;
+        while (!reader.is_at_end() && std::get<0>(reader.read<Record>(reader.position())) < key) {
+            reader.read_next<Record>();
+            ++scanned;
+        }
+        LVD_TEST_REQ_LEQ(scanned, key_sample_interval);
+        LVD_TEST_REQ_EQ(reader.position(), std::min(record_count, size_t((key + 2) / 3)));
+    }
+
+    // Key samples can't be omitted.
+    test::call_function_and_expect_exception<std::domain_error>([&enc](){
+        ByteWriter scratch;
+        RecordLogWriter_t<ByteWriter,decltype(enc),uint32_t> writer(scratch, enc, 16);
+        writer.append(make_record(0));
+    });
+    // Key sample intervals without a key type are rejected.
+    test::call_function_and_expect_exception<std::domain_error>([&enc](){
+        ByteWriter scratch;
+        RecordLogWriter_t<ByteWriter,decltype(enc)>(scratch, enc, 16);
+    });
+LVD_TEST_END
+
+LVD_TEST_BEGIN(233__RecordLog__02__mapped_file)
+    TemporaryFile file("RecordLog");
+    size_t record_count = 2000;
+    {
+        std::ofstream out(file.path, std::ios_base::binary);
+        RecordLogWriter_t<std::ofstream,decltype(bin_lil_e)> writer(out, bin_lil_e);
+        for (size_t i = 0; i < record_count; ++i)
+            writer.append(make_record(uint32_t(i)));
+    }
+
+    MappedFile mapped_file(file.path);
+    RecordLogReader_t<decltype(bin_lil_e)> reader(mapped_file.range(), bin_lil_e);
+    LVD_TEST_REQ_EQ(reader.record_count(), record_count);
+
+    // Reaching a record near the end via the index gives the same result as decoding every record up to it.
+    size_t record_index = record_count - 10;
+    auto indexed = reader.read<Record>(record_index);
+    Record scanned;
+    for (reader.seek(0); reader.position() <= record_index; )
+        scanned = reader.read_next<Record>();
+    LVD_TEST_REQ_IS_TRUE(indexed == make_record(uint32_t(record_index)));
+    LVD_TEST_REQ_IS_TRUE(scanned == indexed);
+
+    // Disjoint ranges of records can be decoded independently, e.g. by separate threads sharing the reader.
+    std::vector<size_t> range_starts{0, record_count/3, 2*record_count/3, record_count};
+    for (size_t r = 0; r+1 < range_starts.size(); ++r) {
+        for (size_t i = range_starts[r]; i < range_starts[r+1]; i += 97)
+            LVD_TEST_REQ_IS_TRUE(reader.read<Record>(i) == make_record(uint32_t(i)));
+    }
+LVD_TEST_END
+
+LVD_TEST_BEGIN(233__RecordLog__03__corrupt)
+    ByteWriter out;
+    {
+        RecordLogWriter_t<ByteWriter,decltype(bin_lil_e),uint32_t> writer(out, bin_lil_e, 2);
+        for (uint32_t i = 0; i < 5; ++i)
+            writer.append(make_record(i), i);
+    }
+    auto const &bytes = out.bytes();
+    using Reader = RecordLogReader_t<decltype(bin_lil_e),uint32_t>;
+    LVD_TEST_REQ_EQ(Reader(log_range(bytes), bin_lil_e).record_count(), size_t(5));
+
+    // Every truncation must be detected.
+    for (size_t size = 0; size < bytes.size(); ++size) {
+        test::call_function_and_expect_exception<std::runtime_error>([&bytes, size](){
+            Reader(Range_t<std::byte const *>(bytes.data(), bytes.data() + size), bin_lil_e);
+        });
+    }
+
+    // Corrupting any byte of the trailer, offsets, or lengths must be detected, or at least not read out of bounds.
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        auto corrupted = bytes;
+        corrupted[i] ^= std::byte{0x80};
+        try {
+            Reader reader(log_range(corrupted), bin_lil_e);
+            for (size_t r = 0; r < reader.record_count(); ++r)
+                reader.read<Record>(r);
+        } catch (std::exception const &) {
+            // Expected in most cases.
+        }
+    }
+LVD_TEST_END
+
+} // end namespace lvd
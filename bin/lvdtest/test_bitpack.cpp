@@ -0,0 +1,54 @@
+// 2021.01.04 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#include "lvd/bitpack.hpp"
+#include "lvd/random.hpp"
+#include "lvd/req.hpp"
+#include "lvd/test.hpp"
+#include <random>
+#include <vector>
+
+namespace lvd {
+
+LVD_TEST_BEGIN(230__bitpack__00)
+    static_assert(bit_width_of(0) == 0);
+    static_assert(bit_width_of(1) == 1);
+    static_assert(bit_width_of(2) == 2);
+    static_assert(bit_width_of(3) == 2);
+    static_assert(bit_width_of(255) == 8);
+    static_assert(bit_width_of(256) == 9);
+    static_assert(bit_width_of(~uint64_t(0)) == 64);
+    static_assert(bit_packed_size_of(0, 64) == 0);
+    static_assert(bit_packed_size_of(3, 3) == 2);
+    static_assert(bit_packed_size_of(128, 64) == 1024);
+
+    // Round-trip every bit width, with counts that do and don't fill a whole number of bytes, including values
+    // which straddle 64-bit words.
+    auto rng = std::mt19937{42};
+    for (size_t bit_width = 0; bit_width <= 64; ++bit_width) {
+        for (size_t count : {size_t(0), size_t(1), size_t(7), size_t(128), size_t(129)}) {
+            std::vector<uint64_t> values(count);
+            for (auto &value : values)
+                value = make_random<uint64_t>(rng) & low_bit_mask(bit_width);
+            std::vector<std::byte> packed(bit_packed_size_of(count, bit_width) + BIT_PACKING_PADDING, std::byte{0xFF});
+            pack_bits(values.data(), count, bit_width, packed.data());
+            // Make sure the padding isn't relied upon.
+            std::fill(packed.begin() + bit_packed_size_of(count, bit_width), packed.end(), std::byte{0xFF});
+            std::vector<uint64_t> unpacked(count, 0xDEADBEEF);
+            unpack_bits(packed.data(), count, bit_width, unpacked.data());
+            LVD_TEST_REQ_IS_TRUE(unpacked == values);
+        }
+    }
+
+    // The packed form is a little-endian bit stream.
+    {
+        std::vector<uint64_t> values{1, 2, 3, 4, 5};
+        std::vector<std::byte> packed(bit_packed_size_of(values.size(), 3) + BIT_PACKING_PADDING);
+        pack_bits(values.data(), values.size(), 3, packed.data());
+        // 001 010 011 100 101 (least significant first) = 0b0'101'100'011'010'001
+        LVD_TEST_REQ_EQ(bit_packed_size_of(values.size(), 3), size_t(2));
+        LVD_TEST_REQ_EQ(uint8_t(packed[0]), uint8_t(0b11'010'001));
+        LVD_TEST_REQ_EQ(uint8_t(packed[1]), uint8_t(0b0'101'100'0));
+    }
+LVD_TEST_END
+
+} // end namespace lvd
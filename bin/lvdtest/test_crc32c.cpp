@@ -0,0 +1,47 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#include "lvd/crc32c.hpp"
+#include "lvd/random.hpp"
+#include "lvd/req.hpp"
+#include "lvd/test.hpp"
+#include <random>
+#include <string>
+#include <vector>
+
+namespace lvd {
+
+LVD_TEST_BEGIN(225__crc32c__00)
+    // Check values from RFC 3720 (iSCSI), appendix B.4, and the standard "123456789" check value.
+    {
+        std::vector<std::byte> zeros(32, std::byte{0x00});
+        std::vector<std::byte> ones(32, std::byte{0xFF});
+        std::vector<std::byte> increasing(32);
+        for (size_t i = 0; i < increasing.size(); ++i)
+            increasing[i] = std::byte(i);
+        std::string check("123456789");
+        LVD_TEST_REQ_EQ(crc32c(zeros.data(), zeros.size()), uint32_t(0x8A9136AA));
+        LVD_TEST_REQ_EQ(crc32c(ones.data(), ones.size()), uint32_t(0x62A8AB43));
+        LVD_TEST_REQ_EQ(crc32c(increasing.data(), increasing.size()), uint32_t(0x46DD794E));
+        LVD_TEST_REQ_EQ(crc32c(check.data(), check.size()), uint32_t(0xE3069283));
+        LVD_TEST_REQ_EQ(crc32c_portable(check.data(), check.size()), uint32_t(0xE3069283));
+        LVD_TEST_REQ_EQ(crc32c(nullptr, 0), uint32_t(0));
+    }
+
+    // The hardware and portable implementations must agree, for all alignments and remainders, and the CRC of a
+    // concatenation must be computable piecewise.
+    auto rng = std::mt19937{42};
+    std::vector<std::byte> bytes(300);
+    for (auto &b : bytes)
+        b = std::byte(make_random<uint8_t>(rng));
+    for (size_t begin = 0; begin < 9; ++begin) {
+        for (size_t end = begin; end < bytes.size(); end += 7) {
+            auto expected = crc32c_portable(bytes.data() + begin, end - begin);
+            LVD_TEST_REQ_EQ(crc32c(bytes.data() + begin, end - begin), expected);
+            auto middle = (begin + end) / 2;
+            LVD_TEST_REQ_EQ(crc32c(bytes.data() + middle, end - middle, crc32c(bytes.data() + begin, middle - begin)), expected);
+            LVD_TEST_REQ_EQ(crc32c_portable(bytes.data() + middle, end - middle, crc32c_portable(bytes.data() + begin, middle - begin)), expected);
+        }
+    }
+LVD_TEST_END
+
+} // end namespace lvd
@@ -5,6 +5,7 @@
 #include "lvd/req.hpp"
 #include "lvd/test.hpp"
 #include <random>
+#include <vector>
 
 namespace lvd {
 
@@ -63,5 +64,32 @@ LVD_TEST_BEGIN(322__endian)
     }
 LVD_TEST_END
 
+template <typename T_>
+void swap_byte_order_of_each_test_case (req::Context &req_context, std::mt19937 &rng) {
+    // Use a variety of counts so that both the SIMD blocks (if enabled) and the remainder loop are exercised.
+    for (size_t count : {0, 1, 2, 3, 7, 8, 15, 16, 17, 31, 32, 33, 1000}) {
+        std::vector<T_> values(count);
+        for (auto &value : values)
+            value = make_random<T_>(rng);
+
+        auto actual = values;
+        swap_byte_order_of_each(actual.data(), actual.size());
+        for (size_t i = 0; i < count; ++i)
+            LVD_TEST_REQ_EQ(actual[i], swapped_byte_order_of(values[i]));
+    }
+}
+
+// 322 must be >= 321 (which is random), since endian.hpp depends on that.
+LVD_TEST_BEGIN(322__swap_byte_order_of_each)
+    auto rng = std::mt19937{42};
+    swap_byte_order_of_each_test_case<uint8_t>(req_context, rng);
+    swap_byte_order_of_each_test_case<uint16_t>(req_context, rng);
+    swap_byte_order_of_each_test_case<int16_t>(req_context, rng);
+    swap_byte_order_of_each_test_case<uint32_t>(req_context, rng);
+    swap_byte_order_of_each_test_case<int32_t>(req_context, rng);
+    swap_byte_order_of_each_test_case<uint64_t>(req_context, rng);
+    swap_byte_order_of_each_test_case<int64_t>(req_context, rng);
+LVD_TEST_END
+
 } // end namespace lvd
 
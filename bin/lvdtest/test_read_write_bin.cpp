@@ -1,6 +1,15 @@
 // 2021.01.04 - Copyright Victor Dods - Licensed under Apache 2.0
 
+#include "lvd/associative_container.hpp"
+#include "lvd/BitPacked_t.hpp"
+#include "lvd/ByteReader.hpp"
+#include "lvd/ByteWriter.hpp"
+#include "lvd/Columnar_t.hpp"
 #include "lvd/comma.hpp"
+#include "lvd/DecodeBudget.hpp"
+#include "lvd/DeltaEncoded_t.hpp"
+#include "lvd/IndexedTuple_t.hpp"
+#include "lvd/LazyValue_t.hpp"
 #include "lvd/literal.hpp"
 #include "lvd/random.hpp"
 #include "lvd/random_map.hpp"
@@ -15,6 +24,10 @@
 #include "lvd/random_variant.hpp"
 #include "lvd/random_vector.hpp"
 #include "lvd/read_bin_array.hpp"
+#include "lvd/read_bin_BitPacked_t.hpp"
+#include "lvd/read_bin_Columnar_t.hpp"
+#include "lvd/read_bin_DeltaEncoded_t.hpp"
+#include "lvd/read_bin_LazyValue_t.hpp"
 #include "lvd/read_bin_map.hpp"
 #include "lvd/read_bin_optional.hpp"
 #include "lvd/read_bin_pair.hpp"
@@ -28,7 +41,13 @@
 #include "lvd/read_bin_vector.hpp"
 #include "lvd/req.hpp"
 #include "lvd/test.hpp"
+#include "lvd/type_id.hpp"
+#include "lvd/type_interning.hpp"
 #include "lvd/write_bin_array.hpp"
+#include "lvd/write_bin_BitPacked_t.hpp"
+#include "lvd/write_bin_Columnar_t.hpp"
+#include "lvd/write_bin_DeltaEncoded_t.hpp"
+#include "lvd/write_bin_LazyValue_t.hpp"
 #include "lvd/write_bin_map.hpp"
 #include "lvd/write_bin_optional.hpp"
 #include "lvd/write_bin_pair.hpp"
@@ -76,6 +95,24 @@ void bin_roundtrip_test_case (req::Context &req_context, Encoding_ const &enc, T
 
         req_context.log() << Log::trc() << "second test passed\n";
     }
+
+    // Also test ByteWriter and ByteReader, which must produce and consume the same bytes as the iostreams.
+    {
+        std::ostringstream expected_out;
+        expected_out << enc.out(expected_value);
+
+        ByteWriter out;
+        out << enc.out(expected_value);
+        LVD_TEST_REQ_EQ(std::string(reinterpret_cast<char const *>(out.bytes().data()), out.size()), expected_out.str());
+
+        ByteReader in(out.range());
+        auto actual_value = enc.template read<T_>(in);
+        LVD_TEST_REQ_EQ(actual_value, expected_value);
+        LVD_TEST_REQ_IS_TRUE(in.good());
+        LVD_TEST_REQ_IS_TRUE(in.range().empty());
+
+        req_context.log() << Log::trc() << "third test passed\n";
+    }
 }
 
 template <typename T_>
@@ -86,6 +123,13 @@ void bin_roundtrip_encoding (req::Context &req_context, T_ const &expected_value
     bin_roundtrip_test_case(req_context, tbin_big_e, expected_value);
     bin_roundtrip_test_case(req_context, tbin_lil_e, expected_value);
     bin_roundtrip_test_case(req_context, tbin_machine_e, expected_value);
+    bin_roundtrip_test_case(req_context, vbin_lil_e, expected_value);
+    bin_roundtrip_test_case(req_context, tvbin_lil_e, expected_value);
+    bin_roundtrip_test_case(req_context, fbin_lil_e, expected_value);
+    bin_roundtrip_test_case(req_context, tfvbin_lil_e, expected_value);
+    // Runtime endianness
+    bin_roundtrip_test_case(req_context, BinEncoding_t<TypeEncoding::EXCLUDED>(Endianness::BIG), expected_value);
+    bin_roundtrip_test_case(req_context, BinEncoding_t<TypeEncoding::INCLUDED>(Endianness::LIL), expected_value);
 }
 
 LVD_TEST_BEGIN(231__read_write_bin__00__singletons)
@@ -145,6 +189,885 @@ LVD_TEST_BEGIN(231__read_write_bin__01__bin_roundtrip)
     bin_roundtrip_encoding_test_case_random(req_context, tbin_big_e);
     bin_roundtrip_encoding_test_case_random(req_context, tbin_lil_e);
     bin_roundtrip_encoding_test_case_random(req_context, tbin_machine_e);
+    bin_roundtrip_encoding_test_case_random(req_context, vbin_lil_e);
+    bin_roundtrip_encoding_test_case_random(req_context, tvbin_lil_e);
+    bin_roundtrip_encoding_test_case_random(req_context, fbin_lil_e);
+    bin_roundtrip_encoding_test_case_random(req_context, tfvbin_lil_e);
+    // Runtime endianness
+    bin_roundtrip_encoding_test_case_random(req_context, BinEncoding_t<TypeEncoding::EXCLUDED>(Endianness::BIG));
+    bin_roundtrip_encoding_test_case_random(req_context, BinEncoding_t<TypeEncoding::EXCLUDED>(Endianness::LIL));
+    bin_roundtrip_encoding_test_case_random(req_context, BinEncoding_t<TypeEncoding::INCLUDED>(Endianness::BIG));
+    bin_roundtrip_encoding_test_case_random(req_context, BinEncoding_t<TypeEncoding::INCLUDED,IntEncoding::VARINT>(Endianness::BIG));
+LVD_TEST_END
+
+LVD_TEST_BEGIN(231__read_write_bin__02__varint)
+    static_assert(vbin_lil_e.int_encoding() == IntEncoding::VARINT);
+    static_assert(decltype(tvbin_lil_e.with_demoted_type_encoding())::int_encoding() == IntEncoding::VARINT);
+
+    auto encoded = [](auto const &enc, auto const &value){
+        std::ostringstream out;
+        out << enc.out(value);
+        return out.str();
+    };
+
+    // Small sizes and integers take a single byte each, where they'd take 8 and 4 bytes respectively otherwise.
+    LVD_TEST_REQ_EQ(encoded(vbin_lil_e, std::vector<uint32_t>{1, 2, 3}).size(), size_t(1 + 3));
+    LVD_TEST_REQ_EQ(encoded(bin_lil_e, std::vector<uint32_t>{1, 2, 3}).size(), size_t(8 + 3*4));
+    LVD_TEST_REQ_EQ(encoded(vbin_lil_e, std::string("hippo")).size(), size_t(1 + 5));
+    // Signed integers are zigzag-encoded, so small negative values are small too.
+    LVD_TEST_REQ_EQ(encoded(vbin_lil_e, int64_t(-1)), std::string("\x01"));
+    LVD_TEST_REQ_EQ(encoded(vbin_lil_e, int64_t(1)), std::string("\x02"));
+    LVD_TEST_REQ_EQ(encoded(vbin_lil_e, uint16_t(300)), std::string("\xAC\x02"));
+    // Floating point values are unaffected.
+    LVD_TEST_REQ_EQ(encoded(vbin_lil_e, 1.5), encoded(bin_lil_e, 1.5));
+
+    // Reading a value that's out of range of the dest type must fail.
+    {
+        std::istringstream in(encoded(vbin_lil_e, uint32_t(70000)));
+        test::call_function_and_expect_exception<std::runtime_error>([&in](){
+            vbin_lil_e.read<uint16_t>(in);
+        });
+    }
+LVD_TEST_END
+
+LVD_TEST_BEGIN(231__read_write_bin__03__static_endianness)
+    static_assert(bin_lil_e.endianness_encoding() == EndiannessEncoding::LIL);
+    static_assert(bin_big_e.endianness() == Endianness::BIG);
+    static_assert(bin_machine_e.is_statically_machine_endian());
+    static_assert(bin_big_e.is_statically_machine_endian() == (MACHINE_ENDIANNESS == Endianness::BIG));
+    static_assert(!BinEncoding_t<TypeEncoding::EXCLUDED>::is_statically_machine_endian());
+    // Changing the type encoding must preserve the static endianness.
+    static_assert(std::is_same_v<std::decay_t<decltype(tbin_big_e.with_demoted_type_encoding())>,BinBigEncoding_t<TypeEncoding::CONDITIONAL>>);
+    LVD_TEST_REQ_EQ(machine_endianness(), MACHINE_ENDIANNESS);
+
+    // Static and runtime endianness must produce identical output.
+    auto encoded = [](auto const &enc, auto const &value){
+        std::ostringstream out;
+        out << enc.out(value);
+        return out.str();
+    };
+    auto value = std::make_tuple(uint32_t(0x01020304), int16_t(-2), 1.5, std::vector<uint64_t>{5, 6});
+    LVD_TEST_REQ_EQ(encoded(bin_big_e, value), encoded(BinEncoding_t<TypeEncoding::EXCLUDED>(Endianness::BIG), value));
+    LVD_TEST_REQ_EQ(encoded(bin_lil_e, value), encoded(BinEncoding_t<TypeEncoding::EXCLUDED>(Endianness::LIL), value));
+    LVD_TEST_REQ_EQ(encoded(tbin_big_e, value), encoded(BinEncoding_t<TypeEncoding::INCLUDED>(Endianness::BIG), value));
+    LVD_TEST_REQ_EQ(encoded(bin_big_e, uint32_t(0x01020304)), std::string("\x01\x02\x03\x04"));
+    LVD_TEST_REQ_EQ(encoded(bin_lil_e, uint32_t(0x01020304)), std::string("\x04\x03\x02\x01"));
+LVD_TEST_END
+
+template <typename T_, typename Encoding_>
+void bin_block_test_case (req::Context &req_context, Encoding_ const &enc, std::vector<T_> const &values) {
+    // The block-written output must be identical to writing the elements individually.
+    std::ostringstream expected_out;
+    expected_out << enc.with_demoted_type_encoding().out(values.size());
+    for (auto const &value : values)
+        expected_out << enc.with_demoted_type_encoding().out(value);
+
+    std::ostringstream out;
+    out << enc.with_demoted_type_encoding().out(values);
+    LVD_TEST_REQ_EQ(out.str(), expected_out.str());
+
+    std::istringstream in(out.str());
+    auto actual = enc.with_demoted_type_encoding().template read<std::vector<T_>>(in);
+    LVD_TEST_REQ_IS_TRUE(actual == values);
+}
+
+template <typename T_, typename Encoding_>
+void bin_block_test_case_random (req::Context &req_context, Encoding_ const &enc) {
+    auto rng = std::mt19937{42};
+    // Use sizes on both sides of the internal chunk sizes.
+    for (size_t size : {size_t(0), size_t(1), size_t(1000), size_t(100000), size_t(300000)}) {
+        std::vector<T_> values(size);
+        for (auto &value : values)
+            value = make_random<T_>(rng);
+        bin_block_test_case(req_context, enc, values);
+    }
+}
+
+template <typename Encoding_>
+void bin_block_encoding_test_case_random (req::Context &req_context, Encoding_ const &enc) {
+    bin_block_test_case_random<std::byte>(req_context, enc);
+    bin_block_test_case_random<int16_t>(req_context, enc);
+    bin_block_test_case_random<uint32_t>(req_context, enc);
+    bin_block_test_case_random<float>(req_context, enc);
+    bin_block_test_case_random<double>(req_context, enc);
+}
+
+LVD_TEST_BEGIN(231__read_write_bin__04__block)
+    static_assert(is_bin_block_encodable_v<double,std::decay_t<decltype(bin_big_e)>>);
+    static_assert(is_bin_block_encodable_v<uint32_t,std::decay_t<decltype(bin_lil_e)>>);
+    static_assert(!is_bin_block_encodable_v<uint32_t,std::decay_t<decltype(vbin_lil_e)>>);
+    static_assert(is_bin_block_encodable_v<double,std::decay_t<decltype(vbin_lil_e)>>);
+    static_assert(!is_bin_block_encodable_v<bool,std::decay_t<decltype(bin_lil_e)>>);
+
+    bin_block_encoding_test_case_random(req_context, bin_big_e);
+    bin_block_encoding_test_case_random(req_context, bin_lil_e);
+    bin_block_encoding_test_case_random(req_context, BinEncoding_t<TypeEncoding::EXCLUDED>(Endianness::BIG));
+    bin_block_encoding_test_case_random(req_context, BinEncoding_t<TypeEncoding::EXCLUDED>(Endianness::LIL));
+
+    // std::array and std::string
+    {
+        std::ostringstream out;
+        out << bin_big_e.out(std::array<uint16_t,3>{0x0102, 0x0304, 0x0506}) << bin_big_e.out(std::string("abc"));
+        LVD_TEST_REQ_EQ(out.str(), std::string("\x01\x02\x03\x04\x05\x06" "\0\0\0\0\0\0\0\x03" "abc", 6+8+3));
+    }
+
+    // A truncated stream must not produce more elements than were present, nor allocate according to the
+    // (corrupt) size.
+    {
+        std::ostringstream out;
+        out << bin_lil_e.out(size_t(1) << 40) << bin_lil_e.out(1.5) << bin_lil_e.out(2.5);
+        std::istringstream in(out.str());
+        auto actual = bin_lil_e.read<std::vector<double>>(in);
+        LVD_TEST_REQ_IS_TRUE(in.fail());
+        LVD_TEST_REQ_LEQ(actual.capacity()*sizeof(double), size_t(0x100000));
+    }
+LVD_TEST_END
+
+template <typename Container_>
+void bit_packed_test_case (req::Context &req_context, Container_ const &expected_value) {
+    BitPacked_t<Container_> bit_packed;
+    bit_packed.container() = expected_value;
+    bin_roundtrip_encoding(req_context, bit_packed);
+}
+
+LVD_TEST_BEGIN(231__read_write_bin__12__bit_packed)
+    auto rng = std::mt19937{42};
+    for (int i = 0; i < 20; ++i) {
+        bit_packed_test_case(req_context, make_random<std::vector<bool>>(rng));
+        bit_packed_test_case(req_context, make_random<std::array<bool,13>>(rng));
+        bit_packed_test_case(req_context, make_random<std::array<bool,64>>(rng));
+        bit_packed_test_case(req_context, make_random<std::vector<std::optional<uint32_t>>>(rng));
+        bit_packed_test_case(req_context, make_random<std::vector<std::optional<std::string>>>(rng));
+        bit_packed_test_case(req_context, make_random<std::array<std::optional<int16_t>,70>>(rng));
+    }
+    bit_packed_test_case(req_context, std::vector<bool>{});
+    bit_packed_test_case(req_context, std::vector<bool>{true, false, true, true, false, false, false, true, true});
+    bit_packed_test_case(req_context, std::vector<std::optional<double>>{1.5, std::nullopt, std::nullopt, -2.0});
+
+    // Sparse optionals cost about one bit each, plus the present values.
+    {
+        std::vector<std::optional<uint64_t>> v(1000000);
+        for (size_t i = 0; i < v.size(); i += 1000)
+            v[i] = i;
+        ByteWriter plain_out;
+        plain_out << bin_lil_e.out(v);
+        ByteWriter packed_out;
+        packed_out << bin_lil_e.out(as_bit_packed(v));
+        req_context.log() << Log::dbg() << v.size() << " optionals: " << plain_out.size() << " bytes with a presence byte each, " << packed_out.size() << " bytes bit-packed\n";
+        LVD_TEST_REQ_EQ(packed_out.size(), sizeof(uint64_t) + v.size()/8 + 1000*sizeof(uint64_t));
+
+        std::vector<std::optional<uint64_t>> actual;
+        ByteReader in(packed_out.range());
+        in >> bin_lil_e.in(as_bit_packed(actual));
+        LVD_TEST_REQ_IS_TRUE(actual == v);
+        LVD_TEST_REQ_IS_TRUE(in.good());
+    }
+
+    // The bit-packed encoding has its own type, and a corrupt size must not cause a huge allocation.
+    {
+        std::vector<bool> v{true, false, true};
+        std::ostringstream out;
+        out << tbin_lil_e.out(as_bit_packed(v));
+        std::istringstream in(out.str());
+        test::call_function_and_expect_exception<std::runtime_error>([&in](){
+            tbin_lil_e.read<std::vector<bool>>(in);
+        });
+
+        out.str("");
+        out << bin_lil_e.out(uint64_t(1) << 60) << bin_lil_e.out(uint32_t(0));
+        in.str(out.str());
+        in.clear();
+        in >> bin_lil_e.in(as_bit_packed(v));
+        LVD_TEST_REQ_IS_TRUE(in.fail());
+        LVD_TEST_REQ_IS_TRUE(v.empty());
+    }
+LVD_TEST_END
+
+template <typename Encoding_>
+void length_framed_test_case (req::Context &req_context, Encoding_ const &enc) {
+    using Record = std::tuple<std::vector<std::string>,std::map<int32_t,double>,uint32_t>;
+    using LazyRecord = std::tuple<LazyValue_t<std::vector<std::string>>,LazyValue_t<std::map<int32_t,double>>,uint32_t>;
+    auto rng = std::mt19937{42};
+    auto records = std::vector<Record>(20);
+    for (auto &record : records)
+        record = make_random<Record>(rng);
+
+    ByteWriter out;
+    for (auto const &record : records)
+        out << enc.out(record);
+    out << enc.out(std::string("hippo"));
+
+    // Skipping a length-framed value doesn't decode it, so it isn't charged to the DecodeBudget.  Otherwise it's
+    // decoded and discarded.
+    {
+        std::istringstream stream_in(std::string(reinterpret_cast<char const *>(out.bytes().data()), out.size()));
+        ByteReader byte_in(out.range());
+        auto check = [&req_context, &enc, &records](auto &in){
+            DecodeBudget budget(DecodeLimits{});
+            for (size_t i = 0; i < records.size(); ++i)
+                skip_value<Record>(in, enc);
+            if constexpr (Encoding_::framing_encoding() == FramingEncoding::LENGTH_PREFIXED)
+                LVD_TEST_REQ_EQ(budget.element_count(), size_t(0));
+            LVD_TEST_REQ_EQ(enc.template read<std::string>(in), std::string("hippo"));
+            LVD_TEST_REQ_IS_TRUE(in.good());
+        };
+        check(stream_in);
+        check(byte_in);
+    }
+
+    // Fields read as LazyValue_t are only decoded when they're used.
+    {
+        ByteReader in(out.range());
+        for (auto const &record : records) {
+            auto lazy_record = enc.template read<LazyRecord>(in);
+            LVD_TEST_REQ_IS_TRUE(in.good());
+            LVD_TEST_REQ_IS_TRUE(!std::get<0>(lazy_record).is_decoded());
+            LVD_TEST_REQ_IS_TRUE(!std::get<1>(lazy_record).is_decoded());
+            LVD_TEST_REQ_EQ(std::get<2>(lazy_record), std::get<2>(record));
+            LVD_TEST_REQ_EQ(std::get<1>(lazy_record).value(), std::get<1>(record));
+            LVD_TEST_REQ_IS_TRUE(std::get<1>(lazy_record).is_decoded());
+            LVD_TEST_REQ_IS_TRUE(!std::get<0>(lazy_record).is_decoded());
+            LVD_TEST_REQ_EQ(*std::get<0>(lazy_record), std::get<0>(record));
+
+            // A LazyValue_t has the same encoding as its value.
+            ByteWriter lazy_out;
+            lazy_out << enc.out(lazy_record);
+            ByteWriter expected_out;
+            expected_out << enc.out(record);
+            LVD_TEST_REQ_IS_TRUE(lazy_out.bytes() == expected_out.bytes());
+        }
+        LVD_TEST_REQ_EQ(enc.template read<std::string>(in), std::string("hippo"));
+        LVD_TEST_REQ_IS_TRUE(in.good());
+    }
+}
+
+LVD_TEST_BEGIN(231__read_write_bin__13__length_framed)
+    length_framed_test_case(req_context, fbin_lil_e);
+    length_framed_test_case(req_context, fvbin_lil_e);
+    length_framed_test_case(req_context, tfvbin_lil_e);
+    length_framed_test_case(req_context, BinEncoding_t<TypeEncoding::EXCLUDED,IntEncoding::FIXED,EndiannessEncoding::RUNTIME,FramingEncoding::LENGTH_PREFIXED>(Endianness::BIG));
+    // Without framing, LazyValue_t still works, it just doesn't save any decoding.
+    length_framed_test_case(req_context, bin_lil_e);
+
+    // Each composite value (and nothing else) is prefixed with its length.
+    {
+        ByteWriter out;
+        out << fbin_lil_e.out(std::pair<uint16_t,std::vector<uint8_t>>{7, {1, 2}});
+        ByteWriter expected_out;
+        expected_out << bin_lil_e.out(size_t(20)) << bin_lil_e.out(uint16_t(7)) << bin_lil_e.out(size_t(10)) << bin_lil_e.out(std::vector<uint8_t>{1, 2});
+        LVD_TEST_REQ_IS_TRUE(out.bytes() == expected_out.bytes());
+    }
+
+    // A frame must be exactly the extent of its value.
+    {
+        ByteWriter out;
+        out << bin_lil_e.out(size_t(9)) << bin_lil_e.out(std::vector<uint8_t>{}) << bin_lil_e.out(uint8_t(0));
+        ByteReader in(out.range());
+        test::call_function_and_expect_exception<std::runtime_error>([&in](){
+            fbin_lil_e.read<std::vector<uint8_t>>(in);
+        });
+
+        auto v = std::vector<uint16_t>{1, 2, 3};
+        ByteWriter short_out;
+        short_out << bin_lil_e.out(size_t(8)) << bin_lil_e.out(v);
+        ByteReader truncated_in(short_out.range());
+        truncated_in >> fbin_lil_e.in(v);
+        LVD_TEST_REQ_IS_TRUE(truncated_in.fail());
+
+        // The same goes for streams that are read sequentially, which count the bytes the value took.
+        std::istringstream stream_in(std::string(reinterpret_cast<char const *>(out.bytes().data()), out.size()));
+        test::call_function_and_expect_exception<std::runtime_error>([&stream_in](){
+            fbin_lil_e.read<std::vector<uint8_t>>(stream_in);
+        });
+        std::istringstream short_stream_in(std::string(reinterpret_cast<char const *>(short_out.bytes().data()), short_out.size()));
+        short_stream_in >> fbin_lil_e.in(v);
+        LVD_TEST_REQ_IS_TRUE(short_stream_in.fail());
+    }
+
+    // The length of a frame can't be known in advance within a TypeInterningWriteSession, and nothing is written.
+    {
+        std::ostringstream out;
+        TypeInterningWriteSession session(out);
+        test::call_function_and_expect_exception<std::runtime_error>([&out](){
+            out << tfvbin_lil_e.out(std::vector<int32_t>{1, 2, 3});
+        });
+        LVD_TEST_REQ_IS_TRUE(out.str().empty());
+    }
+LVD_TEST_END
+
+} // end namespace lvd
+
+LVD_REGISTER_TYPE_ID(map_string_vector_float, lvd::MIN_USER_TYPE_ID, std::map<std::string,std::vector<float>>)
+
+namespace lvd {
+
+LVD_TEST_BEGIN(231__read_write_bin__05__type_id)
+    LVD_TEST_REQ_EQ(type_id_of<uint32_t>(), TypeId(9));
+    LVD_TEST_REQ_EQ((type_id_of<std::map<std::string,std::vector<float>>>()), MIN_USER_TYPE_ID);
+    LVD_TEST_REQ_EQ((type_id_of<std::pair<int,int>>()), UNREGISTERED_TYPE_ID);
+
+    // Registered types are tagged with a single byte.
+    {
+        std::ostringstream out;
+        out << tbin_lil_e.out(uint32_t(123));
+        LVD_TEST_REQ_EQ(out.str().size(), size_t(1 + 4));
+    }
+    {
+        auto expected = std::map<std::string,std::vector<float>>{{"a", {1.5f}}};
+        std::ostringstream out;
+        out << tbin_lil_e.out(expected);
+        LVD_TEST_REQ_EQ(out.str().size(), size_t(1 + 8 + 8+1 + 8+4));
+        std::istringstream in(out.str());
+        auto actual = tbin_lil_e.read<std::map<std::string,std::vector<float>>>(in);
+        LVD_TEST_REQ_IS_TRUE(actual == expected);
+    }
+
+    // Instances of the standard type templates are tagged with the template id followed by the tags of their arguments.
+    {
+        auto expected = std::pair<int16_t,char>{-3, 'x'};
+        std::ostringstream out;
+        out << tbin_lil_e.out(expected);
+        LVD_TEST_REQ_EQ(out.str().size(), size_t(3 + 2 + 1));
+        std::istringstream in(out.str());
+        auto actual = tbin_lil_e.read<std::pair<int16_t,char>>(in);
+        LVD_TEST_REQ_EQ(actual, expected);
+    }
+    {
+        auto expected = std::map<std::string,std::vector<double>>{{"a", {1.5}}};
+        std::ostringstream out;
+        out << tbin_lil_e.out(expected);
+        LVD_TEST_REQ_EQ(out.str().size(), size_t(4 + 8 + 8+1 + 8+8));
+        std::istringstream in(out.str());
+        auto actual = tbin_lil_e.read<std::map<std::string,std::vector<double>>>(in);
+        LVD_TEST_REQ_IS_TRUE(actual == expected);
+    }
+    // The type string of each type tag is the same as the type string of the type.
+    {
+        auto check = [&req_context](auto const &type){
+            using T = typename std::decay_t<decltype(type)>::T;
+            LVD_TEST_REQ_EQ(type_string_of_type_tag(type_tag_of<T>()), type_string_of<T>());
+        };
+        check(ty<std::array<std::set<uint8_t>,3>>);
+        check(ty<std::optional<std::unordered_map<int64_t,std::unordered_set<char>>>>);
+        check(ty<std::tuple<>>);
+        check(ty<std::tuple<bool,std::pair<float,std::string>,lvd::Empty>>);
+        check(ty<std::variant<std::map<std::string,std::vector<float>>,DeltaEncoded_t<std::set<uint32_t>>>>);
+        LVD_TEST_REQ_EQ((type_tag_of<std::map<std::string,std::vector<float>>>()), type_tag_varint(MIN_USER_TYPE_ID));
+    }
+
+    // Unregistered types are tagged with id 0 followed by the type string.
+    {
+        using T = DeltaEncoded_t<std::set<uint32_t>>;
+        auto const &type_string = type_string_of<T>();
+        LVD_TEST_REQ_EQ(type_tag_of<T>(), type_tag_varint(UNREGISTERED_TYPE_ID) + type_tag_varint(type_string.size()) + type_string);
+        std::ostringstream out;
+        out << bin_lil_e.out(ty<std::vector<T>>);
+        LVD_TEST_REQ_EQ(out.str(), type_tag_varint(TypeId(TypeTemplateId::VECTOR)) + type_tag_of<T>());
+        std::istringstream in(out.str());
+        bin_lil_e.read<Type_t<std::vector<T>>>(in);
+        LVD_TEST_REQ_IS_TRUE(in.good());
+    }
+
+    // A registered type tagged by its type string (e.g. by a writer that didn't register it) is still accepted.
+    {
+        std::ostringstream out;
+        out << bin_lil_e.out(uint8_t(UNREGISTERED_TYPE_ID)) << bin_lil_e.out(uint8_t(8)) << "uint32_t" << bin_lil_e.out(uint32_t(456));
+        std::istringstream in(out.str());
+        LVD_TEST_REQ_EQ(tbin_lil_e.read<uint32_t>(in), uint32_t(456));
+    }
+    {
+        auto expected = std::map<std::string,std::vector<float>>{{"a", {1.5f}}};
+        std::ostringstream out;
+        out << type_tag_of_template(TypeTemplateId::MAP, type_tag_of<std::string>(), type_tag_of_template(TypeTemplateId::VECTOR, type_tag_of<float>()))
+            << bin_lil_e.out(expected);
+        std::istringstream in(out.str());
+        auto actual = tbin_lil_e.read<std::map<std::string,std::vector<float>>>(in);
+        LVD_TEST_REQ_IS_TRUE(actual == expected);
+    }
+
+    // Type template ids can't be registered for other types.
+    test::call_function_and_expect_exception<std::domain_error>([](){
+        static_association_singleton<TypeIdRegistry>().emplace("not_a_vector", TypeId(TypeTemplateId::VECTOR));
+    });
+    // Type tags that are nested too deeply are rejected.
+    test::call_function_and_expect_exception<std::runtime_error>([](){
+        std::string type_tag;
+        for (size_t i = 0; i <= MAX_TYPE_TAG_DEPTH+1; ++i)
+            type_tag += type_tag_varint(TypeId(TypeTemplateId::OPTIONAL));
+        std::istringstream in(type_tag + type_tag_varint(TypeId(9)));
+        bin_lil_e.read<Type_t<uint32_t>>(in);
+    });
+
+    // Mismatched types must be rejected.
+    test::call_function_and_expect_exception<std::runtime_error>([](){
+        std::ostringstream out;
+        out << tbin_lil_e.out(int32_t(123));
+        std::istringstream in(out.str());
+        tbin_lil_e.read<uint32_t>(in);
+    });
+    test::call_function_and_expect_exception<std::runtime_error>([](){
+        std::ostringstream out;
+        out << tbin_lil_e.out(std::pair<int16_t,char>{-3, 'x'});
+        std::istringstream in(out.str());
+        tbin_lil_e.read<uint32_t>(in);
+    });
+    test::call_function_and_expect_exception<std::runtime_error>([](){
+        std::ostringstream out;
+        out << bin_lil_e.out(uint8_t(127));
+        std::istringstream in(out.str());
+        tbin_lil_e.read<uint32_t>(in);
+    });
+LVD_TEST_END
+
+LVD_TEST_BEGIN(231__read_write_bin__06__type_interning)
+    using Record = std::pair<int16_t,std::string>;
+    auto rng = std::mt19937{42};
+    std::vector<Record> expected_records;
+    for (int i = 0; i < 1000; ++i)
+        expected_records.emplace_back(make_random<int16_t>(rng), "x");
+    auto const &record_type_string = type_string_of<Record>();
+
+    std::ostringstream plain_out;
+    for (auto const &record : expected_records)
+        plain_out << tbin_lil_e.out(record) << tbin_lil_e.out(uint32_t(7));
+
+    std::ostringstream out;
+    {
+        TypeInterningWriteSession session(out);
+        for (auto const &record : expected_records)
+            out << tbin_lil_e.out(record) << tbin_lil_e.out(uint32_t(7));
+        // Record and uint32_t
+        LVD_TEST_REQ_EQ(session.table_size(), size_t(2));
+    }
+    LVD_TEST_REQ_IS_TRUE(TypeInterningWriteSession::of(out) == nullptr);
+    // Only the first occurrence of each type string is written in full; the rest are 1-byte back-references.
+    auto record_size = size_t(2 + 8 + 1);
+    LVD_TEST_REQ_EQ(out.str().size(), (1 + 8 + record_type_string.size()) + record_size + (1 + 8 + 8) + 4 + 999*(1 + record_size + 1 + 4));
+    LVD_TEST_REQ_LT(out.str().size(), plain_out.str().size());
+
+    {
+        std::istringstream in(out.str());
+        TypeInterningReadSession session(in);
+        for (auto const &expected_record : expected_records) {
+            LVD_TEST_REQ_EQ(tbin_lil_e.read<Record>(in), expected_record);
+            LVD_TEST_REQ_EQ(tbin_lil_e.read<uint32_t>(in), uint32_t(7));
+        }
+        LVD_TEST_REQ_EQ(session.table_size(), size_t(2));
+    }
+
+    // A back-reference to a type string of the wrong type must be rejected, as must an invalid back-reference.
+    test::call_function_and_expect_exception<std::runtime_error>([&out](){
+        std::istringstream in(out.str());
+        TypeInterningReadSession session(in);
+        tbin_lil_e.read<Record>(in);
+        tbin_lil_e.read<uint32_t>(in);
+        tbin_lil_e.read<uint32_t>(in);
+    });
+    test::call_function_and_expect_exception<std::runtime_error>([](){
+        std::ostringstream out;
+        out << bin_lil_e.out(uint8_t(1)) << bin_lil_e.out(uint32_t(123));
+        std::istringstream in(out.str());
+        TypeInterningReadSession session(in);
+        tbin_lil_e.read<uint32_t>(in);
+    });
+LVD_TEST_END
+
+LVD_TEST_BEGIN(231__read_write_bin__07__byte_reader)
+    ByteWriter out;
+    out << bin_lil_e.out(uint32_t(0x01020304)) << bin_lil_e.out(std::string("hippo"));
+    LVD_TEST_REQ_EQ(out.size(), size_t(4 + 8 + 5));
+    auto bytes = out.take_bytes();
+    LVD_TEST_REQ_EQ(out.size(), size_t(0));
+
+    // Reading past the end must fail, as with std::istream.
+    {
+        ByteReader in(Range_t<std::byte const *>(bytes.data(), bytes.data()+bytes.size()-1));
+        LVD_TEST_REQ_EQ(bin_lil_e.read<uint32_t>(in), uint32_t(0x01020304));
+        LVD_TEST_REQ_IS_TRUE(in.good());
+        bin_lil_e.read<std::string>(in);
+        LVD_TEST_REQ_IS_TRUE(in.fail());
+        LVD_TEST_REQ_IS_TRUE(in.eof());
+        LVD_TEST_REQ_IS_TRUE(in.range().empty());
+    }
+    {
+        ByteReader in(Range_t<std::byte const *>(bytes.data(), bytes.data()+2));
+        LVD_TEST_REQ_EQ(in.get(), int('\x04'));
+        LVD_TEST_REQ_EQ(in.get(), int('\x03'));
+        LVD_TEST_REQ_EQ(in.get(), ByteReader::traits_type::eof());
+        LVD_TEST_REQ_IS_TRUE(in.fail());
+    }
+LVD_TEST_END
+
+LVD_TEST_BEGIN(231__read_write_bin__08__decode_budget)
+    auto encoded = [](auto const &enc, auto const &value){
+        std::ostringstream out;
+        out << enc.out(value);
+        return out.str();
+    };
+
+    // A corrupt size must not cause a huge allocation, even without a budget.  A std::istream runs out first,
+    // and a ByteReader rejects it up front.
+    {
+        auto s = encoded(bin_lil_e, uint64_t(1) << 60) + "hippo";
+        std::istringstream in(s);
+        auto value = bin_lil_e.read<std::string>(in);
+        LVD_TEST_REQ_IS_TRUE(in.fail());
+        LVD_TEST_REQ_IS_TRUE(value.size() <= MAX_UNVERIFIED_RESERVE_BYTES);
+
+        auto bytes = reinterpret_cast<std::byte const *>(s.data());
+        ByteReader reader(Range_t<std::byte const *>(bytes, bytes+s.size()));
+        value = bin_lil_e.read<std::string>(reader);
+        LVD_TEST_REQ_IS_TRUE(reader.fail());
+        LVD_TEST_REQ_IS_TRUE(value.empty());
+    }
+    {
+        std::istringstream in(encoded(bin_lil_e, uint64_t(1) << 60) + encoded(bin_lil_e, std::string("hippo")));
+        bin_lil_e.read<std::vector<std::string>>(in);
+        LVD_TEST_REQ_IS_TRUE(in.fail());
+    }
+
+    auto value = std::vector<std::vector<std::string>>{{"abc", "de"}, {}, {"f"}};
+    auto s = encoded(bin_lil_e, value);
+    auto read_with_limits = [&s](DecodeLimits const &limits){
+        DecodeBudget budget(limits);
+        std::istringstream in(s);
+        return bin_lil_e.read<std::vector<std::vector<std::string>>>(in);
+    };
+    // 3 + 2 + 0 + 1 containers' elements, plus 3 + 2 + 1 chars.
+    {
+        DecodeBudget budget(DecodeLimits{});
+        LVD_TEST_REQ_EQ(DecodeBudget::current(), &budget);
+        std::istringstream in(s);
+        LVD_TEST_REQ_IS_TRUE(bin_lil_e.read<std::vector<std::vector<std::string>>>(in) == value);
+        LVD_TEST_REQ_EQ(budget.element_count(), size_t(12));
+        LVD_TEST_REQ_EQ(budget.total_bytes(), 3*sizeof(std::vector<std::string>) + 3*sizeof(std::string) + 6);
+        LVD_TEST_REQ_EQ(budget.nesting_depth(), size_t(0));
+    }
+    LVD_TEST_REQ_EQ(DecodeBudget::current(), static_cast<DecodeBudget *>(nullptr));
+
+    LVD_TEST_REQ_IS_TRUE(read_with_limits(DecodeLimits{SIZE_MAX, 12, 3}) == value);
+    test::call_function_and_expect_exception<std::runtime_error>([&read_with_limits](){
+        read_with_limits(DecodeLimits{SIZE_MAX, 11, SIZE_MAX});
+    });
+    test::call_function_and_expect_exception<std::runtime_error>([&read_with_limits](){
+        read_with_limits(DecodeLimits{SIZE_MAX, SIZE_MAX, 2});
+    });
+    test::call_function_and_expect_exception<std::runtime_error>([&read_with_limits](){
+        read_with_limits(DecodeLimits{100, SIZE_MAX, SIZE_MAX});
+    });
+    // A huge claimed size is rejected by the budget before anything is allocated.
+    {
+        DecodeBudget budget(DecodeLimits{SIZE_MAX, 1000, SIZE_MAX});
+        std::istringstream in(encoded(bin_lil_e, uint64_t(1) << 60));
+        test::call_function_and_expect_exception<std::runtime_error>([&in](){
+            bin_lil_e.read<std::vector<uint64_t>>(in);
+        });
+    }
+LVD_TEST_END
+
+LVD_TEST_BEGIN(231__read_write_bin__09__large_associative)
+    static_assert(is_ordered_associative_container_v<std::map<int,int>>);
+    static_assert(is_ordered_associative_container_v<std::set<int>>);
+    static_assert(!is_ordered_associative_container_v<std::unordered_map<int,int>>);
+    static_assert(!is_ordered_associative_container_v<std::unordered_set<int>>);
+
+    using Map = std::map<uint32_t,uint32_t>;
+    size_t constexpr SIZE = 10000;
+    Map m;
+    std::unordered_set<uint32_t> us;
+    for (uint32_t i = 0; i < SIZE; ++i) {
+        m.emplace(i*7919, i);
+        us.emplace(i*7919);
+    }
+
+    ByteWriter out;
+    out << bin_lil_e.out(m) << bin_lil_e.out(us);
+    auto bytes = out.take_bytes();
+    ByteReader in(Range_t<std::byte const *>(bytes.data(), bytes.data()+bytes.size()));
+    LVD_TEST_REQ_IS_TRUE(bin_lil_e.read<Map>(in) == m);
+    auto actual_us = bin_lil_e.read<std::unordered_set<uint32_t>>(in);
+    LVD_TEST_REQ_IS_TRUE(actual_us == us);
+    // The buckets were reserved up front, instead of growing by rehashing.
+    LVD_TEST_REQ_IS_TRUE(actual_us.bucket_count()*actual_us.max_load_factor() >= float(SIZE));
+    LVD_TEST_REQ_IS_TRUE(in.good());
+LVD_TEST_END
+
+LVD_TEST_BEGIN(231__read_write_bin__10__columnar)
+    using Rows = std::vector<std::tuple<uint32_t,float,uint64_t>>;
+    using MixedRows = std::vector<std::pair<std::string,int16_t>>;
+    auto rng = std::mt19937{42};
+    for (int i = 0; i < 20; ++i) {
+        auto rows = make_random<Rows>(rng);
+        bin_roundtrip_encoding(req_context, Columnar_t<Rows>(rows.begin(), rows.end()));
+        auto mixed_rows = make_random<MixedRows>(rng);
+        bin_roundtrip_encoding(req_context, Columnar_t<MixedRows>(mixed_rows.begin(), mixed_rows.end()));
+    }
+    // Enough rows for several chunks.
+    {
+        Rows rows;
+        for (uint32_t i = 0; i < 10000; ++i)
+            rows.emplace_back(i, float(i)/4, uint64_t(i) << 32);
+        bin_roundtrip_encoding(req_context, Columnar_t<Rows>(rows.begin(), rows.end()));
+    }
+    // Columns wider than a chunk buffer are still written and read a field at a time.
+    {
+        using WideRows = std::vector<std::pair<std::array<uint32_t,2048>,uint32_t>>;
+        WideRows rows(3);
+        for (uint32_t i = 0; i < rows.size(); ++i) {
+            for (uint32_t j = 0; j < rows[i].first.size(); ++j)
+                rows[i].first[j] = i*j;
+            rows[i].second = i;
+        }
+        bin_roundtrip_encoding(req_context, Columnar_t<WideRows>(rows.begin(), rows.end()));
+        {
+            // Skipping the wide column from a stream.
+            std::ostringstream out;
+            out << bin_lil_e.out(as_columnar(rows)) << bin_lil_e.out(uint32_t(42));
+            std::istringstream in(out.str());
+            auto [seconds] = read_bin_columns<WideRows,1>(in, bin_lil_e);
+            LVD_TEST_REQ_EQ(seconds, (std::vector<uint32_t>{0, 1, 2}));
+            LVD_TEST_REQ_EQ(bin_lil_e.read<uint32_t>(in), uint32_t(42));
+            LVD_TEST_REQ_IS_TRUE(in.good());
+        }
+
+        // Wider than the chunk that read_bin_columns grows its columns by.
+        using VeryWideRows = std::vector<std::pair<uint8_t,std::array<uint8_t,MAX_UNVERIFIED_RESERVE_BYTES+1>>>;
+        VeryWideRows very_wide_rows(2);
+        very_wide_rows[1].first = 1;
+        very_wide_rows[1].second.back() = 2;
+        ByteWriter out;
+        out << bin_lil_e.out(as_columnar(very_wide_rows));
+        ByteReader in(out.range());
+        auto [arrays] = read_bin_columns<VeryWideRows,1>(in, bin_lil_e);
+        LVD_TEST_REQ_IS_TRUE(in.good());
+        LVD_TEST_REQ_EQ(arrays.size(), size_t(2));
+        LVD_TEST_REQ_IS_TRUE(arrays[1] == very_wide_rows[1].second);
+    }
+    // IndexedTuple_t elements are tuple-like too.
+    {
+        using IndexedRows = std::vector<IndexedTuple_t<0,uint32_t,std::string,double>>;
+        IndexedRows rows;
+        for (uint32_t i = 0; i < 100; ++i)
+            rows.emplace_back(i, std::to_string(i), double(i)/8);
+        bin_roundtrip_encoding(req_context, Columnar_t<IndexedRows>(rows.begin(), rows.end()));
+    }
+
+    // Each column is contiguous.
+    {
+        std::vector<std::pair<uint8_t,uint16_t>> rows{{1, 2}, {3, 4}};
+        ByteWriter out;
+        out << bin_lil_e.out(as_columnar(rows));
+        auto expected = std::vector<uint8_t>{2, 0, 0, 0, 0, 0, 0, 0, 1, 3, 2, 0, 4, 0};
+        LVD_TEST_REQ_EQ(out.size(), expected.size());
+        LVD_TEST_REQ_IS_TRUE(std::equal(expected.begin(), expected.end(), out.bytes().begin(), [](uint8_t a, std::byte b){ return a == uint8_t(b); }));
+
+        decltype(rows) actual;
+        ByteReader in(out.range());
+        in >> bin_lil_e.in(as_columnar(actual));
+        LVD_TEST_REQ_IS_TRUE(actual == rows);
+    }
+
+    // The columnar encoding has its own type, so it can't be mistaken for the row-wise one.
+    {
+        Rows rows{{1, 2.0f, 3}};
+        std::ostringstream out;
+        out << tbin_lil_e.out(as_columnar(rows));
+        std::istringstream in(out.str());
+        test::call_function_and_expect_exception<std::runtime_error>([&in](){
+            tbin_lil_e.read<Rows>(in);
+        });
+    }
+
+    // Reading only some of the columns.
+    {
+        using WideRows = std::vector<std::tuple<uint32_t,std::string,double,std::vector<uint16_t>,int64_t>>;
+        auto rows = make_random<WideRows>(rng);
+        auto check_selected_columns = [&req_context, &rows](auto const &enc){
+            ByteWriter out;
+            out << enc.out(as_columnar(rows)) << enc.out(std::string("hippo"));
+            ByteReader byte_in(out.range());
+            std::istringstream stream_in(std::string(reinterpret_cast<char const *>(out.bytes().data()), out.size()));
+            auto check = [&req_context, &rows, &enc](auto &in){
+                auto [doubles, ids] = read_bin_columns<WideRows,2,0>(in, enc);
+                LVD_TEST_REQ_EQ(doubles.size(), rows.size());
+                LVD_TEST_REQ_EQ(ids.size(), rows.size());
+                for (size_t i = 0; i < rows.size(); ++i) {
+                    LVD_TEST_REQ_EQ(doubles[i], std::get<2>(rows[i]));
+                    LVD_TEST_REQ_EQ(ids[i], std::get<0>(rows[i]));
+                }
+                // The skipped columns were consumed too.
+                LVD_TEST_REQ_EQ(enc.template read<std::string>(in), std::string("hippo"));
+                LVD_TEST_REQ_IS_TRUE(in.good());
+
+                auto [strings] = read_bin_columns<WideRows,1>(in, enc);
+                LVD_TEST_REQ_IS_TRUE(strings.empty());
+                LVD_TEST_REQ_IS_TRUE(in.fail());
+            };
+            check(byte_in);
+            check(stream_in);
+        };
+        check_selected_columns(bin_lil_e);
+        check_selected_columns(bin_big_e);
+        check_selected_columns(tbin_lil_e);
+        check_selected_columns(vbin_lil_e);
+    }
+
+    // A corrupt size must not cause a huge allocation.
+    {
+        std::ostringstream out;
+        out << bin_lil_e.out(uint64_t(1) << 60) << bin_lil_e.out(uint32_t(0));
+        std::istringstream in(out.str());
+        Rows rows;
+        in >> bin_lil_e.in(as_columnar(rows));
+        LVD_TEST_REQ_IS_TRUE(in.fail());
+        LVD_TEST_REQ_IS_TRUE(rows.size()*sizeof(Rows::value_type) <= MAX_UNVERIFIED_RESERVE_BYTES);
+    }
+LVD_TEST_END
+
+template <typename Container_>
+void delta_encoded_test_case (req::Context &req_context, Container_ const &expected_value) {
+    bin_roundtrip_encoding(req_context, DeltaEncoded_t<Container_>(expected_value.begin(), expected_value.end()));
+}
+
+LVD_TEST_BEGIN(231__read_write_bin__11__delta_encoded)
+    auto rng = std::mt19937{42};
+    for (int i = 0; i < 20; ++i) {
+        delta_encoded_test_case(req_context, make_random<std::set<uint64_t>>(rng));
+        delta_encoded_test_case(req_context, make_random<std::set<int32_t>>(rng));
+        delta_encoded_test_case(req_context, make_random<std::set<int8_t>>(rng));
+        delta_encoded_test_case(req_context, make_random<std::set<uint16_t>>(rng));
+        delta_encoded_test_case(req_context, make_random<std::map<int64_t,std::string>>(rng));
+        delta_encoded_test_case(req_context, make_random<std::map<uint32_t,double>>(rng));
+    }
+    // Several blocks, and extreme differences.
+    {
+        std::set<int64_t> s{std::numeric_limits<int64_t>::min(), -1, 0, std::numeric_limits<int64_t>::max()};
+        for (int64_t i = 0; i < 1000; ++i)
+            s.insert(i*i);
+        delta_encoded_test_case(req_context, s);
+        std::map<uint64_t,uint8_t> m;
+        for (uint64_t i = 0; i < 1000; ++i)
+            m.emplace(i << (i % 64), uint8_t(i));
+        delta_encoded_test_case(req_context, m);
+    }
+
+    // prefix_sum_in_place matches a serial sum, including wraparound, for any count (e.g. odd ones).
+    for (size_t count = 0; count < 10; ++count) {
+        std::vector<uint64_t> values(count);
+        for (auto &value : values)
+            value = std::uniform_int_distribution<uint64_t>()(rng);
+        uint64_t base = std::uniform_int_distribution<uint64_t>()(rng);
+        std::vector<uint64_t> expected(values);
+        uint64_t expected_last = base;
+        for (auto &value : expected) {
+            expected_last += value;
+            value = expected_last;
+        }
+        LVD_TEST_REQ_EQ(prefix_sum_in_place(values.data(), values.size(), base), expected_last);
+        LVD_TEST_REQ_IS_TRUE(values == expected);
+    }
+
+    // Sorted ids that are mostly dense are much smaller than when written at full width.
+    {
+        std::set<uint64_t> ids;
+        uint64_t id = 1000000000000;
+        while (ids.size() < 100000) {
+            id += std::uniform_int_distribution<uint64_t>(1, 100)(rng);
+            ids.insert(id);
+        }
+        ByteWriter full_out;
+        full_out << bin_lil_e.out(ids);
+        ByteWriter delta_out;
+        delta_out << bin_lil_e.out(as_delta_encoded(ids));
+        req_context.log() << Log::dbg() << ids.size() << " ids: " << full_out.size() << " bytes at full width, " << delta_out.size() << " bytes delta-encoded\n";
+        LVD_TEST_REQ_IS_TRUE(delta_out.size()*7 < full_out.size());
+
+        std::set<uint64_t> actual;
+        ByteReader in(delta_out.range());
+        in >> bin_lil_e.in(as_delta_encoded(actual));
+        LVD_TEST_REQ_IS_TRUE(actual == ids);
+        LVD_TEST_REQ_IS_TRUE(in.good());
+    }
+
+    // The delta encoding has its own type, and invalid bit widths are rejected.
+    {
+        std::set<uint32_t> s{1, 2, 3};
+        std::ostringstream out;
+        out << tbin_lil_e.out(as_delta_encoded(s));
+        std::istringstream in(out.str());
+        test::call_function_and_expect_exception<std::runtime_error>([&in](){
+            tbin_lil_e.read<std::set<uint32_t>>(in);
+        });
+
+        out.str("");
+        out << bin_lil_e.out(size_t(3)) << bin_lil_e.out(uint32_t(1)) << bin_lil_e.out(uint8_t(65)) << std::string(20, '\0');
+        in.str(out.str());
+        in.clear();
+        test::call_function_and_expect_exception<std::runtime_error>([&in, &s](){
+            in >> bin_lil_e.in(as_delta_encoded(s));
+        });
+    }
+LVD_TEST_END
+
+template <typename Encoding_>
+void fixed_layout_test_case (req::Context &req_context, Encoding_ const &enc) {
+    // A std::tuple is always written field by field, so it's the reference for the bytes of the equivalent std::pair.
+    auto pairs = std::vector<std::pair<int32_t,float>>{{-1, 0.25f}, {0x12345678, -3.5f}, {7, 1e10f}};
+    auto tuples = std::vector<std::tuple<int32_t,float>>(pairs.begin(), pairs.end());
+    std::ostringstream pairs_out;
+    pairs_out << enc.out(pairs) << enc.out(pairs[1]);
+    std::ostringstream tuples_out;
+    tuples_out << enc.out(tuples) << enc.out(tuples[1]);
+    LVD_TEST_REQ_EQ(pairs_out.str(), tuples_out.str());
+
+    auto arrays = std::vector<std::array<std::pair<uint16_t,int8_t>,2>>{{{{1, -1}, {2, -2}}}, {{{0xFFFF, 127}, {0, -128}}}};
+    auto nested = std::vector<std::tuple<std::tuple<uint16_t,int8_t>,std::tuple<uint16_t,int8_t>>>{};
+    for (auto const &array : arrays)
+        nested.emplace_back(array[0], array[1]);
+    std::ostringstream arrays_out;
+    arrays_out << enc.out(arrays);
+    std::ostringstream nested_out;
+    nested_out << enc.out(nested);
+    LVD_TEST_REQ_EQ(arrays_out.str(), nested_out.str());
+
+    bin_roundtrip_test_case(req_context, enc, pairs);
+    bin_roundtrip_test_case(req_context, enc, pairs[1]);
+    bin_roundtrip_test_case(req_context, enc, arrays);
+}
+
+LVD_TEST_BEGIN(231__read_write_bin__14__fixed_layout)
+    static_assert(is_fixed_layout_v<std::pair<int32_t,float>,AnyLeaf>);
+    static_assert(is_fixed_layout_v<std::array<std::pair<uint16_t,uint16_t>,3>,AnyLeaf>);
+    static_assert(!is_fixed_layout_v<std::pair<uint16_t,uint32_t>,AnyLeaf>);
+    static_assert(!is_fixed_layout_v<std::tuple<int32_t,float>,AnyLeaf>);
+
+    static_assert(is_bin_block_encodable_v<std::pair<int32_t,float>,std::decay_t<decltype(bin_lil_e)>>);
+    static_assert(is_bin_block_encodable_v<std::pair<int32_t,float>,std::decay_t<decltype(bin_big_e)>>);
+    static_assert(is_bin_block_encodable_v<std::array<std::pair<int32_t,float>,2>,std::decay_t<decltype(bin_lil_e)>>);
+    // Type info, varint-encoded leaves, bool leaves, and length frames all preclude the block path.
+    static_assert(!is_bin_block_encodable_v<std::pair<int32_t,float>,std::decay_t<decltype(tbin_lil_e)>>);
+    static_assert(!is_bin_block_encodable_v<std::pair<int32_t,float>,std::decay_t<decltype(vbin_lil_e)>>);
+    static_assert(is_bin_block_encodable_v<std::pair<float,float>,std::decay_t<decltype(vbin_lil_e)>>);
+    static_assert(!is_bin_block_encodable_v<std::pair<bool,bool>,std::decay_t<decltype(bin_lil_e)>>);
+    static_assert(!is_bin_block_encodable_v<std::pair<int32_t,float>,std::decay_t<decltype(fbin_lil_e)>>);
+
+    fixed_layout_test_case(req_context, bin_lil_e);
+    fixed_layout_test_case(req_context, bin_big_e);
+    fixed_layout_test_case(req_context, bin_machine_e);
+    fixed_layout_test_case(req_context, vbin_lil_e);
+    fixed_layout_test_case(req_context, BinEncoding_t<TypeEncoding::EXCLUDED>(Endianness::BIG));
+    bin_roundtrip_encoding(req_context, std::vector<std::pair<float,double>>{{1.5f, -2.25}, {0.0f, 1e100}});
+    bin_roundtrip_encoding(req_context, std::array<std::pair<int64_t,uint64_t>,2>{{{-1, 1}, {2, 3}}});
+
+    // Elements bigger than the chunks that are byte-swapped (4 KiB) or read (1 MiB) at a time.
+    {
+        std::vector<std::array<uint32_t,2048>> wide(2);
+        wide[1].fill(0x01020304);
+        bin_roundtrip_encoding(req_context, wide);
+        std::vector<std::array<uint16_t,MAX_UNVERIFIED_RESERVE_BYTES/2+1>> very_wide(2);
+        very_wide[1].back() = 0x0102;
+        bin_roundtrip_encoding(req_context, very_wide);
+    }
 LVD_TEST_END
 
 } // end namespace lvd
@@ -0,0 +1,193 @@
+// 2021.01.04 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#include "lvd/ByteReader.hpp"
+#include "lvd/comma.hpp"
+#include "lvd/literal.hpp"
+#include "lvd/random.hpp"
+#include "lvd/random_array.hpp"
+#include "lvd/random_map.hpp"
+#include "lvd/random_optional.hpp"
+#include "lvd/random_pair.hpp"
+#include "lvd/random_set.hpp"
+#include "lvd/random_string.hpp"
+#include "lvd/random_tuple.hpp"
+#include "lvd/random_unordered_map.hpp"
+#include "lvd/random_unordered_set.hpp"
+#include "lvd/random_vector.hpp"
+#include "lvd/read_text_array.hpp"
+#include "lvd/read_text_map.hpp"
+#include "lvd/read_text_optional.hpp"
+#include "lvd/read_text_pair.hpp"
+#include "lvd/read_text_set.hpp"
+#include "lvd/read_text_string.hpp"
+#include "lvd/read_text_tuple.hpp"
+#include "lvd/read_text_type.hpp"
+#include "lvd/read_text_unordered_map.hpp"
+#include "lvd/read_text_unordered_set.hpp"
+#include "lvd/read_text_vector.hpp"
+#include "lvd/req.hpp"
+#include "lvd/test.hpp"
+#include "lvd/write_text_array.hpp"
+#include "lvd/write_text_map.hpp"
+#include "lvd/write_text_optional.hpp"
+#include "lvd/write_text_pair.hpp"
+#include "lvd/write_text_set.hpp"
+#include "lvd/write_text_string.hpp"
+#include "lvd/write_text_tuple.hpp"
+#include "lvd/write_text_type.hpp"
+#include "lvd/write_text_unordered_map.hpp"
+#include "lvd/write_text_unordered_set.hpp"
+#include "lvd/write_text_vector.hpp"
+#include <cmath>
+#include <limits>
+#include "print.hpp"
+#include <random>
+#include <sstream>
+#include <string>
+
+namespace lvd {
+
+template <typename T_, typename Encoding_>
+void text_roundtrip_test_case (req::Context &req_context, Encoding_ const &enc, T_ const &expected_value) {
+    std::ostringstream out;
+    out << enc.out(expected_value);
+    req_context.log() << Log::trc() << "actual output = " << literal_of(out.str()) << '\n';
+
+    if constexpr (std::is_default_constructible_v<T_>) {
+        T_ actual_value;
+        std::istringstream in(out.str());
+        in >> enc.in(actual_value);
+        req_context.log() << Log::trc() << LVD_REFLECT(expected_value) << cspace << LVD_REFLECT(actual_value) << '\n';
+        LVD_TEST_REQ_EQ(actual_value, expected_value);
+    }
+
+    // Also test read_value.
+    {
+        std::istringstream in(out.str());
+        auto actual_value = enc.template read<T_>(in);
+        LVD_TEST_REQ_EQ(actual_value, expected_value);
+        LVD_TEST_REQ_IS_TRUE(!in.fail());
+    }
+
+    // Also test ByteReader, which must consume exactly the output.
+    {
+        auto s = out.str();
+        auto bytes = reinterpret_cast<std::byte const *>(s.data());
+        ByteReader in(Range_t<std::byte const *>(bytes, bytes+s.size()));
+        auto actual_value = enc.template read<T_>(in);
+        LVD_TEST_REQ_EQ(actual_value, expected_value);
+        LVD_TEST_REQ_IS_TRUE(!in.fail());
+        LVD_TEST_REQ_IS_TRUE(in.range().empty());
+    }
+}
+
+template <typename T_, typename Encoding_>
+void text_roundtrip_test_case_random (req::Context &req_context, Encoding_ const &enc) {
+    auto rng = std::mt19937{42};
+    for (int i = 0; i < 100; ++i)
+        text_roundtrip_test_case(req_context, enc, make_random<T_>(rng));
+}
+
+template <typename Encoding_>
+void text_roundtrip_encoding_test_case_random (req::Context &req_context, Encoding_ const &enc) {
+    text_roundtrip_test_case_random<bool>(req_context, enc);
+    text_roundtrip_test_case_random<std::byte>(req_context, enc);
+    text_roundtrip_test_case_random<char>(req_context, enc);
+    text_roundtrip_test_case_random<int8_t>(req_context, enc);
+    text_roundtrip_test_case_random<uint8_t>(req_context, enc);
+    text_roundtrip_test_case_random<int16_t>(req_context, enc);
+    text_roundtrip_test_case_random<uint16_t>(req_context, enc);
+    text_roundtrip_test_case_random<int32_t>(req_context, enc);
+    text_roundtrip_test_case_random<uint32_t>(req_context, enc);
+    text_roundtrip_test_case_random<int64_t>(req_context, enc);
+    text_roundtrip_test_case_random<uint64_t>(req_context, enc);
+    text_roundtrip_test_case_random<float>(req_context, enc);
+    text_roundtrip_test_case_random<double>(req_context, enc);
+    text_roundtrip_test_case_random<std::string>(req_context, enc);
+    text_roundtrip_test_case_random<std::optional<uint32_t>>(req_context, enc);
+    text_roundtrip_test_case_random<std::optional<double>>(req_context, enc);
+    text_roundtrip_test_case_random<std::optional<std::string>>(req_context, enc);
+    text_roundtrip_test_case_random<std::pair<char,uint8_t>>(req_context, enc);
+    text_roundtrip_test_case_random<std::tuple<int8_t>>(req_context, enc);
+    text_roundtrip_test_case_random<std::tuple<bool,int8_t>>(req_context, enc);
+    text_roundtrip_test_case_random<std::tuple<char,bool,int8_t>>(req_context, enc);
+    text_roundtrip_test_case_random<std::array<float,4>>(req_context, enc);
+    text_roundtrip_test_case_random<std::vector<std::byte>>(req_context, enc);
+    text_roundtrip_test_case_random<std::vector<std::string>>(req_context, enc);
+    text_roundtrip_test_case_random<std::map<char,double>>(req_context, enc);
+    text_roundtrip_test_case_random<std::set<double>>(req_context, enc);
+    text_roundtrip_test_case_random<std::unordered_map<std::string,int8_t>>(req_context, enc);
+    text_roundtrip_test_case_random<std::unordered_set<int8_t>>(req_context, enc);
+}
+
+LVD_TEST_BEGIN(232__read_write_text__00__roundtrip)
+    text_roundtrip_encoding_test_case_random(req_context, txt);
+    text_roundtrip_encoding_test_case_random(req_context, lit);
+    text_roundtrip_encoding_test_case_random(req_context, stxt);
+    text_roundtrip_encoding_test_case_random(req_context, slit);
+LVD_TEST_END
+
+LVD_TEST_BEGIN(232__read_write_text__01__singletons)
+    text_roundtrip_test_case(req_context, txt, ty<int32_t>);
+    text_roundtrip_test_case(req_context, txt, ty<std::vector<std::map<std::byte,bool>>>);
+    text_roundtrip_test_case(req_context, lit, ty<std::string>);
+    text_roundtrip_test_case(req_context, txt, std::tuple<>());
+    text_roundtrip_test_case(req_context, lit, std::tuple<>());
+    text_roundtrip_test_case(req_context, txt, std::string("\0\a\b\t\n\v\f\r\"\\\x7F\xA7'", 14));
+    for (char c : {'\0', '\a', '\n', '\\', '\'', '"', '\x7F', '\xA7'})
+        text_roundtrip_test_case(req_context, txt, c);
+    for (double x : {0.0, -0.0, 1e-300, 1e300, std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()}) {
+        text_roundtrip_test_case(req_context, txt, x);
+        text_roundtrip_test_case(req_context, stxt, std::optional<double>(x));
+    }
+    // `nan` and `nullopt` both start with 'n'.
+    {
+        std::istringstream in("nan");
+        auto value = txt.read<std::optional<double>>(in);
+        LVD_TEST_REQ_IS_TRUE(value.has_value() && std::isnan(*value));
+    }
+    text_roundtrip_test_case(req_context, txt, std::optional<double>());
+    text_roundtrip_test_case(req_context, lit, std::vector<std::optional<bool>>{true, std::nullopt, false});
+LVD_TEST_END
+
+LVD_TEST_BEGIN(232__read_write_text__02__whitespace)
+    // Whitespace is allowed before each token.
+    std::istringstream in(" ( ( 'h' ,false) ,\n\t('i', true ) ) ");
+    LVD_TEST_REQ_IS_TRUE((txt.read<std::map<char,bool>>(in) == std::map<char,bool>{{'h',false}, {'i',true}}));
+    std::istringstream in2(" vector<int32_t>( 1,-2 , 3 )");
+    LVD_TEST_REQ_IS_TRUE((lit.read<std::vector<int32_t>>(in2) == std::vector<int32_t>{1, -2, 3}));
+LVD_TEST_END
+
+template <typename T_, typename Encoding_>
+void text_malformed_test_case (req::Context &req_context, Encoding_ const &enc, std::string const &input) {
+    req_context.log() << Log::trc() << "input = " << literal_of(input) << '\n';
+    std::istringstream in(input);
+    test::call_function_and_expect_exception<std::runtime_error>([&enc, &in](){
+        enc.template read<T_>(in);
+    });
+}
+
+LVD_TEST_BEGIN(232__read_write_text__03__malformed)
+    text_malformed_test_case<bool>(req_context, txt, "");
+    text_malformed_test_case<bool>(req_context, txt, "truth");
+    text_malformed_test_case<int8_t>(req_context, txt, "128");
+    text_malformed_test_case<uint32_t>(req_context, txt, "-1");
+    text_malformed_test_case<int32_t>(req_context, txt, "12x");
+    text_malformed_test_case<int32_t>(req_context, lit, "int64_t(12)");
+    text_malformed_test_case<int32_t>(req_context, lit, "int32_t(12");
+    text_malformed_test_case<std::byte>(req_context, txt, "0x100");
+    text_malformed_test_case<std::byte>(req_context, txt, "12");
+    text_malformed_test_case<char>(req_context, txt, "'ab'");
+    text_malformed_test_case<double>(req_context, txt, "1.5.5");
+    text_malformed_test_case<std::string>(req_context, txt, "\"unterminated");
+    text_malformed_test_case<std::string>(req_context, txt, "\"\\777\"");
+    text_malformed_test_case<std::vector<int32_t>>(req_context, txt, "(1, 2");
+    text_malformed_test_case<std::vector<int32_t>>(req_context, txt, "(1 2)");
+    text_malformed_test_case<std::array<int32_t,2>>(req_context, txt, "(1, 2, 3)");
+    text_malformed_test_case<std::tuple<int32_t>>(req_context, txt, "(1)");
+    text_malformed_test_case<std::optional<int32_t>>(req_context, txt, "nullop");
+    text_malformed_test_case<std::optional<double>>(req_context, txt, "nulloptx");
+    text_malformed_test_case<Type_t<int32_t>>(req_context, txt, "int16_t");
+LVD_TEST_END
+
+} // end namespace lvd
@@ -3,6 +3,7 @@
 #include "DerivedString_serialization.hpp"
 #include <iomanip>
 #include "lvd/abort.hpp"
+#include "lvd/DecodeBudget.hpp"
 #include "lvd/random.hpp"
 #include "lvd/random_array.hpp"
 #include "lvd/random_map.hpp"
@@ -20,6 +21,7 @@
 #include <ostream>
 #include "print.hpp"
 #include <random>
+#include <tuple>
 
 namespace lvd {
 
@@ -34,6 +36,8 @@ void serialization_test_case (req::Context &req_context, std::vector<std::byte>
             auto expected = make_random<T_>(rng);
 
             serialize_from(expected, std::back_inserter(buffer));
+            if constexpr (has_serialized_size_v<T_>)
+                LVD_TEST_REQ_EQ(serialized_size_of(expected), buffer.size());
 
             T_ actual;
             deserialize_to(actual, lvd::range(buffer));
@@ -110,10 +114,330 @@ LVD_TEST_BEGIN(323__serialization__00)
     serialization_test_case<std::optional<std::string>>(req_context, buffer);
     serialization_test_case<std::optional<std::optional<double>>>(req_context, buffer);
 
+    serialization_test_case<std::vector<float>>(req_context, buffer);
+    serialization_test_case<std::vector<double>>(req_context, buffer);
+    serialization_test_case<std::vector<int16_t>>(req_context, buffer);
+    serialization_test_case<std::vector<std::byte>>(req_context, buffer);
+    serialization_test_case<std::array<uint64_t,7>>(req_context, buffer);
+    serialization_test_case<std::array<double,5>>(req_context, buffer);
+
 //     // Do an absurd one for fun.
 //     serialization_test_case<std::vector<std::map<std::string,std::unordered_map<int,std::set<uint16_t>>>>>(req_context, buffer);
 LVD_TEST_END
 
+// Contiguous containers of basic-serializable types are [de]serialized as a block, so verify
+// that the serialized form is still the little-endian, element-by-element layout, and that
+// containers larger than the internal byte-swapping chunk size round-trip.
+LVD_TEST_BEGIN(323__serialization__02__contiguous)
+    {
+        auto v = std::vector<uint32_t>{0x04030201, 0x08070605};
+        auto buffer = serialized_from(v);
+        auto expected = std::vector<std::byte>{
+            std::byte{0x02}, std::byte{0x00}, std::byte{0x00}, std::byte{0x00}, // uint32_t size
+            std::byte{0x01}, std::byte{0x02}, std::byte{0x03}, std::byte{0x04},
+            std::byte{0x05}, std::byte{0x06}, std::byte{0x07}, std::byte{0x08},
+        };
+        LVD_TEST_REQ_EQ(buffer.size(), expected.size());
+        LVD_TEST_REQ_IS_TRUE(buffer == expected);
+    }
+
+    {
+        auto rng = std::mt19937{42};
+        auto v = std::vector<double>(12345);
+        for (auto &x : v)
+            x = make_random<double>(rng);
+        auto buffer = serialized_from(v);
+        LVD_TEST_REQ_EQ(buffer.size(), sizeof(uint32_t) + v.size()*sizeof(double));
+        // Compare against serializing each element individually.
+        for (size_t i = 0; i < v.size(); ++i) {
+            std::vector<std::byte> element_buffer;
+            serialize_from(v[i], std::back_inserter(element_buffer));
+            LVD_TEST_REQ_IS_TRUE(std::equal(element_buffer.begin(), element_buffer.end(), buffer.begin() + sizeof(uint32_t) + i*sizeof(double)));
+        }
+        auto actual = deserialized_to<std::vector<double>>(lvd::range(buffer));
+        LVD_TEST_REQ_IS_TRUE(actual == v);
+    }
+
+    // Truncated input must be rejected.
+    {
+        auto buffer = serialized_from(std::vector<uint64_t>{1, 2, 3});
+        buffer.pop_back();
+        test::call_function_and_expect_exception<req::Failure>([&buffer](){
+            deserialized_to<std::vector<uint64_t>>(lvd::range(buffer));
+        });
+    }
+LVD_TEST_END
+
+struct NoSerializedSize { };
+
+// A string whose SerializedSize_t is off by SIZE_ERROR_, i.e. which disagrees with its SerializeFrom_t.
+template <int SIZE_ERROR_>
+struct MiscountedString {
+    std::string value;
+};
+
+template <int SIZE_ERROR_>
+struct SerializeFrom_t<MiscountedString<SIZE_ERROR_>> {
+    template <typename DestIterator_>
+    void operator() (MiscountedString<SIZE_ERROR_> const &source, DestIterator_ dest) const {
+        serialize_from(source.value, dest);
+    }
+};
+
+template <int SIZE_ERROR_>
+struct SerializedSize_t<MiscountedString<SIZE_ERROR_>> : public SerializedSize_VariableSize_t {
+    size_t operator() (MiscountedString<SIZE_ERROR_> const &source) const {
+        return size_t(int(serialized_size_of(source.value)) + SIZE_ERROR_);
+    }
+};
+
+LVD_TEST_BEGIN(323__serialization__03__serialized_size)
+    static_assert(SerializedSize_t<uint8_t>::IS_FIXED && SerializedSize_t<uint8_t>::FIXED_SIZE == 1);
+    static_assert(SerializedSize_t<double>::IS_FIXED && SerializedSize_t<double>::FIXED_SIZE == 8);
+    static_assert(SerializedSize_t<std::pair<uint16_t,float>>::IS_FIXED && SerializedSize_t<std::pair<uint16_t,float>>::FIXED_SIZE == 6);
+    static_assert(SerializedSize_t<std::array<uint32_t,5>>::IS_FIXED && SerializedSize_t<std::array<uint32_t,5>>::FIXED_SIZE == 20);
+    static_assert(SerializedSize_t<std::array<std::pair<int8_t,uint64_t>,3>>::FIXED_SIZE == 27);
+    static_assert(!SerializedSize_t<std::vector<uint32_t>>::IS_FIXED);
+    static_assert(!SerializedSize_t<std::optional<uint32_t>>::IS_FIXED);
+    static_assert(!SerializedSize_t<std::pair<uint32_t,std::string>>::IS_FIXED);
+    static_assert(!SerializedSize_t<std::array<std::string,2>>::IS_FIXED);
+    static_assert(has_serialized_size_v<std::map<std::string,std::vector<std::optional<int>>>>);
+    static_assert(!has_serialized_size_v<NoSerializedSize>);
+    static_assert(!has_serialized_size_v<std::vector<NoSerializedSize>>);
+    static_assert(!has_serialized_size_v<std::pair<int,NoSerializedSize>>);
+
+    LVD_TEST_REQ_EQ(serialized_size_of(std::vector<uint16_t>{1, 2, 3}), size_t(4 + 3*2));
+    LVD_TEST_REQ_EQ(serialized_size_of(std::string("hippo")), size_t(4 + 5));
+    LVD_TEST_REQ_EQ(serialized_size_of(std::optional<uint64_t>()), size_t(1));
+    LVD_TEST_REQ_EQ(serialized_size_of(std::optional<uint64_t>(3)), size_t(1 + 8));
+    LVD_TEST_REQ_EQ(serialized_size_of(std::map<int,std::string>{{1, "a"}, {2, "bc"}}), size_t(4 + (4+4+1) + (4+4+2)));
+
+    // Serializing directly into a pre-sized buffer, e.g. a network frame.
+    auto value = std::map<std::string,std::vector<float>>{{"x", {1.0f, 2.0f}}, {"yz", {}}};
+    auto frame = std::vector<std::byte>(serialized_size_of(value));
+    std::byte *cursor = frame.data();
+    serialize_from(value, ByteInserter_t(cursor));
+    LVD_TEST_REQ_IS_TRUE(cursor == frame.data() + frame.size());
+    LVD_TEST_REQ_IS_TRUE(frame == serialized_from(value));
+    LVD_TEST_REQ_EQ(deserialized_to<decltype(value)>(lvd::range(frame)), value);
+
+    // Given the end of the buffer, ByteInserter_t won't write past it.
+    {
+        auto short_frame = std::vector<std::byte>(frame.size() - 1);
+        cursor = short_frame.data();
+        test::call_function_and_expect_exception<req::Failure>([&value, &cursor, &short_frame](){
+            serialize_from(value, ByteInserter_t(cursor, short_frame.data() + short_frame.size()));
+        });
+        LVD_TEST_REQ_IS_TRUE(cursor <= short_frame.data() + short_frame.size());
+    }
+
+    // A SerializedSize_t which disagrees with SerializeFrom_t is caught, whether it undercounts or overcounts.
+    test::call_function_and_expect_exception<req::Failure>([](){
+        serialized_from(MiscountedString<-1>{"hippo"});
+    });
+    test::call_function_and_expect_exception<req::Failure>([](){
+        serialized_from(MiscountedString<1>{"hippo"});
+    });
+    test::call_function_and_expect_exception<req::Failure>([](){
+        serialized_from(std::vector<MiscountedString<-1>>(3, MiscountedString<-1>{"hippo"}));
+    });
+LVD_TEST_END
+
+template <typename T_>
+void truncated_input_is_rejected (req::Context &req_context, T_ const &value) {
+    auto buffer = serialized_from(value);
+    // Every proper prefix of the serialized value must be rejected.
+    for (size_t size = 0; size < buffer.size(); ++size) {
+        auto truncated = std::vector<std::byte>(buffer.begin(), buffer.begin()+size);
+        test::call_function_and_expect_exception<req::Failure>([&truncated](){
+            deserialized_to<T_>(lvd::range(truncated));
+        });
+    }
+    LVD_TEST_REQ_EQ(deserialized_to<T_>(lvd::range(buffer)), value);
+}
+
+LVD_TEST_BEGIN(323__serialization__04__validate_once)
+    static_assert(!is_PrevalidatedRange_t<Range_t<std::byte const *>>);
+    static_assert(is_PrevalidatedRange_t<PrevalidatedRange_t<std::byte const *> &>);
+    static_assert(is_Range_t<PrevalidatedRange_t<std::byte const *>>);
+
+    // These have fixed-size elements, so the size is checked once per container (or once per pair).
+    truncated_input_is_rejected(req_context, std::pair<uint16_t,double>{0x1234, 5.5});
+    truncated_input_is_rejected(req_context, std::vector<std::pair<uint32_t,float>>{{1, 2.0f}, {3, 4.0f}, {5, 6.0f}});
+    truncated_input_is_rejected(req_context, std::array<std::pair<int8_t,uint64_t>,3>{{{1, 2}, {3, 4}, {5, 6}}});
+    truncated_input_is_rejected(req_context, std::map<uint32_t,double>{{1, 1.5}, {2, 2.5}});
+    truncated_input_is_rejected(req_context, std::set<std::array<int16_t,3>>{{1, 2, 3}, {4, 5, 6}});
+    // These don't, so the size is checked per value.
+    truncated_input_is_rejected(req_context, std::vector<std::string>{"abc", "", "defgh"});
+    truncated_input_is_rejected(req_context, std::map<std::string,std::pair<int,float>>{{"x", {1, 2.0f}}, {"yz", {3, 4.0f}}});
+
+    // A corrupt size must be rejected before it's used to allocate anything.
+    {
+        auto buffer = std::vector<std::byte>{std::byte{0xFF}, std::byte{0xFF}, std::byte{0xFF}, std::byte{0x7F}, std::byte{0x00}};
+        test::call_function_and_expect_exception<req::Failure>([&buffer](){
+            deserialized_to<std::vector<uint64_t>>(lvd::range(buffer));
+        });
+        test::call_function_and_expect_exception<req::Failure>([&buffer](){
+            deserialized_to<std::vector<std::pair<uint64_t,uint64_t>>>(lvd::range(buffer));
+        });
+        test::call_function_and_expect_exception<req::Failure>([&buffer](){
+            deserialized_to<std::unordered_map<uint32_t,uint32_t>>(lvd::range(buffer));
+        });
+    }
+
+    // The source range must be advanced past the values read, so that reading can continue after them.
+    {
+        auto buffer = serialized_from(std::vector<std::pair<uint8_t,uint16_t>>{{1, 2}, {3, 4}});
+        serialize_from(uint32_t(0xABCDEF01), std::back_inserter(buffer));
+        auto source_range = lvd::range(buffer);
+        auto v = deserialized_to<std::vector<std::pair<uint8_t,uint16_t>>>(std::move(source_range));
+        LVD_TEST_REQ_EQ(v.size(), size_t(2));
+        LVD_TEST_REQ_EQ(deserialized_to<uint32_t>(std::move(source_range)), uint32_t(0xABCDEF01));
+        LVD_TEST_REQ_IS_TRUE(source_range.empty());
+    }
+LVD_TEST_END
+
+LVD_TEST_BEGIN(323__serialization__05__decode_budget)
+    auto value = std::map<std::string,std::vector<uint16_t>>{{"abc", {1, 2}}, {"d", {}}};
+    auto buffer = serialized_from(value);
+    // 2 map elements, plus 3 + 1 chars, plus 2 + 0 uint16_t elements.
+    {
+        DecodeBudget budget(DecodeLimits{});
+        LVD_TEST_REQ_IS_TRUE(deserialized_to<decltype(value)>(lvd::range(buffer)) == value);
+        LVD_TEST_REQ_EQ(budget.element_count(), size_t(8));
+        LVD_TEST_REQ_EQ(budget.total_bytes(), 2*sizeof(std::pair<std::string,std::vector<uint16_t>>) + 4 + 2*sizeof(uint16_t));
+    }
+    {
+        DecodeBudget budget(DecodeLimits{SIZE_MAX, 7, SIZE_MAX});
+        test::call_function_and_expect_exception<std::runtime_error>([&buffer](){
+            deserialized_to<decltype(value)>(lvd::range(buffer));
+        });
+    }
+    {
+        DecodeBudget budget(DecodeLimits{SIZE_MAX, SIZE_MAX, 1});
+        test::call_function_and_expect_exception<std::runtime_error>([&buffer](){
+            deserialized_to<decltype(value)>(lvd::range(buffer));
+        });
+    }
+    // Budgets nest, and the innermost one is charged.
+    {
+        DecodeBudget outer(DecodeLimits{});
+        {
+            DecodeBudget inner(DecodeLimits{});
+            deserialized_to<decltype(value)>(lvd::range(buffer));
+            LVD_TEST_REQ_EQ(inner.element_count(), size_t(8));
+        }
+        LVD_TEST_REQ_EQ(DecodeBudget::current(), &outer);
+        LVD_TEST_REQ_EQ(outer.element_count(), size_t(0));
+    }
+    // The number of elements that can be reserved up front is limited by the remaining input.
+    static_assert(unverified_reserve_count<std::string>(1000, 10) == 10);
+    static_assert(unverified_reserve_count<std::string>(size_t(1) << 40) == MAX_UNVERIFIED_RESERVE_BYTES / sizeof(std::string));
+    static_assert(unverified_reserve_count<uint8_t>(5) == 5);
+LVD_TEST_END
+
+// Deserializes a large associative container, which is inserted with an end hint (for sorted containers) or
+// into pre-sized buckets (for hashed ones).
+template <typename Container_>
+void large_associative_container_test_case (req::Context &req_context, Container_ const &expected) {
+    auto buffer = serialized_from(expected);
+    auto actual = deserialized_to<Container_>(lvd::range(buffer));
+    LVD_TEST_REQ_IS_TRUE(actual == expected);
+}
+
+LVD_TEST_BEGIN(323__serialization__06__large_associative)
+    size_t constexpr SIZE = 10000;
+    auto rng = std::mt19937{42};
+    std::map<uint32_t,uint32_t> m;
+    std::unordered_map<uint32_t,uint32_t> um;
+    std::set<uint64_t> s;
+    std::unordered_set<uint64_t> us;
+    while (m.size() < SIZE) {
+        auto key = make_random<uint32_t>(rng);
+        m.emplace(key, ~key);
+        um.emplace(key, ~key);
+        s.emplace(uint64_t(key) << 16);
+        us.emplace(uint64_t(key) << 16);
+    }
+    large_associative_container_test_case(req_context, m);
+    large_associative_container_test_case(req_context, um);
+    large_associative_container_test_case(req_context, s);
+    large_associative_container_test_case(req_context, us);
+
+    // Out-of-order input (which ordered containers never produce, but which corrupt input could) must still
+    // produce a correctly ordered container.
+    {
+        std::vector<std::pair<uint32_t,uint32_t>> elements{{5, 0}, {1, 1}, {9, 2}, {1, 3}, {3, 4}};
+        auto buffer = serialized_from(elements);
+        auto actual = deserialized_to<std::map<uint32_t,uint32_t>>(lvd::range(buffer));
+        LVD_TEST_REQ_IS_TRUE((actual == std::map<uint32_t,uint32_t>{{1, 1}, {3, 4}, {5, 0}, {9, 2}}));
+    }
+LVD_TEST_END
+
+LVD_TEST_BEGIN(323__serialization__07__vector_bool)
+    std::vector<std::byte> buffer;
+    serialization_test_case<std::vector<bool>>(req_context, buffer);
+    serialization_test_case<std::vector<std::vector<bool>>>(req_context, buffer);
+
+    // The bools are bit-packed, least significant bit first.
+    {
+        auto v = std::vector<bool>{true, false, false, true, true, true, false, true, false, true};
+        buffer = serialized_from(v);
+        LVD_TEST_REQ_EQ(buffer.size(), sizeof(uint32_t) + 2);
+        LVD_TEST_REQ_EQ(uint8_t(buffer[4]), uint8_t(0xB9));
+        LVD_TEST_REQ_EQ(uint8_t(buffer[5]), uint8_t(0x02));
+        LVD_TEST_REQ_IS_TRUE(deserialized_to<std::vector<bool>>(lvd::range(buffer)) == v);
+    }
+    {
+        auto v = std::vector<bool>(1000000);
+        for (size_t i = 0; i < v.size(); i += 3)
+            v[i] = true;
+        buffer = serialized_from(v);
+        LVD_TEST_REQ_EQ(buffer.size(), sizeof(uint32_t) + v.size()/8);
+        LVD_TEST_REQ_IS_TRUE(deserialized_to<std::vector<bool>>(lvd::range(buffer)) == v);
+    }
+    truncated_input_is_rejected(req_context, std::vector<bool>{true, false, true, true, false, false, true, false, true});
+LVD_TEST_END
+
+LVD_TEST_BEGIN(323__serialization__08__fixed_layout)
+    static_assert(is_fixed_layout_serializable_v<uint32_t>);
+    static_assert(is_fixed_layout_serializable_v<std::pair<int32_t,float>>);
+    static_assert(is_fixed_layout_serializable_v<std::array<std::pair<int32_t,float>,4>>);
+    static_assert(is_fixed_layout_serializable_v<std::pair<std::array<uint16_t,3>,std::pair<uint8_t,std::byte>>>);
+    // Padding, non-arithmetic leaves, and std::tuple (whose in-memory element order is unspecified) are excluded.
+    static_assert(!is_fixed_layout_serializable_v<std::pair<uint8_t,uint32_t>>);
+    static_assert(!is_fixed_layout_serializable_v<std::pair<int32_t,std::string>>);
+    static_assert(!is_fixed_layout_serializable_v<std::pair<int32_t const,float>>);
+    static_assert(!is_fixed_layout_serializable_v<std::tuple<uint32_t,uint32_t>>);
+
+    // The block-serialized form is the same as the field-by-field form.
+    std::vector<std::pair<int32_t,float>> pairs(1000);
+    for (size_t i = 0; i < pairs.size(); ++i)
+        pairs[i] = {int32_t(i*i) - 1000, float(i) / 8.0f};
+    std::vector<std::byte> expected;
+    serialize_from<uint32_t>(pairs.size(), std::back_inserter(expected));
+    for (auto const &pair : pairs) {
+        serialize_from(pair.first, std::back_inserter(expected));
+        serialize_from(pair.second, std::back_inserter(expected));
+    }
+    LVD_TEST_REQ_IS_TRUE(serialized_from(pairs) == expected);
+    LVD_TEST_REQ_IS_TRUE(deserialized_to<decltype(pairs)>(lvd::range(expected)) == pairs);
+    LVD_TEST_REQ_IS_TRUE(serialized_from(pairs[5]) == std::vector<std::byte>(expected.begin()+4+5*8, expected.begin()+4+6*8));
+
+    std::vector<std::byte> buffer;
+    serialization_test_case<std::pair<uint16_t,uint16_t>>(req_context, buffer);
+    serialization_test_case<std::array<std::pair<int32_t,float>,5>>(req_context, buffer);
+    serialization_test_case<std::vector<std::array<double,3>>>(req_context, buffer);
+    serialization_test_case<std::vector<std::pair<std::pair<uint8_t,int8_t>,int16_t>>>(req_context, buffer);
+    truncated_input_is_rejected(req_context, std::pair<int32_t,float>{-3, 0.5f});
+    truncated_input_is_rejected(req_context, std::vector<std::array<uint16_t,3>>{{1, 2, 3}, {4, 5, 6}});
+
+    // Elements bigger than the chunk that's byte-swapped at a time (on big-endian machines).
+    std::vector<std::array<uint32_t,2048>> wide(2);
+    wide[1].fill(0x01020304);
+    LVD_TEST_REQ_IS_TRUE(deserialized_to<decltype(wide)>(lvd::range(serialized_from(wide))) == wide);
+LVD_TEST_END
+
 //
 // Test a bunch of different ways to inherit a serializable class, where the Serialization_t
 // implementation can be inherited also.
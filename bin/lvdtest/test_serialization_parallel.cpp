@@ -0,0 +1,195 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#include <atomic>
+#include "lvd/DecodeBudget.hpp"
+#include "lvd/parallel.hpp"
+#include "lvd/random.hpp"
+#include "lvd/random_pair.hpp"
+#include "lvd/random_string.hpp"
+#include "lvd/req.hpp"
+#include "lvd/serialization.hpp"
+#include "lvd/serialization_parallel.hpp"
+#include "lvd/test.hpp"
+#include <map>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace lvd {
+
+namespace {
+
+// Round-trips source for various chunk sizes and thread counts.
+template <typename Container_>
+void parallel_round_trip_test_case (req::Context &req_context, Container_ const &source) {
+    for (size_t chunk_size : {size_t(1), size_t(7), size_t(64), DEFAULT_PARALLEL_CHUNK_SIZE}) {
+        for (size_t thread_count : {size_t(1), size_t(3), size_t(0)}) {
+            auto options = ParallelSerializationOptions{chunk_size, thread_count};
+            auto buffer = serialized_from_parallel(source, options);
+            // Both ways of serializing must produce the same bytes.
+            std::vector<std::byte> expected_buffer;
+            serialize_from_parallel(source, std::back_inserter(expected_buffer), options);
+            LVD_TEST_REQ_IS_TRUE(buffer == expected_buffer);
+            auto chunk_count = (source.size() + chunk_size - 1) / chunk_size;
+            LVD_TEST_REQ_EQ(deserialized_to<uint64_t>(lvd::range(buffer)), uint64_t(source.size()));
+            LVD_TEST_REQ_GEQ(buffer.size(), (2 + chunk_count)*sizeof(uint64_t));
+
+            Container_ actual;
+            auto source_range = lvd::range(buffer);
+            deserialize_to_parallel(actual, std::move(source_range), thread_count);
+            LVD_TEST_REQ_IS_TRUE(source_range.empty());
+            LVD_TEST_REQ_IS_TRUE(actual == source);
+        }
+    }
+}
+
+template <typename T_, typename Rng_>
+std::vector<T_> make_random_vector (Rng_ &rng, size_t size) {
+    std::vector<T_> retval(size);
+    for (auto &element : retval)
+        populate_random(element, rng);
+    return retval;
+}
+
+} // end of anonymous namespace
+
+// A string whose SerializedSize_t is off by SIZE_ERROR_, i.e. which disagrees with its SerializeFrom_t.
+template <int SIZE_ERROR_>
+struct MiscountedParallelString {
+    std::string value;
+};
+
+template <int SIZE_ERROR_>
+struct SerializeFrom_t<MiscountedParallelString<SIZE_ERROR_>> {
+    template <typename DestIterator_>
+    void operator() (MiscountedParallelString<SIZE_ERROR_> const &source, DestIterator_ dest) const {
+        serialize_from(source.value, dest);
+    }
+};
+
+template <int SIZE_ERROR_>
+struct SerializedSize_t<MiscountedParallelString<SIZE_ERROR_>> : public SerializedSize_VariableSize_t {
+    size_t operator() (MiscountedParallelString<SIZE_ERROR_> const &source) const {
+        return size_t(int(serialized_size_of(source.value)) + SIZE_ERROR_);
+    }
+};
+
+LVD_TEST_BEGIN(324__serialization_parallel__00__run_in_parallel)
+    for (size_t thread_count : {size_t(0), size_t(1), size_t(4), size_t(100)}) {
+        std::vector<std::atomic<size_t>> counts(1000);
+        run_in_parallel(counts.size(), thread_count, [&counts](size_t i){ ++counts[i]; });
+        for (auto const &count : counts)
+            LVD_TEST_REQ_EQ(count.load(), size_t(1));
+    }
+    run_in_parallel(0, 4, [](size_t){ throw std::logic_error("there are no tasks"); });
+    // The first exception is rethrown on the calling thread, after the other threads are done.
+    test::call_function_and_expect_exception<std::runtime_error>([](){
+        run_in_parallel(100, 4, [](size_t i){
+            if (i % 10 == 3)
+                throw std::runtime_error("task failed");
+        });
+    });
+LVD_TEST_END
+
+// 324 must be >= 323 (which is serialization), since serialization_parallel.hpp depends on it.
+LVD_TEST_BEGIN(324__serialization_parallel__01__round_trip)
+    auto rng = std::mt19937{42};
+    for (size_t size : {size_t(0), size_t(1), size_t(6), size_t(7), size_t(8), size_t(1000)}) {
+        req_context.log() << Log::trc() << "size: " << size << '\n';
+        parallel_round_trip_test_case(req_context, make_random_vector<uint64_t>(rng, size));
+        parallel_round_trip_test_case(req_context, make_random_vector<std::pair<uint64_t,double>>(rng, size));
+        parallel_round_trip_test_case(req_context, make_random_vector<std::string>(rng, size));
+        auto chars = make_random_vector<char>(rng, size);
+        parallel_round_trip_test_case(req_context, std::string(chars.begin(), chars.end()));
+
+        std::map<uint32_t,std::string> m;
+        std::unordered_map<uint64_t,std::vector<int16_t>> um;
+        std::set<std::string> s;
+        while (m.size() < size) {
+            auto key = make_random<uint32_t>(rng);
+            m.emplace(key, std::string(key % 5, 'x'));
+            um.emplace(key, std::vector<int16_t>(key % 3, int16_t(key)));
+            s.emplace(std::to_string(key));
+        }
+        parallel_round_trip_test_case(req_context, m);
+        parallel_round_trip_test_case(req_context, um);
+        parallel_round_trip_test_case(req_context, s);
+    }
+LVD_TEST_END
+
+LVD_TEST_BEGIN(324__serialization_parallel__02__corrupt)
+    auto value = std::vector<std::string>{"a", "bc", "", "def", "g", "hijk", "l"};
+    auto options = ParallelSerializationOptions{3, 2};
+    auto buffer = serialized_from_parallel(value, options);
+    // 3 chunks, having 3, 3, and 1 elements, so the chunk table is 3 uint64_t values after size and chunk_size.
+    auto chunk_table = buffer.data() + 2*sizeof(uint64_t);
+    auto payload_size = deserialized_to<uint64_t>(lvd::range(chunk_table + 2*sizeof(uint64_t), buffer.data() + buffer.size()));
+    LVD_TEST_REQ_EQ(buffer.size(), 5*sizeof(uint64_t) + payload_size);
+
+    auto expect_failure = [](std::vector<std::byte> const &corrupted, size_t thread_count){
+        test::call_function_and_expect_exception<req::Failure>([&corrupted, thread_count](){
+            std::vector<std::string> actual;
+            deserialize_to_parallel(actual, lvd::range(corrupted), thread_count);
+        });
+    };
+    // Truncation anywhere must be detected.
+    for (size_t size = 0; size < buffer.size(); ++size)
+        expect_failure(std::vector<std::byte>(buffer.begin(), buffer.begin()+size), 2);
+    // A chunk boundary that isn't between elements must be detected, whichever chunk is read first.
+    for (size_t thread_count : {size_t(1), size_t(3)}) {
+        auto corrupted = buffer;
+        corrupted[0*sizeof(uint64_t) + 2*sizeof(uint64_t)] = std::byte(uint8_t(corrupted[2*sizeof(uint64_t)]) + 1);
+        expect_failure(corrupted, thread_count);
+        // Decreasing chunk ends.
+        corrupted = buffer;
+        std::swap(corrupted[2*sizeof(uint64_t)], corrupted[3*sizeof(uint64_t)]);
+        expect_failure(corrupted, thread_count);
+        // A chunk_size that doesn't match the chunks.
+        corrupted = buffer;
+        corrupted[sizeof(uint64_t)] = std::byte{2};
+        expect_failure(corrupted, thread_count);
+        // A size that's inconsistent with the chunks.
+        corrupted = buffer;
+        corrupted[0] = std::byte{8};
+        expect_failure(corrupted, thread_count);
+    }
+    // Elements of a fixed size have to account for the whole payload exactly, before anything is allocated.
+    {
+        auto corrupted = serialized_from_parallel(std::vector<uint32_t>(10, 0), options);
+        corrupted[3] = std::byte{0x01};
+        expect_failure(corrupted, 1);
+    }
+
+    // With a DecodeBudget, everything is decoded on the calling thread, so that the whole value is charged to it.
+    {
+        DecodeBudget budget(DecodeLimits{});
+        std::vector<std::string> actual;
+        deserialize_to_parallel(actual, lvd::range(buffer), 4);
+        LVD_TEST_REQ_IS_TRUE(actual == value);
+        LVD_TEST_REQ_EQ(budget.element_count(), value.size() + 12);
+    }
+LVD_TEST_END
+
+// A SerializedSize_t that disagrees with SerializeFrom_t must be detected in each chunk, and an undercount must not
+// let a chunk overrun into the next one.
+LVD_TEST_BEGIN(324__serialization_parallel__03__miscounted_size)
+    for (size_t thread_count : {size_t(1), size_t(3)}) {
+        auto options = ParallelSerializationOptions{2, thread_count};
+        test::call_function_and_expect_exception<req::Failure>([&options](){
+            serialized_from_parallel(std::vector<MiscountedParallelString<-1>>(5, {"hippo"}), options);
+        });
+        test::call_function_and_expect_exception<req::Failure>([&options](){
+            serialized_from_parallel(std::vector<MiscountedParallelString<1>>(5, {"hippo"}), options);
+        });
+        test::call_function_and_expect_exception<req::Failure>([&options](){
+            std::vector<std::byte> buffer;
+            serialize_from_parallel(std::vector<MiscountedParallelString<-1>>(5, {"hippo"}), std::back_inserter(buffer), options);
+        });
+    }
+LVD_TEST_END
+
+} // end namespace lvd
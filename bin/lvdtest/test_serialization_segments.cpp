@@ -0,0 +1,131 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#include <array>
+#include <cstdio>
+#include <map>
+#include <optional>
+#include "lvd/req.hpp"
+#include "lvd/serialization.hpp"
+#include "lvd/serialization_segments.hpp"
+#include "lvd/test.hpp"
+#include <string>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace lvd {
+
+namespace {
+
+template <typename T_>
+void test_scatter (req::Context &req_context, T_ const &source) {
+    auto expected = serialized_from(source);
+    for (size_t reference_threshold : {size_t(1), size_t(16), DEFAULT_SEGMENT_REFERENCE_THRESHOLD, ~size_t(0)}) {
+        auto segments = serialized_segments_from(source, reference_threshold);
+        LVD_TEST_REQ_EQ(segments.size(), expected.size());
+        LVD_TEST_REQ_IS_TRUE(segments.joined() == expected);
+        size_t iovec_size = 0;
+        for (auto const &segment : segments.iovecs())
+            iovec_size += segment.iov_len;
+        LVD_TEST_REQ_EQ(iovec_size, expected.size());
+        for (auto const &reference : segments.references())
+            LVD_TEST_REQ_GEQ(reference.size, reference_threshold);
+    }
+}
+
+// Owns a temporary file, which is removed upon destruction.
+struct TemporaryFile {
+    std::FILE *file;
+    TemporaryFile () : file(std::tmpfile()) { }
+    ~TemporaryFile () { std::fclose(file); }
+    int fd () const { return ::fileno(file); }
+};
+
+using Message = std::pair<uint64_t,std::vector<std::vector<double>>>;
+
+Message make_message (uint64_t id, std::vector<size_t> const &sizes) {
+    Message message{id, {}};
+    for (auto size : sizes) {
+        message.second.emplace_back(size);
+        for (size_t i = 0; i < size; ++i)
+            message.second.back()[i] = double(id) + 0.5*double(i);
+    }
+    return message;
+}
+
+} // end of anonymous namespace
+
+// 324 must be >= 323 (which is serialization), since serialization_segments.hpp depends on it.
+LVD_TEST_BEGIN(324__serialization_segments__00__scatter)
+    std::vector<uint64_t> big_vector(10000);
+    for (size_t i = 0; i < big_vector.size(); ++i)
+        big_vector[i] = i*i;
+    std::string big_string(5000, 'x');
+
+    test_scatter(req_context, big_vector);
+    test_scatter(req_context, big_string);
+    test_scatter(req_context, std::vector<uint8_t>{});
+    test_scatter(req_context, std::make_pair(big_string, std::vector<double>(3000, 1.5)));
+    test_scatter(req_context, make_message(7, {0, 1, 1000, 2, 5000}));
+    test_scatter(req_context, std::map<int,std::vector<uint8_t>>{{1, std::vector<uint8_t>(10000, 1)}, {2, {3, 4}}});
+    test_scatter(req_context, std::optional<std::vector<int32_t>>(std::vector<int32_t>(2000, -1)));
+    test_scatter(req_context, std::vector<bool>(1000, true));
+    test_scatter(req_context, std::array<uint16_t,3000>{});
+
+    // Big blocks are referred to in place, rather than copied, if the machine is little-endian.
+    auto segments = serialized_segments_from(big_vector);
+    if (machine_endianness() == Endianness::LIL) {
+        LVD_TEST_REQ_EQ(segments.references().size(), size_t(1));
+        LVD_TEST_REQ_EQ(segments.references()[0].data, reinterpret_cast<std::byte const *>(big_vector.data()));
+        LVD_TEST_REQ_EQ(segments.arena().size(), sizeof(uint32_t));
+        LVD_TEST_REQ_EQ(segments.iovecs().size(), size_t(2));
+    }
+LVD_TEST_END
+
+LVD_TEST_BEGIN(324__serialization_segments__01__gather)
+    TemporaryFile file;
+    auto sizes = std::vector<size_t>{0, 1, 1000, 2, 5000};
+    auto source = make_message(7, sizes);
+    auto source_segments = serialized_segments_from(source);
+    write_segments(file.fd(), source_segments.iovecs());
+    // A second copy, after the first.
+    auto offset = off_t(source_segments.size() + 123);
+    pwrite_segments(file.fd(), serialized_segments_from(source).iovecs(), offset);
+
+    for (bool positioned : {false, true}) {
+        // The destination has the source's shape (but not its contents).
+        auto dest = make_message(0, sizes);
+        std::vector<double const *> element_data;
+        for (auto const &element : dest.second)
+            element_data.push_back(element.data());
+
+        auto segments = gather_segments_for(dest);
+        if (positioned) {
+            pread_segments(file.fd(), segments.iovecs(), offset);
+        } else {
+            LVD_TEST_REQ_EQ(::lseek(file.fd(), 0, SEEK_SET), off_t(0));
+            read_segments(file.fd(), segments.iovecs());
+        }
+        deserialize_gathered(dest, segments);
+        LVD_TEST_REQ_IS_TRUE(dest == source);
+        // The big blocks were read in place.
+        for (size_t i = 0; i < dest.second.size(); ++i)
+            LVD_TEST_REQ_EQ(dest.second[i].data(), element_data[i]);
+    }
+
+    // A destination without the source's shape is rejected.
+    test::call_function_and_expect_exception<std::runtime_error>([&file](){
+        auto dest = make_message(0, {0, 1, 500, 2, 5000});
+        auto segments = gather_segments_for(dest);
+        pread_segments(file.fd(), segments.iovecs(), 0);
+        deserialize_gathered(dest, segments);
+    });
+
+    // Reading past the end of the file is an error.
+    test::call_function_and_expect_exception<std::runtime_error>([&file, offset](){
+        auto dest = make_message(0, {0, 1, 1000, 2, 6000});
+        pread_segments(file.fd(), gather_segments_for(dest).iovecs(), offset);
+    });
+LVD_TEST_END
+
+} // end namespace lvd
@@ -0,0 +1,110 @@
+// 2021.01.04 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#include "lvd/Range_t.hpp"
+#include "lvd/req.hpp"
+#include "lvd/serialization.hpp"
+#include "lvd/serialization_view.hpp"
+#include "lvd/test.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace lvd {
+
+// Returns true iff p points into buffer.
+template <typename T_>
+bool points_into (T_ const *p, std::vector<std::byte> const &buffer) {
+    auto b = reinterpret_cast<std::byte const *>(p);
+    return buffer.data() <= b && b < buffer.data() + buffer.size();
+}
+
+// 324 must be >= 323 (which is serialization), since serialization_view.hpp depends on it.
+LVD_TEST_BEGIN(324__serialization_view__00__string_view)
+    auto buffer = serialized_from(std::string("hippo"));
+    serialize_from(std::string(""), std::back_inserter(buffer));
+    serialize_from(std::string("ostrich"), std::back_inserter(buffer));
+
+    auto source_range = lvd::range(buffer);
+    auto s0 = deserialized_view_of<std::string>(std::move(source_range));
+    auto s1 = deserialized_view_of<std::string>(std::move(source_range));
+    auto s2 = deserialized_view_of<std::string>(std::move(source_range));
+    LVD_TEST_REQ_IS_TRUE(source_range.empty());
+
+    LVD_TEST_REQ_EQ(s0, std::string_view("hippo"));
+    LVD_TEST_REQ_EQ(s1, std::string_view(""));
+    LVD_TEST_REQ_EQ(s2, std::string_view("ostrich"));
+    // The views must refer into the source buffer, not a copy.
+    LVD_TEST_REQ_IS_TRUE(points_into(s0.data(), buffer));
+    LVD_TEST_REQ_IS_TRUE(points_into(s2.data(), buffer));
+
+    // Truncated input must be rejected.
+    buffer.pop_back();
+    test::call_function_and_expect_exception<req::Failure>([&buffer](){
+        auto source_range = lvd::range(buffer);
+        deserialized_view_of<std::string>(std::move(source_range));
+        deserialized_view_of<std::string>(std::move(source_range));
+        deserialized_view_of<std::string>(std::move(source_range));
+    });
+LVD_TEST_END
+
+LVD_TEST_BEGIN(324__serialization_view__01__vector)
+    // uint32_t elements follow the 4-byte size, so they're aligned within the (suitably aligned) buffer, and
+    // can be viewed in-place on a little-endian machine.
+    {
+        auto expected = std::vector<uint32_t>{10, 20, 30, 0xDEADBEEF};
+        auto buffer = serialized_from(expected);
+        auto view = deserialized_view_of<std::vector<uint32_t>>(lvd::range(buffer));
+        LVD_TEST_REQ_EQ(view.size(), expected.size());
+        LVD_TEST_REQ_IS_TRUE(view.to_vector() == expected);
+        LVD_TEST_REQ_EQ(view.is_zero_copy(), machine_endianness() == Endianness::LIL);
+        LVD_TEST_REQ_EQ(points_into(view.data(), buffer), view.is_zero_copy());
+    }
+
+    // Byte elements can always be viewed in-place.
+    {
+        auto expected = std::vector<std::byte>{std::byte{1}, std::byte{2}, std::byte{3}};
+        auto buffer = serialized_from(expected);
+        auto view = deserialized_view_of<std::vector<std::byte>>(Range_t<std::byte const *>(buffer.data(), buffer.data()+buffer.size()));
+        LVD_TEST_REQ_IS_TRUE(view.is_zero_copy());
+        LVD_TEST_REQ_IS_TRUE(points_into(view.data(), buffer));
+        LVD_TEST_REQ_IS_TRUE(view.to_vector() == expected);
+    }
+
+    // double elements following the 4-byte size are misaligned, so they have to be copied.
+    {
+        auto expected = std::vector<double>{1.5, -2.25, 1e300};
+        auto buffer = serialized_from(expected);
+        auto view = deserialized_view_of<std::vector<double>>(lvd::range(buffer));
+        LVD_TEST_REQ_IS_TRUE(!view.is_zero_copy());
+        LVD_TEST_REQ_IS_TRUE(!points_into(view.data(), buffer));
+        LVD_TEST_REQ_IS_TRUE(view.to_vector() == expected);
+        // Moving the view must keep it valid.
+        auto moved_view = std::move(view);
+        LVD_TEST_REQ_EQ(moved_view[2], 1e300);
+    }
+
+    // Empty
+    {
+        auto buffer = serialized_from(std::vector<int16_t>{});
+        auto view = deserialized_view_of<std::vector<int16_t>>(lvd::range(buffer));
+        LVD_TEST_REQ_IS_TRUE(view.empty());
+        LVD_TEST_REQ_EQ(view.is_zero_copy(), machine_endianness() == Endianness::LIL);
+    }
+    // An empty copy (e.g. of an empty vector on a big-endian machine) is still a copy.
+    {
+        auto view = SequenceView_t<double>(std::vector<double>{});
+        LVD_TEST_REQ_IS_TRUE(view.empty());
+        LVD_TEST_REQ_IS_TRUE(!view.is_zero_copy());
+    }
+
+    // Truncated input must be rejected.
+    {
+        auto buffer = serialized_from(std::vector<uint32_t>{1, 2, 3});
+        buffer.pop_back();
+        test::call_function_and_expect_exception<req::Failure>([&buffer](){
+            deserialized_view_of<std::vector<uint32_t>>(lvd::range(buffer));
+        });
+    }
+LVD_TEST_END
+
+} // end namespace lvd
@@ -1,8 +1,11 @@
 // 2021.01.10 - Copyright Victor Dods - Licensed under Apache 2.0
 
+#include "lvd/Log.hpp"
 #include "lvd/req.hpp"
 #include "lvd/test.hpp"
 #include "lvd/variant.hpp"
+#include <random>
+#include <vector>
 
 LVD_TEST_BEGIN(020__variant__00)
     LVD_TEST_REQ_EQ(std::variant_npos, size_t(-1));
@@ -299,3 +302,43 @@ LVD_TEST_BEGIN(020__variant__03)
     LVD_TEST_REQ_EQ(result, "float");
 LVD_TEST_END
 
+
+// Dispatches on each of indices over the types std::integral_constant<size_t,0>, ..., and checks the sum of their values.
+template <size_t... INDICES_>
+void call_on_indexed_type_test_case (lvd::req::Context &req_context, std::vector<size_t> const &indices, std::index_sequence<INDICES_...>) {
+    size_t constexpr TYPE_COUNT = sizeof...(INDICES_);
+    size_t expected_sum = 0;
+    for (auto index : indices)
+        expected_sum += index % TYPE_COUNT;
+
+    size_t sum = 0;
+    for (auto index : indices) {
+        lvd::call_on_indexed_type<0,std::integral_constant<size_t,INDICES_>...>(index % TYPE_COUNT, [&sum](auto &&t){
+            static_assert(lvd::is_Type_t_v<std::decay_t<decltype(t)>>);
+            sum += std::decay_t<decltype(t)>::T::value;
+        });
+    }
+    LVD_TEST_REQ_EQ(sum, expected_sum);
+
+    lvd::test::call_function_and_expect_exception<std::runtime_error>([](){
+        lvd::call_on_indexed_type<0,std::integral_constant<size_t,INDICES_>...>(TYPE_COUNT, [](auto &&){ });
+    });
+}
+
+LVD_TEST_BEGIN(020__variant__04__call_on_indexed_type)
+    auto rng = std::mt19937{42};
+    std::vector<size_t> indices(1000);
+    for (auto &index : indices)
+        index = std::uniform_int_distribution<size_t>()(rng);
+
+    call_on_indexed_type_test_case(req_context, indices, std::make_index_sequence<1>());
+    call_on_indexed_type_test_case(req_context, indices, std::make_index_sequence<4>());
+    call_on_indexed_type_test_case(req_context, indices, std::make_index_sequence<16>());
+    call_on_indexed_type_test_case(req_context, indices, std::make_index_sequence<40>());
+    call_on_indexed_type_test_case(req_context, indices, std::make_index_sequence<100>());
+
+    // Indices below TRY_INDEX_ are rejected.
+    lvd::test::call_function_and_expect_exception<std::runtime_error>([](){
+        lvd::call_on_indexed_type<1,int,float>(0, [](auto &&){ });
+    });
+LVD_TEST_END
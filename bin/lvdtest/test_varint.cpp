@@ -0,0 +1,128 @@
+// 2021.01.04 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#include "lvd/random.hpp"
+#include "lvd/random_map.hpp"
+#include "lvd/random_optional.hpp"
+#include "lvd/random_pair.hpp"
+#include "lvd/random_string.hpp"
+#include "lvd/random_vector.hpp"
+#include "lvd/Range_t.hpp"
+#include "lvd/req.hpp"
+#include "lvd/serialization_varint.hpp"
+#include "lvd/test.hpp"
+#include "lvd/varint.hpp"
+#include "print.hpp"
+#include <random>
+#include <vector>
+
+namespace lvd {
+
+LVD_TEST_BEGIN(322__varint__00__codec)
+    static_assert(zigzag_encoded(0) == 0);
+    static_assert(zigzag_encoded(-1) == 1);
+    static_assert(zigzag_encoded(1) == 2);
+    static_assert(zigzag_encoded(-2) == 3);
+    static_assert(zigzag_encoded(std::numeric_limits<int64_t>::max()) == std::numeric_limits<uint64_t>::max()-1);
+    static_assert(zigzag_encoded(std::numeric_limits<int64_t>::min()) == std::numeric_limits<uint64_t>::max());
+    static_assert(varint_size_of(0) == 1);
+    static_assert(varint_size_of(127) == 1);
+    static_assert(varint_size_of(128) == 2);
+    static_assert(varint_size_of(std::numeric_limits<uint64_t>::max()) == MAX_VARINT_SIZE);
+
+    // Round-trip values of every encoded length, both with enough trailing bytes for the multi-byte
+    // fast path of decode_varint, and without.
+    auto rng = std::mt19937{42};
+    for (size_t bits = 0; bits <= 64; ++bits) {
+        for (int i = 0; i < 100; ++i) {
+            uint64_t x = bits == 0 ? 0 : make_random<uint64_t>(rng) >> (64 - bits);
+            for (size_t padding : {size_t(0), size_t(8)}) {
+                std::vector<std::byte> buffer(MAX_VARINT_SIZE + padding, std::byte{0xFF});
+                auto size = encode_varint(x, buffer.data());
+                LVD_TEST_REQ_EQ(size, varint_size_of(x));
+                buffer.resize(size + padding, std::byte{0xFF});
+
+                uint64_t decoded = 0;
+                LVD_TEST_REQ_EQ(decode_varint(buffer.data(), buffer.data()+buffer.size(), decoded), size);
+                LVD_TEST_REQ_EQ(decoded, x);
+                // Every truncation must be rejected.
+                for (size_t truncated_size = 0; truncated_size < size; ++truncated_size)
+                    LVD_TEST_REQ_EQ(decode_varint(buffer.data(), buffer.data()+truncated_size, decoded), size_t(0));
+            }
+        }
+    }
+
+    // Overflowing uint64_t must be rejected.
+    {
+        std::vector<std::byte> buffer(MAX_VARINT_SIZE, std::byte{0xFF});
+        buffer.back() = std::byte{0x02};
+        uint64_t decoded = 0;
+        LVD_TEST_REQ_EQ(decode_varint(buffer.data(), buffer.data()+buffer.size(), decoded), size_t(0));
+        buffer.push_back(std::byte{0x00});
+        buffer[MAX_VARINT_SIZE-1] = std::byte{0x80};
+        LVD_TEST_REQ_EQ(decode_varint(buffer.data(), buffer.data()+buffer.size(), decoded), size_t(0));
+    }
+LVD_TEST_END
+
+template <typename T_>
+void varint_serialization_test_case (req::Context &req_context) {
+    auto rng = std::mt19937{42};
+    for (auto i = 0; i < 0x100; ++i) {
+        auto expected = make_random<T_>(rng);
+        auto buffer = serialized_from_varint(expected);
+        LVD_TEST_REQ_EQ(deserialized_to_varint<T_>(lvd::range(buffer)), expected);
+        // Also test a non-contiguous source.
+        auto source = std::vector<std::byte>(buffer.begin(), buffer.end());
+        auto source_range = Range_t<std::reverse_iterator<std::vector<std::byte>::reverse_iterator>>(std::make_reverse_iterator(source.rend()), std::make_reverse_iterator(source.rbegin()));
+        LVD_TEST_REQ_EQ(deserialized_to_varint<T_>(std::move(source_range)), expected);
+    }
+}
+
+// 324 must be >= 323 (which is serialization), since serialization_varint.hpp depends on it.
+LVD_TEST_BEGIN(324__serialization_varint__00)
+    varint_serialization_test_case<bool>(req_context);
+    varint_serialization_test_case<int8_t>(req_context);
+    varint_serialization_test_case<int16_t>(req_context);
+    varint_serialization_test_case<uint16_t>(req_context);
+    varint_serialization_test_case<int32_t>(req_context);
+    varint_serialization_test_case<uint32_t>(req_context);
+    varint_serialization_test_case<int64_t>(req_context);
+    varint_serialization_test_case<uint64_t>(req_context);
+    varint_serialization_test_case<float>(req_context);
+    varint_serialization_test_case<std::string>(req_context);
+    varint_serialization_test_case<std::vector<int32_t>>(req_context);
+    varint_serialization_test_case<std::vector<double>>(req_context);
+    varint_serialization_test_case<std::pair<int16_t,std::string>>(req_context);
+    varint_serialization_test_case<std::optional<uint64_t>>(req_context);
+    varint_serialization_test_case<std::map<uint32_t,std::vector<int64_t>>>(req_context);
+LVD_TEST_END
+
+LVD_TEST_BEGIN(324__serialization_varint__01__compact)
+    // Small sizes and integers take a single byte each.
+    LVD_TEST_REQ_EQ(serialized_from_varint(std::vector<int32_t>{0, -1, 1, 63, -64}).size(), size_t(1 + 5));
+    LVD_TEST_REQ_EQ(serialized_from(std::vector<int32_t>{0, -1, 1, 63, -64}).size(), size_t(4 + 5*4));
+    LVD_TEST_REQ_EQ(serialized_from_varint(std::string("hippo")).size(), size_t(1 + 5));
+    LVD_TEST_REQ_EQ(serialized_from_varint(std::map<uint16_t,uint64_t>{{1, 2}, {3, 300}}).size(), size_t(1 + 2 + 3));
+    LVD_TEST_REQ_IS_TRUE(serialized_from_varint(uint16_t(300)) == (std::vector<std::byte>{std::byte{0xAC}, std::byte{0x02}}));
+
+    // A value out of range of the dest type must be rejected.
+    {
+        auto buffer = serialized_from_varint(uint32_t(70000));
+        test::call_function_and_expect_exception<req::Failure>([&buffer](){
+            deserialized_to_varint<uint16_t>(lvd::range(buffer));
+        });
+    }
+    // Truncated input and corrupt sizes must be rejected.
+    {
+        auto buffer = serialized_from_varint(std::vector<uint64_t>{1000, 2000, 3000});
+        buffer.pop_back();
+        test::call_function_and_expect_exception<req::Failure>([&buffer](){
+            deserialized_to_varint<std::vector<uint64_t>>(lvd::range(buffer));
+        });
+        buffer = serialized_from_varint(uint64_t(1) << 40);
+        test::call_function_and_expect_exception<req::Failure>([&buffer](){
+            deserialized_to_varint<std::vector<uint8_t>>(lvd::range(buffer));
+        });
+    }
+LVD_TEST_END
+
+} // end namespace lvd
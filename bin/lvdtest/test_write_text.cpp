@@ -16,7 +16,10 @@
 #include "lvd/write_text_unordered_set.hpp"
 #include "lvd/write_text_vector.hpp"
 #include "lvd/type.hpp"
+#include <iomanip>
+#include <limits>
 #include "print.hpp"
+#include <random>
 #include <sstream>
 #include <string>
 
@@ -92,4 +95,69 @@ LVD_TEST_BEGIN(232__write_text__01__lit)
     lit_test_case(req_context, std::set<char>{'h', 'i', 'p', 'p', 'o'}, "set<char>('h', 'i', 'o', 'p')");
 LVD_TEST_END
 
+// This is how text-encoded values were formatted before std::to_chars was used.
+template <typename T_>
+std::string stream_formatted (T_ value) {
+    std::ostringstream out;
+    if constexpr (std::is_floating_point_v<T_>)
+        out << std::scientific << std::setprecision(std::numeric_limits<T_>::max_digits10) << value;
+    else
+        out << value;
+    return out.str();
+}
+
+template <typename T_>
+void to_chars_test_case (req::Context &req_context, T_ value) {
+    std::ostringstream out;
+    out << txt.out(value);
+    LVD_TEST_REQ_EQ(out.str(), stream_formatted(value));
+}
+
+template <typename T_>
+void to_chars_test_case_random (req::Context &req_context) {
+    auto rng = std::mt19937{42};
+    for (int i = 0; i < 1000; ++i)
+        to_chars_test_case(req_context, make_random<T_>(rng));
+    to_chars_test_case(req_context, std::numeric_limits<T_>::lowest());
+    to_chars_test_case(req_context, std::numeric_limits<T_>::max());
+    to_chars_test_case(req_context, std::numeric_limits<T_>::min());
+    if constexpr (std::is_floating_point_v<T_>) {
+        to_chars_test_case(req_context, T_(0));
+        to_chars_test_case(req_context, -T_(0));
+        to_chars_test_case(req_context, std::numeric_limits<T_>::denorm_min());
+        to_chars_test_case(req_context, std::numeric_limits<T_>::infinity());
+        to_chars_test_case(req_context, -std::numeric_limits<T_>::infinity());
+        to_chars_test_case(req_context, std::numeric_limits<T_>::quiet_NaN());
+    }
+}
+
+LVD_TEST_BEGIN(232__write_text__02__to_chars)
+    // The output must be identical to what formatting via std::ostream produces.
+    to_chars_test_case_random<int16_t>(req_context);
+    to_chars_test_case_random<uint16_t>(req_context);
+    to_chars_test_case_random<int32_t>(req_context);
+    to_chars_test_case_random<uint32_t>(req_context);
+    to_chars_test_case_random<int64_t>(req_context);
+    to_chars_test_case_random<uint64_t>(req_context);
+    to_chars_test_case_random<float>(req_context);
+    to_chars_test_case_random<double>(req_context);
+    txt_test_case(req_context, int8_t(-128), "-128");
+    txt_test_case(req_context, uint8_t(255), "255");
+    txt_test_case(req_context, std::byte(0x0F), "0x0F");
+    txt_test_case(req_context, -1.0/3.0, "-3.33333333333333315e-01");
+
+    // Shortest round-trip representation of floats.
+    auto shortest = [](auto const &enc, auto const &value){
+        std::ostringstream out;
+        out << enc.out(value);
+        return out.str();
+    };
+    LVD_TEST_REQ_EQ(shortest(stxt, 1.25), "1.25");
+    LVD_TEST_REQ_EQ(shortest(stxt, float(0.1)), "0.1");
+    LVD_TEST_REQ_EQ(shortest(stxt, 1e300), "1e+300");
+    LVD_TEST_REQ_EQ(shortest(stxt, std::vector<double>{0.5, -2.0}), "(0.5, -2)");
+    LVD_TEST_REQ_EQ(shortest(slit, std::vector<double>{0.5, -2.0}), "vector<double>(0.5, -2)");
+    LVD_TEST_REQ_EQ(shortest(stxt, int32_t(-7)), "-7");
+LVD_TEST_END
+
 } // end namespace lvd
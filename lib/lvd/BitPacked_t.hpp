@@ -0,0 +1,91 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include "lvd/remove_cv_recursive.hpp"
+#include "lvd/type_string_of.hpp"
+#include <type_traits>
+
+namespace lvd {
+
+template <typename T_>
+struct is_optional_ : public std::false_type { };
+
+template <typename T_>
+struct is_optional_<std::optional<T_>> : public std::true_type { };
+
+template <typename T_>
+inline bool constexpr is_optional_v = is_optional_<T_>::value;
+
+template <typename T_>
+struct is_std_array_ : public std::false_type { };
+
+template <typename T_, size_t N_>
+struct is_std_array_<std::array<T_,N_>> : public std::true_type { };
+
+template <typename T_>
+inline bool constexpr is_std_array_v = is_std_array_<T_>::value;
+
+// Semantic subtype for opting a sequence container of bool or of std::optional<T> (e.g. std::vector<bool> or
+// std::array<std::optional<T>,N>) into the bit-packed encoding.  The size (unless it's fixed, as for std::array) is
+// followed by a bitmap (see lvd/bitpack.hpp) holding the bools, or the presence flags of the optionals, one bit each
+// instead of one byte each.  For optionals, the present values follow the bitmap, in order.  BitPacked_t<Container_>
+// has its own type string, so its encoding can't be mistaken for that of Container_.  Containers of optionals must
+// support operator[], e.g. std::vector, std::deque, or std::array.
+//
+// Use as_bit_packed to view an existing container as a BitPacked_t, e.g.
+//
+//     out << enc.out(as_bit_packed(flags));
+//     in >> enc.in(as_bit_packed(flags));
+template <typename Container_>
+class BitPacked_t : public Container_ {
+public:
+
+    using Element = remove_cv_recursive_t<typename Container_::value_type>;
+    static_assert(std::is_same_v<Element,bool> || is_optional_v<Element>, "BitPacked_t is only defined for containers of bool or std::optional");
+
+    using Container_::Container_;
+
+    static BitPacked_t const &cast_from (Container_ const &c) {
+        return *reinterpret_cast<BitPacked_t const *>(&c);
+    }
+    static BitPacked_t &cast_from (Container_ &c) {
+        return *reinterpret_cast<BitPacked_t *>(&c);
+    }
+
+    Container_ const &container () const { return *this; }
+    Container_ &container () { return *this; }
+
+    // These are static so that they can be used in `if constexpr` even when called through a reference.
+    static constexpr bool has_fixed_size () {
+        return is_std_array_v<Container_>;
+    }
+    static constexpr bool is_optional_container () {
+        return is_optional_v<Element>;
+    }
+};
+
+// Helper functions for type deduction.
+
+template <typename Container_>
+BitPacked_t<Container_> const &as_bit_packed (Container_ const &c) {
+    return BitPacked_t<Container_>::cast_from(c);
+}
+
+template <typename Container_>
+BitPacked_t<Container_> &as_bit_packed (Container_ &c) {
+    return BitPacked_t<Container_>::cast_from(c);
+}
+
+template <typename Container_>
+struct TypeString_t<BitPacked_t<Container_>> {
+    static std::string const &get () {
+        static std::string const STR{"BitPacked_t<" + type_string_of<Container_>() + '>'};
+        return STR;
+    }
+};
+
+} // end namespace lvd
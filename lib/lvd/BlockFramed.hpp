@@ -0,0 +1,331 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include "lvd/crc32c.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "lvd/encoding.hpp"
+#include <exception>
+#include "lvd/Range_t.hpp"
+#include "lvd/read.hpp"
+#include <ios>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "lvd/write.hpp"
+
+namespace lvd {
+
+//
+// Block framing, which adds integrity checking to a stream of (e.g. bin-encoded) bytes, so that truncation or
+// corruption is detected (and located) before anything is decoded from the corrupt part, instead of showing up
+// as a type mismatch somewhere deep in a ReadInPlace_t, or not at all.  The bytes are split into blocks of at
+// most block_size bytes, each of which is framed as
+//
+//     uint32_t payload size, uint32_t CRC32C, payload
+//
+// where the sizes and CRCs are little-endian, and the CRC32C is of the 4 bytes of the payload size followed by the
+// payload, so that a corrupt size is detected too.  The blocks are followed by an empty block (i.e. a payload size
+// of 0), which marks the end, so that truncation at a block boundary is detected too.
+//
+// BlockFramedWriter_t and BlockFramedReader_t can be used in place of the streams that they wrap, e.g.
+//
+//     BlockFramedWriter_t framed_out(out);
+//     framed_out << bin_lil_e.out(value);
+//     framed_out.finish();
+//
+//     BlockFramedReader_t framed_in(in);
+//     auto value = bin_lil_e.read<T>(framed_in);
+//
+// Note that a TypeInterningReadSession or TypeInterningWriteSession can't be attached to them.
+//
+
+inline size_t constexpr BLOCK_FRAMED_HEADER_SIZE = 2*sizeof(uint32_t);
+inline size_t constexpr BLOCK_FRAMED_DEFAULT_BLOCK_SIZE = 0x10000;
+
+// Thrown when a block is corrupt or truncated.  offset is that of the block's header from the start of the framed
+// bytes.
+class CorruptBlockError : public std::runtime_error {
+public:
+
+    CorruptBlockError (uint64_t offset, std::string const &what)
+        :   std::runtime_error("corrupt block at offset " + std::to_string(offset) + ": " + what)
+        ,   m_offset(offset)
+    { }
+
+    uint64_t offset () const { return m_offset; }
+
+private:
+
+    uint64_t m_offset;
+};
+
+inline std::array<std::byte,BLOCK_FRAMED_HEADER_SIZE> block_framed_header_for (std::byte const *payload, uint32_t payload_size) {
+    std::array<std::byte,BLOCK_FRAMED_HEADER_SIZE> header;
+    for (size_t i = 0; i < sizeof(uint32_t); ++i)
+        header[i] = std::byte(payload_size >> 8*i);
+    auto crc = crc32c(payload, payload_size, crc32c(header.data(), sizeof(uint32_t)));
+    for (size_t i = 0; i < sizeof(uint32_t); ++i)
+        header[sizeof(uint32_t)+i] = std::byte(crc >> 8*i);
+    return header;
+}
+
+inline uint32_t load_lil_uint32 (std::byte const *src) {
+    return uint32_t(src[0]) | (uint32_t(src[1]) << 8) | (uint32_t(src[2]) << 16) | (uint32_t(src[3]) << 24);
+}
+
+inline bool block_framed_crc_matches (std::byte const *header, std::byte const *payload, uint32_t payload_size) {
+    return crc32c(payload, payload_size, crc32c(header, sizeof(uint32_t))) == load_lil_uint32(header + sizeof(uint32_t));
+}
+
+// Writes block-framed bytes to out.  The terminating empty block is written by finish, which is called by the
+// destructor if it wasn't already, unless the destructor is run by stack unwinding, in which case the bytes are
+// left unterminated (and so are detectably truncated), rather than terminating a partially written value.
+template <typename Ostream_>
+class BlockFramedWriter_t {
+public:
+
+    using char_type = char;
+    using traits_type = std::char_traits<char>;
+
+    explicit BlockFramedWriter_t (Ostream_ &out, size_t block_size = BLOCK_FRAMED_DEFAULT_BLOCK_SIZE)
+        :   m_out(out)
+        ,   m_block_size(block_size)
+    {
+        if (block_size == 0 || block_size > std::numeric_limits<uint32_t>::max())
+            throw std::domain_error("block_size must be in the range [1, 2^32)");
+        m_block.reserve(block_size);
+    }
+    BlockFramedWriter_t (BlockFramedWriter_t const &) = delete;
+    BlockFramedWriter_t (BlockFramedWriter_t &&) = delete;
+    ~BlockFramedWriter_t () {
+        if (!m_is_finished && std::uncaught_exceptions() == m_uncaught_exceptions)
+            finish();
+    }
+
+    BlockFramedWriter_t &operator = (BlockFramedWriter_t const &) = delete;
+    BlockFramedWriter_t &operator = (BlockFramedWriter_t &&) = delete;
+
+    BlockFramedWriter_t &put (char_type c) {
+        m_block.push_back(std::byte(c));
+        if (m_block.size() == m_block_size)
+            end_block();
+        return *this;
+    }
+    BlockFramedWriter_t &write (char_type const *s, std::streamsize count) {
+        auto src = reinterpret_cast<std::byte const *>(s);
+        auto size = size_t(count);
+        while (size > 0) {
+            if (m_block.empty() && size >= m_block_size) {
+                // Whole blocks are written straight from s, without copying them into m_block.
+                write_block(src, m_block_size);
+                src += m_block_size;
+                size -= m_block_size;
+            } else {
+                auto chunk_size = std::min(m_block_size - m_block.size(), size);
+                m_block.insert(m_block.end(), src, src + chunk_size);
+                src += chunk_size;
+                size -= chunk_size;
+                if (m_block.size() == m_block_size)
+                    end_block();
+            }
+        }
+        return *this;
+    }
+
+    bool good () const { return m_out.good(); }
+    bool fail () const { return m_out.fail(); }
+    explicit operator bool () const { return !fail(); }
+
+    size_t block_size () const { return m_block_size; }
+
+    // Writes what's been written since the last block as a (possibly short) block, if there is any.
+    void end_block () {
+        if (!m_block.empty()) {
+            write_block(m_block.data(), m_block.size());
+            m_block.clear();
+        }
+    }
+    // Writes the last block and the terminating empty block.  Nothing more can be written after this.
+    void finish () {
+        if (m_is_finished)
+            throw std::domain_error("BlockFramedWriter_t::finish was already called");
+        end_block();
+        write_block(nullptr, 0);
+        m_is_finished = true;
+    }
+
+private:
+
+    void write_block (std::byte const *payload, size_t payload_size) {
+        auto header = block_framed_header_for(payload, uint32_t(payload_size));
+        m_out.write(reinterpret_cast<typename Ostream_::char_type const *>(header.data()), header.size());
+        m_out.write(reinterpret_cast<typename Ostream_::char_type const *>(payload), payload_size);
+    }
+
+    Ostream_ &m_out;
+    size_t m_block_size;
+    std::vector<std::byte> m_block;
+    bool m_is_finished = false;
+    // The number of exceptions in flight upon construction, so that the destructor can tell if it's unwinding.
+    int m_uncaught_exceptions = std::uncaught_exceptions();
+};
+
+template <typename Ostream_, typename T_, auto... Params_>
+BlockFramedWriter_t<Ostream_> &operator<< (BlockFramedWriter_t<Ostream_> &out, Out_t<T_,BinEncoding_t<Params_...>> const &o) {
+    return write_value(out, o.encoding(), o.src_val());
+}
+
+// Reads block-framed bytes from in, checking each block's CRC32C before any of it is read.  Throws
+// CorruptBlockError if a block is corrupt, or if in ends before the terminating empty block.  Reading past
+// the terminating empty block fails this stream the same way that reading past the end of in would, and leaves
+// in positioned just after it.  For a ByteReader (e.g. from MappedFile), blocks are checked and read in place.
+template <typename Istream_>
+class BlockFramedReader_t {
+public:
+
+    using char_type = char;
+    using traits_type = std::char_traits<char>;
+    using pos_type = traits_type::pos_type;
+
+    // Blocks bigger than max_block_size are considered corrupt, so that a corrupt size can't cause a huge
+    // allocation.
+    explicit BlockFramedReader_t (Istream_ &in, size_t max_block_size = BLOCK_FRAMED_DEFAULT_BLOCK_SIZE)
+        :   m_in(in)
+        ,   m_max_block_size(max_block_size)
+        ,   m_block(nullptr, nullptr)
+    { }
+
+    traits_type::int_type get () {
+        if (!has_unread_bytes()) {
+            m_state |= std::ios_base::eofbit | std::ios_base::failbit;
+            return traits_type::eof();
+        }
+        auto c = char_type(*m_block.begin());
+        ++m_block.begin();
+        return traits_type::to_int_type(c);
+    }
+    traits_type::int_type peek () {
+        if (!has_unread_bytes()) {
+            m_state |= std::ios_base::eofbit;
+            return traits_type::eof();
+        }
+        return traits_type::to_int_type(char_type(*m_block.begin()));
+    }
+    BlockFramedReader_t &read (char_type *s, std::streamsize count) {
+        auto dest = reinterpret_cast<std::byte *>(s);
+        auto size = size_t(count);
+        while (size > 0) {
+            if (!has_unread_bytes()) {
+                m_state |= std::ios_base::eofbit | std::ios_base::failbit;
+                break;
+            }
+            auto chunk_size = std::min(size_t(m_block.size()), size);
+            std::memcpy(dest, m_block.begin(), chunk_size);
+            m_block.begin() += chunk_size;
+            dest += chunk_size;
+            size -= chunk_size;
+        }
+        return *this;
+    }
+
+    bool good () const { return m_state == std::ios_base::goodbit; }
+    bool eof () const { return (m_state & std::ios_base::eofbit) != 0; }
+    bool fail () const { return (m_state & (std::ios_base::failbit | std::ios_base::badbit)) != 0; }
+    explicit operator bool () const { return !fail(); }
+    std::ios_base::iostate rdstate () const { return m_state; }
+    void setstate (std::ios_base::iostate state) { m_state |= state; }
+    void clear (std::ios_base::iostate state = std::ios_base::goodbit) { m_state = state; }
+
+    // As with std::basic_istream, this is -1 if the stream has failed.  Otherwise it's the number of (unframed)
+    // bytes read so far, e.g. so that the length of a length-framed value can be checked.
+    pos_type tellg () const { return fail() ? pos_type(-1) : pos_type(std::streamoff(m_payload_loaded - uint64_t(m_block.size()))); }
+    // The offset (from the start of the framed bytes) of the next block's header.
+    uint64_t offset () const { return m_offset; }
+    bool is_at_end () const { return m_is_at_end; }
+
+private:
+
+    // Loads the next nonempty block if the current one has been read.  Returns false if there are no more.
+    bool has_unread_bytes () {
+        while (m_block.empty()) {
+            if (m_is_at_end)
+                return false;
+            read_block();
+        }
+        return true;
+    }
+
+    void read_block () {
+        std::array<std::byte,BLOCK_FRAMED_HEADER_SIZE> header;
+        m_in.read(reinterpret_cast<typename Istream_::char_type *>(header.data()), header.size());
+        if (m_in.fail())
+            throw CorruptBlockError(m_offset, "truncated header");
+        auto payload_size = load_lil_uint32(header.data());
+        if (payload_size > m_max_block_size)
+            throw CorruptBlockError(m_offset, "payload size " + std::to_string(payload_size) + " exceeds max_block_size " + std::to_string(m_max_block_size));
+        if constexpr (is_contiguous_istream_v<Istream_>) {
+            m_block = m_in.view(payload_size);
+        } else {
+            m_buffer.resize(payload_size);
+            m_in.read(reinterpret_cast<typename Istream_::char_type *>(m_buffer.data()), payload_size);
+            m_block = Range_t<std::byte const *>(m_buffer.data(), m_buffer.data() + payload_size);
+        }
+        if (m_in.fail())
+            throw CorruptBlockError(m_offset, "truncated payload");
+        if (!block_framed_crc_matches(header.data(), m_block.begin(), payload_size))
+            throw CorruptBlockError(m_offset, "CRC32C mismatch");
+        m_offset += header.size() + payload_size;
+        m_payload_loaded += payload_size;
+        m_is_at_end = payload_size == 0;
+    }
+
+    Istream_ &m_in;
+    size_t m_max_block_size;
+    Range_t<std::byte const *> m_block;
+    std::vector<std::byte> m_buffer;
+    uint64_t m_offset = 0;
+    // The total size of the blocks loaded so far, including the unread part of m_block.
+    uint64_t m_payload_loaded = 0;
+    bool m_is_at_end = false;
+    std::ios_base::iostate m_state = std::ios_base::goodbit;
+};
+
+template <typename Istream_, typename T_, typename Encoding_>
+BlockFramedReader_t<Istream_> &operator>> (BlockFramedReader_t<Istream_> &in, In_t<T_,Encoding_> const &i) {
+    return read_in_place(in, i.encoding(), i.dest_val());
+}
+
+// Checks all the blocks of the given block-framed bytes (e.g. a MappedFile), without decoding anything, and
+// returns the offsets of the corrupt ones.  A corrupt payload size means that the blocks after it can't be found,
+// so the scan stops there, as it does if the bytes end before the terminating empty block.  The scan also stops at
+// any empty block (even one whose CRC32C doesn't match), since that's where a reader would stop.
+inline std::vector<uint64_t> find_corrupt_blocks (Range_t<std::byte const *> const &framed, size_t max_block_size = BLOCK_FRAMED_DEFAULT_BLOCK_SIZE) {
+    std::vector<uint64_t> corrupt_offsets;
+    auto size = size_t(framed.size());
+    for (size_t offset = 0; ; ) {
+        if (size - offset < BLOCK_FRAMED_HEADER_SIZE) {
+            corrupt_offsets.push_back(offset);
+            break;
+        }
+        auto header = framed.begin() + offset;
+        auto payload_size = load_lil_uint32(header);
+        if (payload_size > max_block_size || payload_size > size - offset - BLOCK_FRAMED_HEADER_SIZE) {
+            corrupt_offsets.push_back(offset);
+            break;
+        }
+        if (!block_framed_crc_matches(header, header + BLOCK_FRAMED_HEADER_SIZE, payload_size))
+            corrupt_offsets.push_back(offset);
+        if (payload_size == 0)
+            break;
+        offset += BLOCK_FRAMED_HEADER_SIZE + payload_size;
+    }
+    return corrupt_offsets;
+}
+
+} // end namespace lvd
@@ -0,0 +1,100 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include "lvd/encoding.hpp"
+#include "lvd/Range_t.hpp"
+#include "lvd/read.hpp"
+#include <ios>
+#include <string>
+
+namespace lvd {
+
+// Reads from a contiguous byte buffer, and can be used in place of a std::istream, e.g.
+//
+//     ByteReader in(lvd::range(bytes));
+//     auto value = bin_lil_e.read<T>(in);
+//
+// The ReadInPlace_t and ReadValue_t specializations for BinEncoding_t and TextEncoding_t work with it unchanged.  Reads are
+// bounds-checked pointer bumps, without the sentry objects and virtual streambuf calls of std::basic_istream.
+// As with std::basic_istream, reading past the end sets failbit and eofbit.  Note that a TypeInterningReadSession
+// can't be attached to a ByteReader.
+class ByteReader {
+public:
+
+    using char_type = char;
+    using traits_type = std::char_traits<char>;
+
+    explicit ByteReader (Range_t<std::byte const *> const &range) : m_range(range) { }
+
+    traits_type::int_type get () {
+        if (m_range.empty()) {
+            m_state |= std::ios_base::eofbit | std::ios_base::failbit;
+            return traits_type::eof();
+        }
+        auto c = char_type(*m_range.begin());
+        ++m_range.begin();
+        return traits_type::to_int_type(c);
+    }
+    // As with std::basic_istream, peeking at the end sets eofbit (but not failbit).
+    traits_type::int_type peek () {
+        if (m_range.empty()) {
+            m_state |= std::ios_base::eofbit;
+            return traits_type::eof();
+        }
+        return traits_type::to_int_type(char_type(*m_range.begin()));
+    }
+    ByteReader &read (char_type *s, std::streamsize count) {
+        auto available = size_t(m_range.size());
+        if (size_t(count) > available) {
+            // Same as std::basic_istream, which reads what's available and then fails.
+            count = std::streamsize(available);
+            m_state |= std::ios_base::eofbit | std::ios_base::failbit;
+        }
+        // Calling memcpy with nullptr is undefined, even with a 0 count.
+        if (count > 0)
+            std::memcpy(s, m_range.begin(), size_t(count));
+        m_range.begin() += count;
+        return *this;
+    }
+
+    // Returns the next count bytes in-place (i.e. without copying them) and advances past them.  If fewer are
+    // available, then this fails like read does, and returns an empty range.
+    Range_t<std::byte const *> view (size_t count) {
+        if (count > size_t(m_range.size())) {
+            m_range.begin() = m_range.end();
+            m_state |= std::ios_base::eofbit | std::ios_base::failbit;
+            return m_range;
+        }
+        auto retval = Range_t<std::byte const *>(m_range.begin(), m_range.begin()+count);
+        m_range.begin() += count;
+        return retval;
+    }
+
+    bool good () const { return m_state == std::ios_base::goodbit; }
+    bool eof () const { return (m_state & std::ios_base::eofbit) != 0; }
+    bool fail () const { return (m_state & (std::ios_base::failbit | std::ios_base::badbit)) != 0; }
+    explicit operator bool () const { return !fail(); }
+    std::ios_base::iostate rdstate () const { return m_state; }
+    void setstate (std::ios_base::iostate state) { m_state |= state; }
+    void clear (std::ios_base::iostate state = std::ios_base::goodbit) { m_state = state; }
+
+    // The bytes that haven't been read yet.
+    Range_t<std::byte const *> const &range () const { return m_range; }
+
+private:
+
+    Range_t<std::byte const *> m_range;
+    std::ios_base::iostate m_state = std::ios_base::goodbit;
+};
+
+// NOTE: If you're getting a compile error like "invalid use of incomplete type...", then you
+// need to include <lvd/read_XXX.hpp> for some XXX, e.g. bin_array or text_pair.
+template <typename T_, typename Encoding_>
+ByteReader &operator>> (ByteReader &in, In_t<T_,Encoding_> const &i) {
+    return read_in_place(in, i.encoding(), i.dest_val());
+}
+
+} // end namespace lvd
@@ -0,0 +1,74 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include <cstddef>
+#include "lvd/encoding.hpp"
+#include "lvd/Range_t.hpp"
+#include "lvd/write.hpp"
+#include <ios>
+#include <string>
+#include <vector>
+
+namespace lvd {
+
+// A growable, contiguous byte buffer which can be used in place of a std::ostream for binary encodings, e.g.
+//
+//     ByteWriter out;
+//     out << bin_lil_e.out(value);
+//     auto bytes = out.take_bytes();
+//
+// The WriteValue_t specializations for BinEncoding_t work with it unchanged.  Writes are inline appends to a
+// std::vector<std::byte>, without the sentry objects and virtual streambuf calls of std::basic_ostream.  Note
+// that a TypeInterningWriteSession can't be attached to a ByteWriter.
+class ByteWriter {
+public:
+
+    using char_type = char;
+    using traits_type = std::char_traits<char>;
+
+    ByteWriter () = default;
+    // Appends to the given bytes, e.g. to reuse the capacity of a previously taken buffer.
+    explicit ByteWriter (std::vector<std::byte> &&bytes) : m_bytes(std::move(bytes)) { }
+
+    ByteWriter &put (char_type c) {
+        m_bytes.push_back(std::byte(c));
+        return *this;
+    }
+    ByteWriter &write (char_type const *s, std::streamsize count) {
+        auto begin = reinterpret_cast<std::byte const *>(s);
+        m_bytes.insert(m_bytes.end(), begin, begin+count);
+        return *this;
+    }
+
+    // A ByteWriter can't fail (other than by throwing std::bad_alloc).
+    bool good () const { return true; }
+    bool fail () const { return false; }
+    explicit operator bool () const { return true; }
+
+    std::vector<std::byte> const &bytes () const { return m_bytes; }
+    Range_t<std::byte const *> range () const { return Range_t<std::byte const *>(m_bytes.data(), m_bytes.data()+m_bytes.size()); }
+    size_t size () const { return m_bytes.size(); }
+
+    void reserve (size_t capacity) { m_bytes.reserve(capacity); }
+    void clear () { m_bytes.clear(); }
+    // Moves the written bytes out, leaving this empty.
+    std::vector<std::byte> take_bytes () {
+        auto retval = std::move(m_bytes);
+        m_bytes.clear();
+        return retval;
+    }
+
+private:
+
+    std::vector<std::byte> m_bytes;
+};
+
+// NOTE: If you're getting a compile error like "invalid use of incomplete type...", then you
+// need to include <lvd/write_bin_XXX.hpp> for some XXX, e.g. array or pair.
+template <typename T_, auto... Params_>
+ByteWriter &operator<< (ByteWriter &out, Out_t<T_,BinEncoding_t<Params_...>> const &o) {
+    return write_value(out, o.encoding(), o.src_val());
+}
+
+} // end namespace lvd
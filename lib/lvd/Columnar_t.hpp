@@ -0,0 +1,83 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include <cstddef>
+#include "lvd/remove_cv_recursive.hpp"
+#include "lvd/type_string_of.hpp"
+#include <tuple>
+#include <type_traits>
+
+namespace lvd {
+
+template <typename T_, typename = void>
+struct is_tuple_like_ : public std::false_type { };
+
+template <typename T_>
+struct is_tuple_like_<T_,std::void_t<decltype(std::tuple_size<T_>::value)>> : public std::true_type { };
+
+// Is true iff T_ has a std::tuple_size (e.g. std::pair, std::tuple, std::array, IndexedTuple_t).
+template <typename T_>
+inline bool constexpr is_tuple_like_v = is_tuple_like_<T_>::value;
+
+// Semantic subtype for opting a sequence container of tuple-like elements into the columnar (struct-of-arrays)
+// encoding, in which the size is followed by the 0th field of every element, then the 1st field of every element,
+// and so on.  Each column is then homogeneous, so a column of basic values can be written or read as a block, and
+// a reader that only needs some of the fields can skip the other columns (see read_bin_columns).  The encoding is
+// distinct from that of Container_, and Columnar_t<Container_> has its own type string, so the two can't be mixed up.
+//
+// Use as_columnar to view an existing container as a Columnar_t, e.g.
+//
+//     out << enc.out(as_columnar(rows));
+//     in >> enc.in(as_columnar(rows));
+template <typename Container_>
+class Columnar_t : public Container_ {
+public:
+
+    using Row = remove_cv_recursive_t<typename Container_::value_type>;
+    static_assert(is_tuple_like_v<Row>, "Columnar_t is only defined for containers of tuple-like elements");
+    static_assert(std::tuple_size_v<Row> > 0, "Columnar_t is only defined for elements having at least one field");
+
+    using Container_::Container_;
+
+    static Columnar_t const &cast_from (Container_ const &c) {
+        return *reinterpret_cast<Columnar_t const *>(&c);
+    }
+    static Columnar_t &cast_from (Container_ &c) {
+        return *reinterpret_cast<Columnar_t *>(&c);
+    }
+
+    Container_ const &container () const { return *this; }
+    Container_ &container () { return *this; }
+
+    // This is static so that it can be used in `if constexpr` even when called through a reference.
+    static constexpr size_t column_count () {
+        return std::tuple_size_v<Row>;
+    }
+};
+
+// The type of the INDEX_th column of Columnar_t<Container_>.
+template <size_t INDEX_, typename Container_>
+using ColumnType_t = remove_cv_recursive_t<std::tuple_element_t<INDEX_,typename Columnar_t<Container_>::Row>>;
+
+// Helper functions for type deduction.
+
+template <typename Container_>
+Columnar_t<Container_> const &as_columnar (Container_ const &c) {
+    return Columnar_t<Container_>::cast_from(c);
+}
+
+template <typename Container_>
+Columnar_t<Container_> &as_columnar (Container_ &c) {
+    return Columnar_t<Container_>::cast_from(c);
+}
+
+template <typename Container_>
+struct TypeString_t<Columnar_t<Container_>> {
+    static std::string const &get () {
+        static std::string const STR{"Columnar_t<" + type_string_of<Container_>() + '>'};
+        return STR;
+    }
+};
+
+} // end namespace lvd
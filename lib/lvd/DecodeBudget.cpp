@@ -0,0 +1,38 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#include "lvd/DecodeBudget.hpp"
+#include <stdexcept>
+#include <string>
+
+namespace lvd {
+
+thread_local DecodeBudget *DecodeBudget::ms_current = nullptr;
+
+DecodeBudget::DecodeBudget (DecodeLimits const &limits)
+    :   m_limits(limits)
+    ,   m_previous(ms_current)
+{
+    ms_current = this;
+}
+
+DecodeBudget::~DecodeBudget () {
+    ms_current = m_previous;
+}
+
+void DecodeBudget::charge (size_t count, size_t element_size) {
+    // Compare without multiplying or adding, so that a huge count can't overflow.
+    if (count > m_limits.max_element_count - m_element_count)
+        throw std::runtime_error("decode budget exceeded; " + std::to_string(count) + " more elements would exceed max_element_count " + std::to_string(m_limits.max_element_count));
+    if (element_size > 0 && count > (m_limits.max_total_bytes - m_total_bytes) / element_size)
+        throw std::runtime_error("decode budget exceeded; " + std::to_string(count) + " more elements of size " + std::to_string(element_size) + " would exceed max_total_bytes " + std::to_string(m_limits.max_total_bytes));
+    m_element_count += count;
+    m_total_bytes += count*element_size;
+}
+
+void DecodeBudget::enter_nesting_level () {
+    if (m_nesting_depth >= m_limits.max_nesting_depth)
+        throw std::runtime_error("decode budget exceeded; nesting depth would exceed max_nesting_depth " + std::to_string(m_limits.max_nesting_depth));
+    ++m_nesting_depth;
+}
+
+} // end namespace lvd
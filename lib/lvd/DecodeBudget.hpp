@@ -0,0 +1,112 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+
+namespace lvd {
+
+// Limits on how much work decoding untrusted input may do.  The sizes of strings and containers are read
+// straight from the input, so without these, a single corrupt size could cause a huge allocation, and a crafted
+// input could cause a huge amount of work.  The default is unlimited.
+struct DecodeLimits {
+    // Max total number of bytes of element storage (i.e. count*sizeof(element) for each string and container).
+    size_t max_total_bytes = std::numeric_limits<size_t>::max();
+    // Max total number of elements across all strings and containers.
+    size_t max_element_count = std::numeric_limits<size_t>::max();
+    // Max depth of strings and containers within containers, where a top-level string or container is at depth 1.
+    size_t max_nesting_depth = std::numeric_limits<size_t>::max();
+};
+
+// Enforces DecodeLimits on all decoding done by the current thread during its lifetime, i.e. by the string and
+// container readers of both the ReadInPlace_t (read_bin_*) and the DeserializeTo_t (serialization.hpp) stacks,
+// whatever the source is (std::istream, ByteReader, or a Range_t).  Budgets are scoped: constructing one makes
+// it current, and destroying it restores the previous one (if any).  Each string or container is charged for its
+// claimed size before anything is allocated for it, so exceeding a limit throws std::runtime_error up front.
+class DecodeBudget {
+public:
+
+    explicit DecodeBudget (DecodeLimits const &limits);
+    DecodeBudget (DecodeBudget const &) = delete;
+    DecodeBudget (DecodeBudget &&) = delete;
+    ~DecodeBudget ();
+
+    DecodeBudget &operator = (DecodeBudget const &) = delete;
+    DecodeBudget &operator = (DecodeBudget &&) = delete;
+
+    // Returns the current thread's innermost budget, or nullptr if there is none.
+    static DecodeBudget *current () { return ms_current; }
+
+    DecodeLimits const &limits () const { return m_limits; }
+    size_t total_bytes () const { return m_total_bytes; }
+    size_t element_count () const { return m_element_count; }
+    size_t nesting_depth () const { return m_nesting_depth; }
+
+    // Charges a string or container having count elements of element_size bytes each.  Throws std::runtime_error
+    // if that would exceed the limits, in which case nothing is charged.
+    void charge (size_t count, size_t element_size);
+    // Throws std::runtime_error if that would exceed max_nesting_depth, in which case the depth is unchanged.
+    void enter_nesting_level ();
+    void leave_nesting_level () { --m_nesting_depth; }
+
+private:
+
+    static thread_local DecodeBudget *ms_current;
+
+    DecodeLimits m_limits;
+    DecodeBudget *m_previous;
+    size_t m_total_bytes = 0;
+    size_t m_element_count = 0;
+    size_t m_nesting_depth = 0;
+};
+
+// Charges the current DecodeBudget (if any) for a string or container having count elements of type T_.
+template <typename T_>
+void charge_decode_budget (size_t count) {
+    if (auto budget = DecodeBudget::current(); budget != nullptr)
+        budget->charge(count, sizeof(T_));
+}
+
+// Charges the current DecodeBudget (if any) for one level of nesting for its lifetime.  This is meant to be
+// used by container readers around reading their elements.
+class DecodeNestingLevel {
+public:
+
+    DecodeNestingLevel ()
+        :   m_budget(DecodeBudget::current())
+    {
+        if (m_budget != nullptr)
+            m_budget->enter_nesting_level();
+    }
+    DecodeNestingLevel (DecodeNestingLevel const &) = delete;
+    DecodeNestingLevel (DecodeNestingLevel &&) = delete;
+    ~DecodeNestingLevel () {
+        if (m_budget != nullptr)
+            m_budget->leave_nesting_level();
+    }
+
+    DecodeNestingLevel &operator = (DecodeNestingLevel const &) = delete;
+    DecodeNestingLevel &operator = (DecodeNestingLevel &&) = delete;
+
+private:
+
+    DecodeBudget *m_budget;
+};
+
+// Claimed sizes come straight from the input, so at most this many bytes are allocated up front for a string or
+// container before its elements are actually read; beyond that, storage grows as the elements arrive.  Thus a
+// corrupt size runs into the end of the input before it can cause a huge allocation.
+inline size_t constexpr MAX_UNVERIFIED_RESERVE_BYTES = 0x100000;
+
+// Returns how many elements of type T_ to reserve up front for a string or container claiming count elements, given
+// that at most available_bytes of input remain (if known) and each element takes at least 1 byte of input.
+template <typename T_>
+size_t constexpr unverified_reserve_count (size_t count, size_t available_bytes = std::numeric_limits<size_t>::max()) {
+    size_t max_count = MAX_UNVERIFIED_RESERVE_BYTES / sizeof(T_);
+    if (max_count > available_bytes)
+        max_count = available_bytes;
+    return count < max_count ? count : max_count;
+}
+
+} // end namespace lvd
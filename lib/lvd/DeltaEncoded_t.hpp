@@ -0,0 +1,117 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include "lvd/type_string_of.hpp"
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace lvd {
+
+// Semantic subtype for opting an ordered associative container (e.g. std::set or std::map) with integral keys into
+// the delta encoding, in which the keys are encoded as the first key followed by the differences between consecutive
+// keys, which are bit-packed in blocks of DELTA_BLOCK_SIZE, each block using the bit width of its largest difference.
+// For a map, the mapped values follow the keys, in key order.  Dense or clustered keys (e.g. sorted ids) then take a
+// few bits each instead of their full width.  DeltaEncoded_t<Container_> has its own type string, so its encoding
+// can't be mistaken for that of Container_.
+//
+// Use as_delta_encoded to view an existing container as a DeltaEncoded_t, e.g.
+//
+//     out << enc.out(as_delta_encoded(ids));
+//     in >> enc.in(as_delta_encoded(ids));
+template <typename Container_>
+class DeltaEncoded_t : public Container_ {
+public:
+
+    using Key = typename Container_::key_type;
+    static_assert(std::is_integral_v<Key> && !std::is_same_v<Key,bool>, "DeltaEncoded_t is only defined for integral keys");
+    static_assert(std::is_same_v<typename Container_::key_compare,std::less<Key>>, "DeltaEncoded_t is only defined for containers in increasing key order");
+    // The differences are computed in this type, so that they're well-defined for signed keys too.
+    using UnsignedKey = std::make_unsigned_t<Key>;
+
+    using Container_::Container_;
+
+    static DeltaEncoded_t const &cast_from (Container_ const &c) {
+        return *reinterpret_cast<DeltaEncoded_t const *>(&c);
+    }
+    static DeltaEncoded_t &cast_from (Container_ &c) {
+        return *reinterpret_cast<DeltaEncoded_t *>(&c);
+    }
+
+    Container_ const &container () const { return *this; }
+    Container_ &container () { return *this; }
+
+    // These are static so that they can be used in `if constexpr` even when called through a reference.
+    static constexpr bool is_map () {
+        return !std::is_same_v<typename Container_::value_type,Key>;
+    }
+
+    static Key const &key_of (typename Container_::value_type const &element) {
+        if constexpr (is_map())
+            return element.first;
+        else
+            return element;
+    }
+};
+
+// The number of differences in each bit-packed block.  The last block may be shorter.
+inline size_t constexpr DELTA_BLOCK_SIZE = 128;
+
+// Replaces each of the count values with the (wrapping) sum of base and the values up to and including it,
+// i.e. turns differences into the values they're differences of.  Returns the last sum, or base if count is 0.
+// If SSE2 is enabled (which it always is on x86-64), this sums 2 values per step using 128-bit adds,
+// carrying the running sum across blocks in a register; otherwise it's a plain serial loop.
+inline uint64_t prefix_sum_in_place (uint64_t *values, size_t count, uint64_t base) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    size_t constexpr VALUES_PER_BLOCK = sizeof(__m128i) / sizeof(uint64_t);
+    if (count >= VALUES_PER_BLOCK) {
+        // Both lanes of carry hold the running sum.
+        __m128i carry = _mm_set1_epi64x(int64_t(base));
+        for ( ; i+VALUES_PER_BLOCK <= count; i += VALUES_PER_BLOCK) {
+            auto block = reinterpret_cast<__m128i *>(values+i);
+            // [a, b] -> [a, a+b] -> [base+a, base+a+b]
+            __m128i v = _mm_loadu_si128(block);
+            v = _mm_add_epi64(v, _mm_slli_si128(v, 8));
+            v = _mm_add_epi64(v, carry);
+            _mm_storeu_si128(block, v);
+            carry = _mm_unpackhi_epi64(v, v);
+        }
+        base = values[i-1];
+    }
+#endif
+    // Handle the remainder (or everything, if there's no SIMD path).
+    for ( ; i < count; ++i) {
+        base += values[i];
+        values[i] = base;
+    }
+    return base;
+}
+
+// Helper functions for type deduction.
+
+template <typename Container_>
+DeltaEncoded_t<Container_> const &as_delta_encoded (Container_ const &c) {
+    return DeltaEncoded_t<Container_>::cast_from(c);
+}
+
+template <typename Container_>
+DeltaEncoded_t<Container_> &as_delta_encoded (Container_ &c) {
+    return DeltaEncoded_t<Container_>::cast_from(c);
+}
+
+template <typename Container_>
+struct TypeString_t<DeltaEncoded_t<Container_>> {
+    static std::string const &get () {
+        static std::string const STR{"DeltaEncoded_t<" + type_string_of<Container_>() + '>'};
+        return STR;
+    }
+};
+
+} // end namespace lvd
@@ -13,6 +13,8 @@
 #include <ostream>
 #include <set>
 #include <string>
+#include <tuple>
+#include "lvd/type_string_of_tuple.hpp"
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
@@ -49,13 +51,14 @@ public:
     IndexedTuple_t<INDEX_+1,Types_...> &incremented () {
         return *reinterpret_cast<IndexedTuple_t<INDEX_+1,Types_...> *>(this);
     }
-    constexpr bool has_ended () const {
+    // These are static so that they can be used in `if constexpr` even when called through a reference.
+    static constexpr bool has_ended () {
         return INDEX_ >= sizeof...(Types_);
     }
-    constexpr bool next_has_ended () const {
+    static constexpr bool next_has_ended () {
         return INDEX_+1 >= sizeof...(Types_);
     }
-    constexpr size_t size () const {
+    static constexpr size_t size () {
         return sizeof...(Types_);
     }
 
@@ -76,6 +79,25 @@ public:
     }
 };
 
+// IndexedTuple_t is only a means of writing/reading the elements of a tuple, which is framed as a whole.
+template <size_t INDEX_, typename... Types_>
+inline bool constexpr is_bin_framed_type_v<IndexedTuple_t<INDEX_,Types_...>> = false;
+
+// The type is that of the tuple, since that's what IndexedTuple_t writes/reads.
+template <size_t INDEX_, typename... Types_>
+struct TypeString_t<IndexedTuple_t<INDEX_,Types_...>> {
+    static std::string const &get () {
+        return TypeString_t<std::tuple<Types_...>>::get();
+    }
+};
+
+template <size_t INDEX_, typename... Types_>
+struct TypeTag_t<IndexedTuple_t<INDEX_,Types_...>> {
+    static std::string const &get () {
+        return TypeTag_t<std::tuple<Types_...>>::get();
+    }
+};
+
 // Helper functions for type deduction.
 
 template <typename... Types_>
@@ -89,3 +111,14 @@ IndexedTuple_t<0,Types_...> &begin_indexed_tuple (std::tuple<Types_...> &t) {
 }
 
 } // end namespace lvd
+
+namespace std {
+
+// IndexedTuple_t has the same elements as its std::tuple base, so it's tuple-like as well (e.g. for Columnar_t).
+template <size_t INDEX_, typename... Types_>
+struct tuple_size<lvd::IndexedTuple_t<INDEX_,Types_...>> : public tuple_size<tuple<Types_...>> { };
+
+template <size_t ELEMENT_INDEX_, size_t INDEX_, typename... Types_>
+struct tuple_element<ELEMENT_INDEX_,lvd::IndexedTuple_t<INDEX_,Types_...>> : public tuple_element<ELEMENT_INDEX_,tuple<Types_...>> { };
+
+} // end namespace std
@@ -0,0 +1,99 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include "lvd/ByteReader.hpp"
+#include <cstddef>
+#include "lvd/encoding.hpp"
+#include "lvd/endian.hpp"
+#include <optional>
+#include "lvd/Range_t.hpp"
+#include "lvd/read.hpp"
+#include <stdexcept>
+#include "lvd/type_id.hpp"
+#include "lvd/type_string_of.hpp"
+
+namespace lvd {
+
+// A value of type T_ whose encoding was read from a ByteReader (e.g. over a MappedFile) without being decoded.  It
+// refers to the encoded bytes in place, so the ByteReader's buffer must outlive it, and it decodes them on first
+// access.  This pays off for composite values under FramingEncoding::LENGTH_PREFIXED, since then reading a
+// LazyValue_t is just a bounds check, e.g. for records of which only a few fields are used,
+//
+//     auto record = fbin_lil_e.read<std::tuple<LazyValue_t<A>,LazyValue_t<B>,LazyValue_t<C>>>(in);
+//     use(std::get<1>(record).value()); // Only the B is decoded.
+//
+// Otherwise, reading a LazyValue_t decodes the value anyway (in order to find its extent), and then discards it.
+// LazyValue_t<T_> has the same encoding and type string as T_.
+template <typename T_>
+class LazyValue_t {
+public:
+
+    using T = T_;
+
+    LazyValue_t () = default;
+    template <auto... Params_>
+    LazyValue_t (Range_t<std::byte const *> const &bytes, BinEncoding_t<Params_...> const &enc)
+        :   m_bytes(bytes)
+        ,   m_endianness(enc.endianness())
+        ,   m_decode(&decode<BinEncoding_t<Params_...>>)
+    { }
+
+    // The encoded bytes.
+    Range_t<std::byte const *> const &bytes () const { return m_bytes; }
+    bool is_decoded () const { return m_value.has_value(); }
+
+    // Decodes the value on first access.  Throws std::runtime_error if it can't be decoded.
+    T_ const &value () const {
+        if (!m_value.has_value()) {
+            if (m_decode == nullptr)
+                throw std::runtime_error("LazyValue_t has no encoded value");
+            m_value.emplace(m_decode(m_bytes, m_endianness));
+        }
+        return *m_value;
+    }
+    T_ const &operator* () const { return value(); }
+    T_ const *operator-> () const { return &value(); }
+
+private:
+
+    // The encoding only needs its endianness as runtime state, so that's all that's stored of it.
+    template <typename Encoding_>
+    static T_ decode (Range_t<std::byte const *> const &bytes, Endianness endianness) {
+        ByteReader in(bytes);
+        auto value = [&in, endianness](){
+            if constexpr (Encoding_::endianness_encoding() == EndiannessEncoding::RUNTIME)
+                return read_value<T_>(in, Encoding_(endianness));
+            else
+                return read_value<T_>(in, Encoding_());
+        }();
+        if (in.fail())
+            throw std::runtime_error("failed to decode LazyValue_t");
+        return value;
+    }
+
+    Range_t<std::byte const *> m_bytes{nullptr, nullptr};
+    Endianness m_endianness = MACHINE_ENDIANNESS;
+    T_ (*m_decode)(Range_t<std::byte const *> const &, Endianness) = nullptr;
+    mutable std::optional<T_> m_value;
+};
+
+// The framing (if any) is that of T_, which LazyValue_t reads as a whole.
+template <typename T_>
+inline bool constexpr is_bin_framed_type_v<LazyValue_t<T_>> = false;
+
+template <typename T_>
+struct TypeString_t<LazyValue_t<T_>> {
+    static std::string const &get () {
+        return TypeString_t<T_>::get();
+    }
+};
+
+template <typename T_>
+struct TypeTag_t<LazyValue_t<T_>> {
+    static std::string const &get () {
+        return TypeTag_t<T_>::get();
+    }
+};
+
+} // end namespace lvd
@@ -0,0 +1,115 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include "lvd/MappedFile.hpp"
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace lvd {
+
+namespace {
+
+std::runtime_error system_error (std::string const &what, std::string const &path) {
+    return std::runtime_error(what + " \"" + path + "\": " + std::strerror(errno));
+}
+
+int madvice_for (MappedFileAccess access) {
+    switch (access) {
+        case MappedFileAccess::NORMAL: return MADV_NORMAL;
+        case MappedFileAccess::SEQUENTIAL: return MADV_SEQUENTIAL;
+        case MappedFileAccess::RANDOM: return MADV_RANDOM;
+    }
+    throw std::domain_error("invalid MappedFileAccess value " + std::to_string(int(access)));
+}
+
+} // end of anonymous namespace
+
+MappedFile::MappedFile (std::string const &path, MappedFileAccess access, bool will_need)
+    :   m_path(path)
+    ,   m_data(nullptr)
+    ,   m_size(0)
+{
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        throw system_error("failed to open", path);
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        auto e = system_error("failed to stat", path);
+        ::close(fd);
+        throw e;
+    }
+    m_size = size_t(st.st_size);
+
+    // mmap fails for 0 bytes, so an empty file is just left unmapped.
+    if (m_size > 0) {
+        void *p = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            auto e = system_error("failed to mmap", path);
+            ::close(fd);
+            throw e;
+        }
+        m_data = static_cast<std::byte const *>(p);
+    }
+    // The mapping stays valid after the file descriptor is closed.
+    ::close(fd);
+
+    advise(range(), access, will_need);
+}
+
+MappedFile::MappedFile (MappedFile &&other)
+    :   m_path(std::move(other.m_path))
+    ,   m_data(other.m_data)
+    ,   m_size(other.m_size)
+{
+    other.m_data = nullptr;
+    other.m_size = 0;
+}
+
+MappedFile::~MappedFile () {
+    unmap();
+}
+
+MappedFile &MappedFile::operator = (MappedFile &&other) {
+    if (this != &other) {
+        unmap();
+        m_path = std::move(other.m_path);
+        m_data = other.m_data;
+        m_size = other.m_size;
+        other.m_data = nullptr;
+        other.m_size = 0;
+    }
+    return *this;
+}
+
+void MappedFile::advise (Range_t<std::byte const *> const &subrange, MappedFileAccess access, bool will_need) const {
+    if (subrange.empty())
+        return;
+    if (subrange.begin() < m_data || subrange.end() > m_data+m_size)
+        throw std::out_of_range("subrange is not within the mapping of \"" + m_path + '"');
+
+    // madvise requires a page-aligned address.
+    auto page_size = uintptr_t(::sysconf(_SC_PAGESIZE));
+    auto begin = reinterpret_cast<uintptr_t>(subrange.begin()) / page_size * page_size;
+    auto end = reinterpret_cast<uintptr_t>(subrange.end());
+    auto p = reinterpret_cast<void *>(begin);
+    // These are only hints, so failure isn't an error (and shouldn't be visible in errno).
+    auto saved_errno = errno;
+    ::madvise(p, end - begin, madvice_for(access));
+    if (will_need)
+        ::madvise(p, end - begin, MADV_WILLNEED);
+    errno = saved_errno;
+}
+
+void MappedFile::unmap () {
+    if (m_data != nullptr)
+        ::munmap(const_cast<std::byte *>(m_data), m_size);
+    m_data = nullptr;
+    m_size = 0;
+}
+
+} // end namespace lvd
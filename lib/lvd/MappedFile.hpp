@@ -0,0 +1,56 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "lvd/ByteReader.hpp"
+#include "lvd/Range_t.hpp"
+#include <string>
+
+namespace lvd {
+
+// Hint for how a MappedFile will be accessed, which is passed on to madvise.
+enum class MappedFileAccess : uint8_t {
+    NORMAL = 0, // MADV_NORMAL
+    SEQUENTIAL, // MADV_SEQUENTIAL -- aggressive read-ahead, and pages can be dropped soon after they're read.
+    RANDOM,     // MADV_RANDOM -- no read-ahead.
+};
+
+// Read-only memory mapping of a whole file, for decoding it in-place (e.g. via ByteReader) instead of copying
+// it through a std::ifstream.  The mapping is private and read-only, so the file must not be truncated while
+// it's mapped.  Throws std::runtime_error if the file can't be opened or mapped.
+class MappedFile {
+public:
+
+    // If will_need is true, the kernel is asked to start reading in the whole file (MADV_WILLNEED), so that
+    // the I/O overlaps with decoding instead of being done one page fault at a time.
+    explicit MappedFile (std::string const &path, MappedFileAccess access = MappedFileAccess::SEQUENTIAL, bool will_need = true);
+    MappedFile (MappedFile const &) = delete;
+    MappedFile (MappedFile &&other);
+    ~MappedFile ();
+
+    MappedFile &operator = (MappedFile const &) = delete;
+    MappedFile &operator = (MappedFile &&other);
+
+    std::string const &path () const { return m_path; }
+    std::byte const *data () const { return m_data; }
+    size_t size () const { return m_size; }
+    Range_t<std::byte const *> range () const { return Range_t<std::byte const *>(m_data, m_data+m_size); }
+    // Returns a ByteReader over the whole mapping.  The mapping must outlive it, and any views produced from it.
+    ByteReader reader () const { return ByteReader(range()); }
+
+    // Gives the kernel a hint about the access pattern of the given subrange of the mapping (e.g. MADV_WILLNEED
+    // for a region that's about to be decoded).  The subrange is expanded to page boundaries.
+    void advise (Range_t<std::byte const *> const &subrange, MappedFileAccess access, bool will_need) const;
+
+private:
+
+    void unmap ();
+
+    std::string m_path;
+    std::byte const *m_data;
+    size_t m_size;
+};
+
+} // end namespace lvd
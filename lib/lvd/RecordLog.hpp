@@ -0,0 +1,254 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include <algorithm>
+#include "lvd/bitpack.hpp"
+#include "lvd/ByteReader.hpp"
+#include "lvd/ByteWriter.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "lvd/DecodeBudget.hpp"
+#include "lvd/Empty.hpp"
+#include "lvd/encoding.hpp"
+#include <exception>
+#include "lvd/Range_t.hpp"
+#include "lvd/read.hpp"
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "lvd/write.hpp"
+
+namespace lvd {
+
+//
+// Record logs, which are sequences of records (values encoded with a BinEncoding_t) followed by an index of where
+// each record starts, so that any record can be found in O(1), without decoding the ones before it.  This also
+// means that disjoint ranges of records can be decoded independently, e.g. by different threads.  The layout is
+//
+//     record 0, record 1, ..., record n-1, offsets, key samples, trailer
+//
+// where each record is its uint64_t length followed by its encoding, offsets are the n uint64_t offsets of the
+// records (from the start of the log), and key samples are the keys (encoded the same way as the records) of
+// every key_sample_interval-th record, i.e. records 0, key_sample_interval, 2*key_sample_interval, etc., if
+// key_sample_interval isn't 0.  The trailer is
+//
+//     uint64_t record count, uint64_t key_sample_interval, uint64_t offset of the offsets,
+//     uint64_t offset of the key samples, RECORD_LOG_MAGIC
+//
+// The lengths, offsets and trailer are all little-endian, whatever the encoding of the records is.
+//
+
+inline char const RECORD_LOG_MAGIC[8] = {'l', 'v', 'd', 'r', 'l', 'o', 'g', '1'};
+inline size_t constexpr RECORD_LOG_TRAILER_SIZE = 4*sizeof(uint64_t) + sizeof(RECORD_LOG_MAGIC);
+
+// Writes a record log to out (which can be e.g. a std::ofstream or a ByteWriter), which must be positioned at the
+// start of the log.  The index is written by finish, which is called by the destructor if it wasn't already, unless
+// the destructor is run by stack unwinding, in which case the log is left without an index (and so is detectably
+// incomplete), rather than finishing a log that was abandoned partway through.
+// If Key_ isn't Empty and key_sample_interval isn't 0, then every key_sample_interval-th record must be appended
+// with its key, and the records must be appended in increasing order of key, so that RecordLogReader_t::seek_to_key
+// can be used.
+template <typename Ostream_, typename Encoding_, typename Key_ = Empty>
+class RecordLogWriter_t {
+public:
+
+    RecordLogWriter_t (Ostream_ &out, Encoding_ const &enc, size_t key_sample_interval = 0)
+        :   m_out(out)
+        ,   m_encoding(enc)
+        ,   m_key_sample_interval(key_sample_interval)
+    {
+        if (std::is_same_v<Key_,Empty> && key_sample_interval != 0)
+            throw std::domain_error("key_sample_interval must be 0 if there are no keys");
+    }
+    RecordLogWriter_t (RecordLogWriter_t const &) = delete;
+    RecordLogWriter_t (RecordLogWriter_t &&) = delete;
+    ~RecordLogWriter_t () {
+        if (!m_is_finished && std::uncaught_exceptions() == m_uncaught_exceptions)
+            finish();
+    }
+
+    RecordLogWriter_t &operator = (RecordLogWriter_t const &) = delete;
+    RecordLogWriter_t &operator = (RecordLogWriter_t &&) = delete;
+
+    size_t record_count () const { return m_offsets.size(); }
+    size_t key_sample_interval () const { return m_key_sample_interval; }
+
+    template <typename T_>
+    void append (T_ const &record) {
+        if (is_key_sampled(m_offsets.size()))
+            throw std::domain_error("record " + std::to_string(m_offsets.size()) + " must be appended with its key, since it's a key sample");
+        append_record(record);
+    }
+    template <typename T_>
+    void append (T_ const &record, Key_ const &key) {
+        if (is_key_sampled(m_offsets.size()))
+            m_key_samples << m_encoding.out(key);
+        append_record(record);
+    }
+
+    // Writes the index.  No more records can be appended after this.
+    void finish () {
+        if (m_is_finished)
+            throw std::domain_error("RecordLogWriter_t::finish was already called");
+        m_is_finished = true;
+
+        auto offsets_offset = m_size;
+        write_bin_block(m_out, bin_lil_e, m_offsets.data(), m_offsets.size());
+        auto key_samples_offset = offsets_offset + m_offsets.size()*sizeof(uint64_t);
+        m_out.write(reinterpret_cast<typename Ostream_::char_type const *>(m_key_samples.bytes().data()), m_key_samples.size());
+        m_out << bin_lil_e.out(uint64_t(m_offsets.size()))
+              << bin_lil_e.out(uint64_t(m_key_sample_interval))
+              << bin_lil_e.out(offsets_offset)
+              << bin_lil_e.out(uint64_t(key_samples_offset));
+        m_out.write(reinterpret_cast<typename Ostream_::char_type const *>(RECORD_LOG_MAGIC), sizeof(RECORD_LOG_MAGIC));
+    }
+
+private:
+
+    bool is_key_sampled (size_t record_index) const {
+        return m_key_sample_interval != 0 && record_index % m_key_sample_interval == 0;
+    }
+
+    template <typename T_>
+    void append_record (T_ const &record) {
+        if (m_is_finished)
+            throw std::domain_error("can't append to a RecordLogWriter_t after finish was called");
+        // The length has to be written first, so the record is encoded into a buffer that's reused for each one.
+        m_record.clear();
+        m_record << m_encoding.out(record);
+        m_offsets.push_back(m_size);
+        m_out << bin_lil_e.out(uint64_t(m_record.size()));
+        m_out.write(reinterpret_cast<typename Ostream_::char_type const *>(m_record.bytes().data()), m_record.size());
+        m_size += sizeof(uint64_t) + m_record.size();
+    }
+
+    Ostream_ &m_out;
+    Encoding_ m_encoding;
+    size_t m_key_sample_interval;
+    std::vector<uint64_t> m_offsets;
+    uint64_t m_size = 0;
+    ByteWriter m_record;
+    ByteWriter m_key_samples;
+    bool m_is_finished = false;
+    // The number of exceptions in flight upon construction, so that the destructor can tell if it's unwinding.
+    int m_uncaught_exceptions = std::uncaught_exceptions();
+};
+
+// Reads a record log (as written by RecordLogWriter_t) in place, e.g. from a MappedFile, so the bytes must outlive
+// this.  Individual records can be read via read (which is const, so several threads can use the same reader), or
+// in sequence via seek and read_next.  Throws std::runtime_error if the log is malformed.
+template <typename Encoding_, typename Key_ = Empty>
+class RecordLogReader_t {
+public:
+
+    RecordLogReader_t (Range_t<std::byte const *> const &log, Encoding_ const &enc)
+        :   m_log(log)
+        ,   m_encoding(enc)
+    {
+        auto log_size = size_t(m_log.size());
+        if (log_size < RECORD_LOG_TRAILER_SIZE)
+            throw std::runtime_error("record log is too small to have a trailer");
+        auto trailer = m_log.end() - RECORD_LOG_TRAILER_SIZE;
+        if (std::memcmp(trailer + 4*sizeof(uint64_t), RECORD_LOG_MAGIC, sizeof(RECORD_LOG_MAGIC)) != 0)
+            throw std::runtime_error("record log has the wrong magic number");
+        m_record_count = load_lil_word(trailer);
+        m_key_sample_interval = load_lil_word(trailer + sizeof(uint64_t));
+        m_offsets_offset = load_lil_word(trailer + 2*sizeof(uint64_t));
+        auto key_samples_offset = load_lil_word(trailer + 3*sizeof(uint64_t));
+        // Check these in an order such that none of them can overflow.
+        auto index_end = log_size - RECORD_LOG_TRAILER_SIZE;
+        if (m_offsets_offset > index_end ||
+            m_record_count > (index_end - m_offsets_offset) / sizeof(uint64_t) ||
+            key_samples_offset != m_offsets_offset + m_record_count*sizeof(uint64_t))
+        {
+            throw std::runtime_error("record log has an invalid trailer");
+        }
+
+        if constexpr (!std::is_same_v<Key_,Empty>) {
+            if (m_key_sample_interval != 0) {
+                ByteReader in(Range_t<std::byte const *>(m_log.begin() + key_samples_offset, m_log.begin() + index_end));
+                auto sample_count = (m_record_count + m_key_sample_interval - 1) / m_key_sample_interval;
+                m_key_samples.reserve(unverified_reserve_count<Key_>(sample_count, size_t(in.range().size())));
+                for (size_t i = 0; i < sample_count && in.good(); ++i)
+                    m_key_samples.push_back(read_value<Key_>(in, m_encoding));
+                if (in.fail() || !in.range().empty())
+                    throw std::runtime_error("record log has invalid key samples");
+            }
+        }
+    }
+
+    size_t record_count () const { return m_record_count; }
+    size_t key_sample_interval () const { return m_key_sample_interval; }
+    std::vector<Key_> const &key_samples () const { return m_key_samples; }
+
+    // Returns the encoding of the given record (without its length).  This is O(1).
+    Range_t<std::byte const *> record_bytes (size_t record_index) const {
+        if (record_index >= m_record_count)
+            throw std::out_of_range("record index " + std::to_string(record_index) + " is out of range; record count is " + std::to_string(m_record_count));
+        auto offset = load_lil_word(m_log.begin() + m_offsets_offset + record_index*sizeof(uint64_t));
+        if (offset > m_offsets_offset || m_offsets_offset - offset < sizeof(uint64_t))
+            throw std::runtime_error("record log has an invalid offset for record " + std::to_string(record_index));
+        auto length = load_lil_word(m_log.begin() + offset);
+        if (length > m_offsets_offset - offset - sizeof(uint64_t))
+            throw std::runtime_error("record log has an invalid length for record " + std::to_string(record_index));
+        auto begin = m_log.begin() + offset + sizeof(uint64_t);
+        return Range_t<std::byte const *>(begin, begin + length);
+    }
+
+    // Decodes the given record, which must be exactly the encoding of a T_.
+    template <typename T_>
+    T_ read (size_t record_index) const {
+        ByteReader in(record_bytes(record_index));
+        auto retval = read_value<T_>(in, m_encoding);
+        if (in.fail())
+            throw std::runtime_error("failed to decode record " + std::to_string(record_index));
+        if (!in.range().empty())
+            throw std::runtime_error("record " + std::to_string(record_index) + " has " + std::to_string(in.range().size()) + " byte(s) left over after it was read");
+        return retval;
+    }
+
+    //
+    // Sequential access.
+    //
+
+    // The index of the record that read_next will read.
+    size_t position () const { return m_position; }
+    bool is_at_end () const { return m_position >= m_record_count; }
+    // record_index can be at most record_count(), which is the end.
+    void seek (size_t record_index) {
+        if (record_index > m_record_count)
+            throw std::out_of_range("record index " + std::to_string(record_index) + " is out of range; record count is " + std::to_string(m_record_count));
+        m_position = record_index;
+    }
+    template <typename T_>
+    T_ read_next () {
+        auto retval = read<T_>(m_position);
+        ++m_position;
+        return retval;
+    }
+
+    // Seeks to the first record that could have a key >= the given key, according to the key samples, and returns
+    // its index.  The records before it all have keys < the given key, so if there's a record with that key, it's
+    // at most key_sample_interval() records further on.  If there are no key samples, this seeks to the start.
+    size_t seek_to_key (Key_ const &key) {
+        static_assert(!std::is_same_v<Key_,Empty>, "seek_to_key requires a Key_ type");
+        auto it = std::lower_bound(m_key_samples.begin(), m_key_samples.end(), key);
+        m_position = it == m_key_samples.begin() ? 0 : size_t(it - m_key_samples.begin() - 1) * m_key_sample_interval;
+        return m_position;
+    }
+
+private:
+
+    Range_t<std::byte const *> m_log;
+    Encoding_ m_encoding;
+    size_t m_record_count;
+    size_t m_key_sample_interval;
+    size_t m_offsets_offset;
+    std::vector<Key_> m_key_samples;
+    size_t m_position = 0;
+};
+
+} // end namespace lvd
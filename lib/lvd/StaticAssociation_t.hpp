@@ -4,6 +4,7 @@
 
 #include "lvd/FiLoc.hpp"
 #include <stdexcept>
+#include <tuple>
 
 namespace lvd {
 
@@ -0,0 +1,57 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace lvd {
+
+//
+// Helpers for deserializing associative containers (std::map, std::set, std::unordered_map, std::unordered_set),
+// which are shared by the ReadInPlace_t and DeserializeTo_t stacks.
+//
+
+template <typename Container_, typename = void>
+struct is_associative_container_ : public std::false_type { };
+
+template <typename Container_>
+struct is_associative_container_<Container_,std::void_t<typename Container_::key_type>> : public std::true_type { };
+
+// Is true iff Container_ is an associative container, i.e. sorted (e.g. std::map) or hashed (e.g. std::unordered_map).
+template <typename Container_>
+inline bool constexpr is_associative_container_v = is_associative_container_<Container_>::value;
+
+template <typename Container_, typename = void>
+struct is_ordered_associative_container_ : public std::false_type { };
+
+template <typename Container_>
+struct is_ordered_associative_container_<Container_,std::void_t<typename Container_::key_compare>> : public std::true_type { };
+
+// Is true iff Container_ is a sorted associative container (e.g. std::map or std::set), as opposed to a hashed one.
+template <typename Container_>
+inline bool constexpr is_ordered_associative_container_v = is_ordered_associative_container_<Container_>::value;
+
+// Prepares dest (which must be empty) for size elements to be inserted via emplace_in_serialized_order.  For hashed
+// containers, this pre-sizes the bucket array so that it isn't rehashed repeatedly as the elements are inserted.
+// The caller must have limited size to what it's safe to allocate for up front (see unverified_reserve_count).
+template <typename Container_>
+void reserve_associative_container (Container_ &dest, size_t size) {
+    if constexpr (!is_ordered_associative_container_v<Container_>)
+        dest.reserve(size);
+}
+
+// Inserts an element into dest, where the elements are being deserialized in the order they were serialized in.
+// Sorted containers are serialized by iterating over them, so each element belongs at the end, and hinting that
+// makes each insertion amortized O(1) instead of O(log n).  The hint is only a hint, so out-of-order (e.g. corrupt)
+// input is still handled correctly, just more slowly.
+template <typename Container_, typename Value_>
+void emplace_in_serialized_order (Container_ &dest, Value_ &&value) {
+    if constexpr (is_ordered_associative_container_v<Container_>)
+        dest.emplace_hint(dest.end(), std::forward<Value_>(value));
+    else
+        dest.emplace(std::forward<Value_>(value));
+}
+
+} // end namespace lvd
@@ -0,0 +1,111 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "lvd/endian.hpp"
+
+namespace lvd {
+
+//
+// Bit-packing of unsigned integers.  count values of bit_width bits each (where 0 <= bit_width <= 64) are packed
+// into a little-endian bit stream, i.e. value i occupies bits [i*bit_width, (i+1)*bit_width), where bit k is bit
+// k%8 of byte k/8.  The packed form is independent of the machine's endianness.
+//
+
+// Returns the number of bits needed to represent x, i.e. 0 for 0, 1 for 1, 2 for 2 and 3, etc.
+inline size_t constexpr bit_width_of (uint64_t x) {
+    return x == 0 ? 0 : 64 - size_t(__builtin_clzll(x));
+}
+
+// Returns the number of bytes that pack_bits produces.
+inline size_t constexpr bit_packed_size_of (size_t count, size_t bit_width) {
+    return (count*bit_width + 7) / 8;
+}
+
+// The number of bytes past bit_packed_size_of(count, bit_width) that the buffers given to pack_bits and
+// unpack_bits must have, so that every value can be accessed with one whole-word load or store (plus one byte
+// for values that straddle a word).
+inline size_t constexpr BIT_PACKING_PADDING = 9;
+
+inline uint64_t load_lil_word (std::byte const *src) {
+    uint64_t word;
+    std::memcpy(&word, src, sizeof(word));
+    if constexpr (MACHINE_ENDIANNESS != Endianness::LIL)
+        swap_byte_order_of(word);
+    return word;
+}
+
+inline void store_lil_word (uint64_t word, std::byte *dest) {
+    if constexpr (MACHINE_ENDIANNESS != Endianness::LIL)
+        swap_byte_order_of(word);
+    std::memcpy(dest, &word, sizeof(word));
+}
+
+inline uint64_t constexpr low_bit_mask (size_t bit_width) {
+    return bit_width >= 64 ? ~uint64_t(0) : (uint64_t(1) << bit_width) - 1;
+}
+
+// Packs the low bit_width bits of each of the count values into dest, which must have
+// bit_packed_size_of(count, bit_width) + BIT_PACKING_PADDING bytes.
+inline void pack_bits (uint64_t const *values, size_t count, size_t bit_width, std::byte *dest) {
+    std::fill(dest, dest + bit_packed_size_of(count, bit_width) + BIT_PACKING_PADDING, std::byte{0});
+    auto mask = low_bit_mask(bit_width);
+    for (size_t i = 0; i < count; ++i) {
+        auto offset = i*bit_width;
+        auto word = dest + offset/8;
+        auto shift = offset%8;
+        auto value = values[i] & mask;
+        store_lil_word(load_lil_word(word) | (value << shift), word);
+        if (shift + bit_width > 64)
+            word[8] |= std::byte(value >> (64 - shift));
+    }
+}
+
+// Inverse of pack_bits.  src must have bit_packed_size_of(count, bit_width) + BIT_PACKING_PADDING bytes, though
+// the padding bytes can have any content.  Each value is extracted independently of the others (there's no
+// loop-carried state), so the compiler is free to unroll and vectorize this.
+inline void unpack_bits (std::byte const *src, size_t count, size_t bit_width, uint64_t *dest) {
+    auto mask = low_bit_mask(bit_width);
+    for (size_t i = 0; i < count; ++i) {
+        auto offset = i*bit_width;
+        auto word = src + offset/8;
+        auto shift = offset%8;
+        auto value = load_lil_word(word) >> shift;
+        if (shift + bit_width > 64)
+            value |= uint64_t(word[8]) << (64 - shift);
+        dest[i] = value & mask;
+    }
+}
+
+//
+// Bitmaps, which are bit-packed sequences of bools, i.e. with bit_width 1.  Bit i (bit i%8 of byte i/8) is the ith
+// bool, and the unused high bits of the last byte are 0.
+//
+
+// Returns the number of bytes in a bitmap of count bools.
+inline size_t constexpr bitmap_size_of (size_t count) {
+    return (count + 7) / 8;
+}
+
+// Clears the unused high bits of the last byte of a bitmap of count bools, e.g. after reading it from untrusted input.
+inline void clear_unused_bitmap_bits (std::byte *bitmap, size_t count) {
+    if (count % 8 != 0)
+        bitmap[count/8] &= std::byte((1u << (count % 8)) - 1);
+}
+
+// Calls function(i) for each i in [0, count) for which bit i of the bitmap is set, in increasing order.  The bitmap
+// must have bitmap_size_of(count) bytes plus 8 bytes of 0 padding, and its unused bits must be 0.  This scans a
+// 64-bit word at a time, so runs of unset bits are skipped quickly.
+template <typename Function_>
+void for_each_set_bit (std::byte const *bitmap, size_t count, Function_ const &function) {
+    for (size_t byte_index = 0; byte_index < bitmap_size_of(count); byte_index += 8) {
+        for (auto word = load_lil_word(bitmap + byte_index); word != 0; word &= word - 1)
+            function(8*byte_index + size_t(__builtin_ctzll(word)));
+    }
+}
+
+} // end namespace lvd
@@ -0,0 +1,103 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#include <array>
+#include "lvd/bitpack.hpp"
+#include "lvd/crc32c.hpp"
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define LVD_CRC32C_SSE42 1
+#include <nmmintrin.h>
+#endif
+
+namespace lvd {
+
+namespace {
+
+// The Castagnoli polynomial, bit-reversed (since the CRC is computed least significant bit first).
+uint32_t constexpr CRC32C_POLYNOMIAL = 0x82F63B78;
+
+// TABLES[k][b] is the CRC of byte b followed by k 0 bytes, so that 8 bytes can be processed with 8 independent
+// table lookups (i.e. slicing-by-8) instead of 8 dependent ones.
+using Crc32cTables = std::array<std::array<uint32_t,256>,8>;
+
+Crc32cTables make_crc32c_tables () {
+    Crc32cTables tables;
+    for (uint32_t b = 0; b < 256; ++b) {
+        auto crc = b;
+        for (int i = 0; i < 8; ++i)
+            crc = (crc >> 1) ^ ((crc & 1) ? CRC32C_POLYNOMIAL : 0);
+        tables[0][b] = crc;
+    }
+    for (size_t k = 1; k < 8; ++k) {
+        for (size_t b = 0; b < 256; ++b)
+            tables[k][b] = (tables[k-1][b] >> 8) ^ tables[0][tables[k-1][b] & 0xFF];
+    }
+    return tables;
+}
+
+Crc32cTables const &crc32c_tables () {
+    static Crc32cTables const TABLES = make_crc32c_tables();
+    return TABLES;
+}
+
+// These operate on the internal (i.e. inverted) form of the CRC.
+
+uint32_t update_crc32c_portable (uint32_t crc, std::byte const *data, size_t size) {
+    auto const &tables = crc32c_tables();
+    for ( ; size >= 8; data += 8, size -= 8) {
+        auto word = load_lil_word(data) ^ crc;
+        crc = tables[7][word & 0xFF] ^ tables[6][(word >> 8) & 0xFF] ^ tables[5][(word >> 16) & 0xFF] ^ tables[4][(word >> 24) & 0xFF]
+            ^ tables[3][(word >> 32) & 0xFF] ^ tables[2][(word >> 40) & 0xFF] ^ tables[1][(word >> 48) & 0xFF] ^ tables[0][word >> 56];
+    }
+    for ( ; size > 0; ++data, --size)
+        crc = (crc >> 8) ^ tables[0][(crc ^ uint8_t(*data)) & 0xFF];
+    return crc;
+}
+
+#if LVD_CRC32C_SSE42
+__attribute__((target("sse4.2")))
+uint32_t update_crc32c_sse42 (uint32_t crc, std::byte const *data, size_t size) {
+    uint64_t crc64 = crc;
+    for ( ; size >= 8; data += 8, size -= 8) {
+        uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+    }
+    crc = uint32_t(crc64);
+    for ( ; size > 0; ++data, --size)
+        crc = _mm_crc32_u8(crc, uint8_t(*data));
+    return crc;
+}
+#endif
+
+using UpdateCrc32c = uint32_t (*)(uint32_t crc, std::byte const *data, size_t size);
+
+UpdateCrc32c select_update_crc32c () {
+#if LVD_CRC32C_SSE42
+    if (__builtin_cpu_supports("sse4.2"))
+        return update_crc32c_sse42;
+#endif
+    return update_crc32c_portable;
+}
+
+UpdateCrc32c update_crc32c () {
+    static UpdateCrc32c const UPDATE = select_update_crc32c();
+    return UPDATE;
+}
+
+} // end of anonymous namespace
+
+uint32_t crc32c (void const *data, size_t size, uint32_t crc) {
+    return ~update_crc32c()(~crc, static_cast<std::byte const *>(data), size);
+}
+
+uint32_t crc32c_portable (void const *data, size_t size, uint32_t crc) {
+    return ~update_crc32c_portable(~crc, static_cast<std::byte const *>(data), size);
+}
+
+bool crc32c_is_hardware_accelerated () {
+    return update_crc32c() != update_crc32c_portable;
+}
+
+} // end namespace lvd
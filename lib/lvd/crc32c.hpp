@@ -0,0 +1,32 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "lvd/Range_t.hpp"
+
+namespace lvd {
+
+//
+// CRC32C (i.e. CRC-32 with the Castagnoli polynomial, as used by iSCSI, ext4, etc.), e.g. for checking the
+// integrity of encoded data.  On x86_64 CPUs that support SSE4.2, this uses its crc32 instruction (which is
+// selected at runtime, so liblvd doesn't have to be built with -msse4.2), and otherwise a table-driven
+// slicing-by-8 implementation.
+//
+
+// Returns the CRC32C of the size bytes starting at data, continuing from crc, which is the CRC32C of any
+// preceding bytes (and 0 if there are none), so that crc32c(b, crc32c(a)) is the CRC32C of a followed by b.
+uint32_t crc32c (void const *data, size_t size, uint32_t crc = 0);
+
+inline uint32_t crc32c (Range_t<std::byte const *> const &bytes, uint32_t crc = 0) {
+    return crc32c(bytes.begin(), size_t(bytes.size()), crc);
+}
+
+// Same as crc32c, but always uses the table-driven implementation.  This is mainly for testing.
+uint32_t crc32c_portable (void const *data, size_t size, uint32_t crc = 0);
+
+// Returns true iff crc32c uses a hardware instruction on this CPU.
+bool crc32c_is_hardware_accelerated ();
+
+} // end namespace lvd
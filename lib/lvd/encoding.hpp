@@ -5,8 +5,11 @@
 #include <array>
 #include <istream>
 #include "lvd/endian.hpp"
+#include "lvd/fixed_layout.hpp"
 #include <ostream>
 #include <string>
+#include <type_traits>
+#include "lvd/varint.hpp"
 
 namespace lvd {
 
@@ -56,6 +59,73 @@ inline std::ostream &operator << (std::ostream &out, TypeEncoding x) {
     return out << as_string(x);
 }
 
+// Enum for specifying how integers (including container sizes) are encoded in binary encodings.
+enum class IntEncoding : uint8_t {
+    FIXED = 0,  // Integers are encoded using their full width, e.g. 8 bytes for a size_t.
+    VARINT,     // Integers of size > 1 are LEB128 varint-encoded, zigzag-encoded first if signed.  See lvd/varint.hpp.
+
+    __LOWEST__ = FIXED,
+    __HIGHEST__ = VARINT
+};
+
+inline std::string const &as_string (IntEncoding x) {
+    auto constexpr COUNT = size_t(IntEncoding::__HIGHEST__) - size_t(IntEncoding::__LOWEST__) + 1;
+    static std::array<std::string,COUNT> const TABLE{
+        "FIXED",
+        "VARINT",
+    };
+    return TABLE.at(size_t(x));
+}
+
+inline std::ostream &operator << (std::ostream &out, IntEncoding x) {
+    return out << as_string(x);
+}
+
+// Enum for specifying whether composite values are framed in binary encodings.
+enum class FramingEncoding : uint8_t {
+    UNFRAMED = 0,       // Values are encoded back to back, so a value can only be skipped by decoding it.
+    LENGTH_PREFIXED,    // Each composite value (see is_bin_framed_type_v) is prefixed with the byte length of its
+                        // encoding, using the IntEncoding, so that it can be skipped without decoding it.
+
+    __LOWEST__ = UNFRAMED,
+    __HIGHEST__ = LENGTH_PREFIXED
+};
+
+inline std::string const &as_string (FramingEncoding x) {
+    auto constexpr COUNT = size_t(FramingEncoding::__HIGHEST__) - size_t(FramingEncoding::__LOWEST__) + 1;
+    static std::array<std::string,COUNT> const TABLE{
+        "UNFRAMED",
+        "LENGTH_PREFIXED",
+    };
+    return TABLE.at(size_t(x));
+}
+
+inline std::ostream &operator << (std::ostream &out, FramingEncoding x) {
+    return out << as_string(x);
+}
+
+// Enum for specifying how floating point values are formatted in a text encoding.
+enum class FloatEncoding : uint8_t {
+    FULL_PRECISION = 0, // Scientific notation with max_digits10 digits after the decimal point, e.g. 1.250000000e+00
+    SHORTEST,           // The shortest representation that reads back as the same value, e.g. 1.25
+
+    __LOWEST__ = FULL_PRECISION,
+    __HIGHEST__ = SHORTEST
+};
+
+inline std::string const &as_string (FloatEncoding x) {
+    auto constexpr COUNT = size_t(FloatEncoding::__HIGHEST__) - size_t(FloatEncoding::__LOWEST__) + 1;
+    static std::array<std::string,COUNT> const TABLE{
+        "FULL_PRECISION",
+        "SHORTEST",
+    };
+    return TABLE.at(size_t(x));
+}
+
+inline std::ostream &operator << (std::ostream &out, FloatEncoding x) {
+    return out << as_string(x);
+}
+
 
 // This type facilitates >> syntax.
 template <typename T_, typename Encoding_>
@@ -111,14 +181,53 @@ template <typename CharT_, typename Traits_, typename T_, typename Encoding_>
 std::basic_ostream<CharT_,Traits_> &operator<< (std::basic_ostream<CharT_,Traits_> &out, Out_t<T_,Encoding_> const &o);
 
 
-// Binary encoding with endianness state variable.
-// TODO: Make one where Endianness is a template param.
+// Enum for specifying if the endianness of a binary encoding is fixed at compile time or not.  BIG and LIL
+// have the same values as in Endianness.
+enum class EndiannessEncoding : uint8_t {
+    BIG = 0,    // Statically big-endian
+    LIL,        // Statically little-endian
+    RUNTIME,    // The endianness is a runtime value, e.g. for files whose byte order is only known once they're read.
+
+    __LOWEST__ = BIG,
+    __HIGHEST__ = RUNTIME
+};
+
+static_assert(uint8_t(EndiannessEncoding::BIG) == uint8_t(Endianness::BIG));
+static_assert(uint8_t(EndiannessEncoding::LIL) == uint8_t(Endianness::LIL));
+
+inline std::string const &as_string (EndiannessEncoding x) {
+    auto constexpr COUNT = size_t(EndiannessEncoding::__HIGHEST__) - size_t(EndiannessEncoding::__LOWEST__) + 1;
+    static std::array<std::string,COUNT> const TABLE{
+        "BIG",
+        "LIL",
+        "RUNTIME",
+    };
+    return TABLE.at(size_t(x));
+}
+
+inline std::ostream &operator << (std::ostream &out, EndiannessEncoding x) {
+    return out << as_string(x);
+}
+
+// Binary encoding.  If ENDIANNESS_ENCODING_ is RUNTIME, then the endianness is a state variable, otherwise it's
+// static, meaning that when it matches the machine's endianness, reading and writing values compiles to plain
+// copies, with no byte-swapping branches at all.
 // TODO: Maybe turn TYPE_ENCODING_ template param into a runtime variable.
-template <TypeEncoding TYPE_ENCODING_>
+template <
+    TypeEncoding TYPE_ENCODING_,
+    IntEncoding INT_ENCODING_ = IntEncoding::FIXED,
+    EndiannessEncoding ENDIANNESS_ENCODING_ = EndiannessEncoding::RUNTIME,
+    FramingEncoding FRAMING_ENCODING_ = FramingEncoding::UNFRAMED
+>
 class BinEncoding_t {
 public:
 
+    // Constructor for runtime endianness.
+    template <EndiannessEncoding E_ = ENDIANNESS_ENCODING_, typename = std::enable_if_t<E_ == EndiannessEncoding::RUNTIME>>
     BinEncoding_t (Endianness endianness) : m_endianness(endianness) { }
+    // Constructor for static endianness.
+    template <EndiannessEncoding E_ = ENDIANNESS_ENCODING_, typename = std::enable_if_t<E_ != EndiannessEncoding::RUNTIME>>
+    constexpr BinEncoding_t () : m_endianness(Endianness(ENDIANNESS_ENCODING_)) { }
 
     // For use in >> input syntax.  Must include lvd/read_bin.hpp for this to link.
     template <typename T_>
@@ -130,42 +239,142 @@ public:
     Out_t<T_,BinEncoding_t> out (T_ const &src_val) const {
         return Out_t<T_,BinEncoding_t>(src_val, *this);
     }
-    // For reading from a stream and producing a value, instead of populating it in-place.
-    // Must include lvd/read.hpp for this to link.
-    template <typename T_, typename CharT_, typename Traits_>
-    T_ read (std::basic_istream<CharT_,Traits_> &in) const;
+    // For reading from a stream (std::basic_istream or ByteReader) and producing a value, instead of
+    // populating it in-place.  Must include lvd/read.hpp for this to link.
+    template <typename T_, typename Istream_>
+    T_ read (Istream_ &in) const;
+
+    // These are static so that they can be used in `if constexpr` even when called through a reference.
+    static constexpr TypeEncoding type_encoding () { return TYPE_ENCODING_; }
+    static constexpr IntEncoding int_encoding () { return INT_ENCODING_; }
+    static constexpr EndiannessEncoding endianness_encoding () { return ENDIANNESS_ENCODING_; }
+    static constexpr FramingEncoding framing_encoding () { return FRAMING_ENCODING_; }
+    // Returns true iff the endianness is static and is the machine's endianness, so no byte-swapping is needed.
+    static constexpr bool is_statically_machine_endian () {
+        return ENDIANNESS_ENCODING_ != EndiannessEncoding::RUNTIME && Endianness(ENDIANNESS_ENCODING_) == MACHINE_ENDIANNESS;
+    }
 
-    constexpr TypeEncoding type_encoding () const { return TYPE_ENCODING_; }
-    Endianness endianness () const { return m_endianness; }
+    constexpr Endianness endianness () const {
+        if constexpr (ENDIANNESS_ENCODING_ != EndiannessEncoding::RUNTIME)
+            return Endianness(ENDIANNESS_ENCODING_);
+        else
+            return m_endianness;
+    }
 
     template <TypeEncoding OTHER_TYPE_ENCODING_>
-    BinEncoding_t<OTHER_TYPE_ENCODING_> with_type_encoding () const {
-        return BinEncoding_t<OTHER_TYPE_ENCODING_>(this->endianness());
+    BinEncoding_t<OTHER_TYPE_ENCODING_,INT_ENCODING_,ENDIANNESS_ENCODING_,FRAMING_ENCODING_> with_type_encoding () const {
+        return with_encodings<OTHER_TYPE_ENCODING_,INT_ENCODING_,FRAMING_ENCODING_>();
+    }
+
+    template <IntEncoding OTHER_INT_ENCODING_>
+    BinEncoding_t<TYPE_ENCODING_,OTHER_INT_ENCODING_,ENDIANNESS_ENCODING_,FRAMING_ENCODING_> with_int_encoding () const {
+        return with_encodings<TYPE_ENCODING_,OTHER_INT_ENCODING_,FRAMING_ENCODING_>();
+    }
+
+    template <FramingEncoding OTHER_FRAMING_ENCODING_>
+    BinEncoding_t<TYPE_ENCODING_,INT_ENCODING_,ENDIANNESS_ENCODING_,OTHER_FRAMING_ENCODING_> with_framing_encoding () const {
+        return with_encodings<TYPE_ENCODING_,INT_ENCODING_,OTHER_FRAMING_ENCODING_>();
     }
 
     // For use when eliding type info for nested elements, where the type info is known from context.
     decltype(auto) with_demoted_type_encoding () const {
         if constexpr (TYPE_ENCODING_ == TypeEncoding::INCLUDED)
-            return BinEncoding_t<TypeEncoding::CONDITIONAL>(this->endianness());
+            return with_encodings<TypeEncoding::CONDITIONAL,INT_ENCODING_,FRAMING_ENCODING_>();
         else
             return *this;
     }
 
 private:
 
+    template <TypeEncoding OTHER_TYPE_ENCODING_, IntEncoding OTHER_INT_ENCODING_, FramingEncoding OTHER_FRAMING_ENCODING_>
+    BinEncoding_t<OTHER_TYPE_ENCODING_,OTHER_INT_ENCODING_,ENDIANNESS_ENCODING_,OTHER_FRAMING_ENCODING_> with_encodings () const {
+        if constexpr (ENDIANNESS_ENCODING_ != EndiannessEncoding::RUNTIME)
+            return BinEncoding_t<OTHER_TYPE_ENCODING_,OTHER_INT_ENCODING_,ENDIANNESS_ENCODING_,OTHER_FRAMING_ENCODING_>();
+        else
+            return BinEncoding_t<OTHER_TYPE_ENCODING_,OTHER_INT_ENCODING_,ENDIANNESS_ENCODING_,OTHER_FRAMING_ENCODING_>(m_endianness);
+    }
+
+    // This is only used if ENDIANNESS_ENCODING_ is RUNTIME.
     Endianness m_endianness;
 };
 
-// Some convenient default singleton objects.
-inline static BinEncoding_t<TypeEncoding::EXCLUDED> const bin_big_e = BinEncoding_t<TypeEncoding::EXCLUDED>(Endianness::BIG);
-inline static BinEncoding_t<TypeEncoding::EXCLUDED> const bin_lil_e = BinEncoding_t<TypeEncoding::EXCLUDED>(Endianness::LIL);
-inline static BinEncoding_t<TypeEncoding::EXCLUDED> const bin_machine_e = BinEncoding_t<TypeEncoding::EXCLUDED>(machine_endianness());
-inline static BinEncoding_t<TypeEncoding::INCLUDED> const tbin_big_e = BinEncoding_t<TypeEncoding::INCLUDED>(Endianness::BIG);
-inline static BinEncoding_t<TypeEncoding::INCLUDED> const tbin_lil_e = BinEncoding_t<TypeEncoding::INCLUDED>(Endianness::LIL);
-inline static BinEncoding_t<TypeEncoding::INCLUDED> const tbin_machine_e = BinEncoding_t<TypeEncoding::INCLUDED>(machine_endianness());
+// Forward declarations for is_bin_framed_type_v.
+struct Empty;
+template <typename T_> class Type_t;
+
+// Is true iff T_ is a composite type, i.e. anything other than the builtin scalars, Empty, and Type_t, so that
+// under FramingEncoding::LENGTH_PREFIXED, its values are length-framed.  Specialize this to be false for types
+// that are only a means of writing/reading other values (e.g. IndexedTuple_t), and so aren't values on their own.
+template <typename T_>
+inline bool constexpr is_bin_framed_type_v = !is_endiannated_type_v<T_> && !std::is_enum_v<T_>;
+
+template <>
+inline bool constexpr is_bin_framed_type_v<Empty> = false;
+
+template <typename T_>
+inline bool constexpr is_bin_framed_type_v<Type_t<T_>> = false;
+
+// Is true iff Encoding_ prefixes each value of T_ with the byte length of its encoding.
+template <typename T_, typename Encoding_>
+inline bool constexpr is_length_framed_v = false;
+
+template <typename T_, auto... Params_>
+inline bool constexpr is_length_framed_v<T_,BinEncoding_t<Params_...>> =
+    BinEncoding_t<Params_...>::framing_encoding() == FramingEncoding::LENGTH_PREFIXED &&
+    is_bin_framed_type_v<T_>;
+
+// LeafPredicate_ for is_fixed_layout_v which accepts the leaf types that Encoding_ encodes as their raw in-memory
+// bytes (modulo byte order).  bool is excluded since reading arbitrary bytes into a bool is undefined, as are
+// integers that are varint-encoded.
+template <typename Encoding_>
+struct BinBlockEncodableLeaf {
+    template <typename T_>
+    static bool constexpr value =
+        !std::is_same_v<T_,bool> &&
+        !(Encoding_::int_encoding() == IntEncoding::VARINT && is_varint_encodable_v<T_>);
+};
+
+// Is true iff Encoding_ encodes each value of T_ as its raw in-memory bytes (modulo byte order), so that a contiguous
+// array of them can be written/read as a single block, followed by a bulk byte-swap (of each leaf) if needed.  Besides
+// the endiannated types themselves, this includes fixed-layout aggregates of them (see lvd/fixed_layout.hpp), e.g.
+// std::pair<int32_t,float>, as long as Encoding_ doesn't add anything to them, i.e. type info or a length frame.
+template <typename T_, typename Encoding_>
+inline bool constexpr is_bin_block_encodable_v = false;
+
+template <typename T_, auto... Params_>
+inline bool constexpr is_bin_block_encodable_v<T_,BinEncoding_t<Params_...>> =
+    is_fixed_layout_v<T_,BinBlockEncodableLeaf<BinEncoding_t<Params_...>>> &&
+    (
+        is_endiannated_type_v<T_> ||
+        (BinEncoding_t<Params_...>::type_encoding() != TypeEncoding::INCLUDED && !is_length_framed_v<T_,BinEncoding_t<Params_...>>)
+    );
+
+// Convenient aliases for statically-endianned binary encodings.
+template <TypeEncoding TYPE_ENCODING_, IntEncoding INT_ENCODING_ = IntEncoding::FIXED, FramingEncoding FRAMING_ENCODING_ = FramingEncoding::UNFRAMED>
+using BinBigEncoding_t = BinEncoding_t<TYPE_ENCODING_,INT_ENCODING_,EndiannessEncoding::BIG,FRAMING_ENCODING_>;
+template <TypeEncoding TYPE_ENCODING_, IntEncoding INT_ENCODING_ = IntEncoding::FIXED, FramingEncoding FRAMING_ENCODING_ = FramingEncoding::UNFRAMED>
+using BinLilEncoding_t = BinEncoding_t<TYPE_ENCODING_,INT_ENCODING_,EndiannessEncoding::LIL,FRAMING_ENCODING_>;
+template <TypeEncoding TYPE_ENCODING_, IntEncoding INT_ENCODING_ = IntEncoding::FIXED, FramingEncoding FRAMING_ENCODING_ = FramingEncoding::UNFRAMED>
+using BinMachineEncoding_t = BinEncoding_t<TYPE_ENCODING_,INT_ENCODING_,EndiannessEncoding(MACHINE_ENDIANNESS),FRAMING_ENCODING_>;
+
+// Some convenient default singleton objects.  These all have static endianness.  For runtime endianness,
+// construct e.g. BinEncoding_t<TypeEncoding::EXCLUDED>(endianness).
+inline static BinBigEncoding_t<TypeEncoding::EXCLUDED> const bin_big_e;
+inline static BinLilEncoding_t<TypeEncoding::EXCLUDED> const bin_lil_e;
+inline static BinMachineEncoding_t<TypeEncoding::EXCLUDED> const bin_machine_e;
+inline static BinBigEncoding_t<TypeEncoding::INCLUDED> const tbin_big_e;
+inline static BinLilEncoding_t<TypeEncoding::INCLUDED> const tbin_lil_e;
+inline static BinMachineEncoding_t<TypeEncoding::INCLUDED> const tbin_machine_e;
+// `v` denotes varint-encoded integers.  Endianness then only applies to floating point values.
+inline static BinLilEncoding_t<TypeEncoding::EXCLUDED,IntEncoding::VARINT> const vbin_lil_e;
+inline static BinLilEncoding_t<TypeEncoding::INCLUDED,IntEncoding::VARINT> const tvbin_lil_e;
+// `f` denotes length-framed composite values.
+inline static BinLilEncoding_t<TypeEncoding::EXCLUDED,IntEncoding::FIXED,FramingEncoding::LENGTH_PREFIXED> const fbin_lil_e;
+inline static BinLilEncoding_t<TypeEncoding::EXCLUDED,IntEncoding::VARINT,FramingEncoding::LENGTH_PREFIXED> const fvbin_lil_e;
+inline static BinLilEncoding_t<TypeEncoding::INCLUDED,IntEncoding::VARINT,FramingEncoding::LENGTH_PREFIXED> const tfvbin_lil_e;
 
 // Human-readable text encoding.
-template <TypeEncoding TYPE_ENCODING_>
+template <TypeEncoding TYPE_ENCODING_, FloatEncoding FLOAT_ENCODING_ = FloatEncoding::FULL_PRECISION>
 class TextEncoding_t {
 public:
 
@@ -179,22 +388,29 @@ public:
     Out_t<T_,TextEncoding_t> out (T_ const &src_val) const {
         return Out_t<T_,TextEncoding_t>(src_val, *this);
     }
-    // For reading from a stream and producing a value, instead of populating it in-place.
-    // Must include lvd/read.hpp for this to link.
-    template <typename T_, typename CharT_, typename Traits_>
-    T_ read (std::basic_istream<CharT_,Traits_> &in) const;
+    // For reading from a stream (std::basic_istream or ByteReader) and producing a value, instead of
+    // populating it in-place.  Must include lvd/read.hpp for this to link.
+    template <typename T_, typename Istream_>
+    T_ read (Istream_ &in) const;
 
-    constexpr TypeEncoding type_encoding () const { return TYPE_ENCODING_; }
+    // These are static so that they can be used in `if constexpr` even when called through a reference.
+    static constexpr TypeEncoding type_encoding () { return TYPE_ENCODING_; }
+    static constexpr FloatEncoding float_encoding () { return FLOAT_ENCODING_; }
 
     template <TypeEncoding OTHER_TYPE_ENCODING_>
-    TextEncoding_t<OTHER_TYPE_ENCODING_> with_type_encoding () const {
-        return TextEncoding_t<OTHER_TYPE_ENCODING_>();
+    TextEncoding_t<OTHER_TYPE_ENCODING_,FLOAT_ENCODING_> with_type_encoding () const {
+        return TextEncoding_t<OTHER_TYPE_ENCODING_,FLOAT_ENCODING_>();
+    }
+
+    template <FloatEncoding OTHER_FLOAT_ENCODING_>
+    TextEncoding_t<TYPE_ENCODING_,OTHER_FLOAT_ENCODING_> with_float_encoding () const {
+        return TextEncoding_t<TYPE_ENCODING_,OTHER_FLOAT_ENCODING_>();
     }
 
     // For use when eliding type info for nested elements, where the type info is known from context.
     decltype(auto) with_demoted_type_encoding () const {
         if constexpr (TYPE_ENCODING_ == TypeEncoding::INCLUDED)
-            return TextEncoding_t<TypeEncoding::CONDITIONAL>();
+            return TextEncoding_t<TypeEncoding::CONDITIONAL,FLOAT_ENCODING_>();
         else
             return *this;
     }
@@ -204,5 +420,8 @@ public:
 // `txt` denotes a less formal value literal.
 inline static TextEncoding_t<TypeEncoding::EXCLUDED> const txt = TextEncoding_t<TypeEncoding::EXCLUDED>();
 inline static TextEncoding_t<TypeEncoding::INCLUDED> const lit = TextEncoding_t<TypeEncoding::INCLUDED>();
+// `s` denotes the shortest round-trip representation of floating point values.
+inline static TextEncoding_t<TypeEncoding::EXCLUDED,FloatEncoding::SHORTEST> const stxt = TextEncoding_t<TypeEncoding::EXCLUDED,FloatEncoding::SHORTEST>();
+inline static TextEncoding_t<TypeEncoding::INCLUDED,FloatEncoding::SHORTEST> const slit = TextEncoding_t<TypeEncoding::INCLUDED,FloatEncoding::SHORTEST>();
 
 } // end namespace lvd
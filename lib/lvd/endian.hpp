@@ -9,6 +9,10 @@
 #include <type_traits>
 #include <utility>
 
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
 namespace lvd {
 
 enum class Endianness : uint8_t {
@@ -44,6 +48,15 @@ inline Endianness constexpr machine_endianness () {
         return Endianness::LIL;
 }
 
+// Compile-time equivalent of machine_endianness(), which is usable in `if constexpr` (machine_endianness() isn't
+// actually usable in a constant expression because of the pointer cast in machine_is_big_endian()).
+#if defined(__BYTE_ORDER__)
+inline Endianness constexpr MACHINE_ENDIANNESS = __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__ ? Endianness::BIG : Endianness::LIL;
+#else
+// E.g. MSVC, which doesn't define __BYTE_ORDER__, but only targets little-endian platforms.
+inline Endianness constexpr MACHINE_ENDIANNESS = Endianness::LIL;
+#endif
+
 // Is true iff a type has endianness (arithmetic types) or is invariant under byte-order-swap (e.g. 1-byte types).
 // TODO: Use std::is_scalar_v<T_> instead
 template <typename T_>
@@ -72,6 +85,39 @@ void swap_byte_order_of (T_ &value) {
     }
 }
 
+// Swap the byte order of each of the `count` values starting at `values` (operates in-place).
+// This is the bulk analog of swap_byte_order_of, meant for contiguous arrays of values (e.g. the
+// contents of a std::vector<float>).  If SSSE3 is enabled (e.g. -mssse3 or -march=native), this
+// swaps 16 bytes per instruction using a byte shuffle; otherwise it falls back to a per-value
+// loop, which the compiler is free to auto-vectorize.
+template <typename T_, typename = std::enable_if_t<is_endiannated_type_v<T_>>>
+void swap_byte_order_of_each (T_ *values, size_t count) {
+    static_assert(sizeof(T_) == 1 || sizeof(T_) == 2 || sizeof(T_) == 4 || sizeof(T_) == 8, "can only swap_byte_order_of_each a type of size 1, 2, 4, or 8.");
+
+    if constexpr (sizeof(T_) == 1) {
+        // Nothing to do.
+    } else {
+        size_t i = 0;
+#if defined(__SSSE3__)
+        size_t constexpr VALUES_PER_BLOCK = sizeof(__m128i) / sizeof(T_);
+        __m128i mask;
+        if constexpr (sizeof(T_) == 2)
+            mask = _mm_setr_epi8(1,0, 3,2, 5,4, 7,6, 9,8, 11,10, 13,12, 15,14);
+        else if constexpr (sizeof(T_) == 4)
+            mask = _mm_setr_epi8(3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12);
+        else
+            mask = _mm_setr_epi8(7,6,5,4,3,2,1,0, 15,14,13,12,11,10,9,8);
+        for ( ; i+VALUES_PER_BLOCK <= count; i += VALUES_PER_BLOCK) {
+            auto block = reinterpret_cast<__m128i *>(values+i);
+            _mm_storeu_si128(block, _mm_shuffle_epi8(_mm_loadu_si128(block), mask));
+        }
+#endif
+        // Handle the remainder (or everything, if there's no SIMD path).
+        for ( ; i < count; ++i)
+            swap_byte_order_of(values[i]);
+    }
+}
+
 template <typename T_, typename = std::enable_if_t<is_endiannated_type_v<T_>>>
 T_ swapped_byte_order_of (T_ value) {
     swap_byte_order_of(value);
@@ -84,12 +130,18 @@ void endian_change (Endianness from, Endianness to, T_ &value) {
         swap_byte_order_of(value);
 }
 
-// Call endian_change on each element in a range (operates in-place).
+// Call endian_change on each element in a range (operates in-place).  If the range is over
+// a contiguous array (i.e. T_ is a pointer type), then swap_byte_order_of_each is used.
 template <typename T_>
 void endian_change (Endianness from, Endianness to, lvd::Range_t<T_> &value_range) {
-    if (from != to)
-        for (auto &value : value_range)
-            swap_byte_order_of(value);
+    if (from != to) {
+        if constexpr (std::is_pointer_v<T_>) {
+            swap_byte_order_of_each(value_range.begin(), size_t(value_range.size()));
+        } else {
+            for (auto &value : value_range)
+                swap_byte_order_of(value);
+        }
+    }
 }
 
 template <typename T_, typename = std::enable_if_t<is_endiannated_type_v<T_>>>
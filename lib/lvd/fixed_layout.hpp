@@ -0,0 +1,92 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include "lvd/endian.hpp"
+#include <type_traits>
+#include <utility>
+
+namespace lvd {
+
+//
+// A fixed-layout type is one whose in-memory representation is exactly the in-memory representations of its leaf
+// values, in order, without any padding, where the leaves are endiannated (i.e. arithmetic) types.  Those are the
+// endiannated types themselves, and std::array and std::pair of fixed-layout types, as long as they have no
+// padding.  Encodings which write each leaf as its raw bytes can thus write such a value, or a contiguous array of
+// them, as a single block (byte-swapping each leaf afterward if the byte order differs from the machine's).
+//
+// Note that std::tuple is never fixed-layout, since the order of its elements in memory is unspecified (and e.g.
+// libstdc++ stores them in reverse).
+//
+
+// Is true iff T_ is fixed-layout, and LeafPredicate_::template value<Leaf> is true for each of its leaf types Leaf.
+// This allows an encoding to exclude leaf types that it doesn't write as raw bytes (e.g. varint-encoded integers).
+template <typename T_, typename LeafPredicate_>
+struct is_fixed_layout_
+    :   public std::bool_constant<is_endiannated_type_v<T_> && !std::is_const_v<T_> && !std::is_volatile_v<T_> && LeafPredicate_::template value<T_>>
+{ };
+
+template <typename T_, size_t N_, typename LeafPredicate_>
+struct is_fixed_layout_<std::array<T_,N_>,LeafPredicate_>
+    :   public std::bool_constant<is_fixed_layout_<T_,LeafPredicate_>::value && sizeof(std::array<T_,N_>) == N_*sizeof(T_)>
+{ };
+
+// Returns true iff std::pair<F_,S_> is laid out as F_ immediately followed by S_.  offsetof is only defined for
+// standard-layout types, so it's only used for those.
+template <typename F_, typename S_>
+bool constexpr is_padding_free_pair () {
+    using Pair = std::pair<F_,S_>;
+    if constexpr (std::is_standard_layout_v<Pair>)
+        return offsetof(Pair, second) == sizeof(F_) && sizeof(Pair) == sizeof(F_) + sizeof(S_);
+    else
+        return false;
+}
+
+template <typename F_, typename S_, typename LeafPredicate_>
+struct is_fixed_layout_<std::pair<F_,S_>,LeafPredicate_>
+    :   public std::bool_constant<is_fixed_layout_<F_,LeafPredicate_>::value && is_fixed_layout_<S_,LeafPredicate_>::value && is_padding_free_pair<F_,S_>()>
+{ };
+
+template <typename T_, typename LeafPredicate_>
+inline bool constexpr is_fixed_layout_v = is_fixed_layout_<T_,LeafPredicate_>::value;
+
+// LeafPredicate_ for is_fixed_layout_v which accepts all leaf types.
+struct AnyLeaf {
+    template <typename T_>
+    static bool constexpr value = true;
+};
+
+//
+// Swaps the byte order of each leaf of each of the count fixed-layout values starting at values (in-place).  This
+// is the analog of swap_byte_order_of_each for fixed-layout types.
+//
+
+template <typename T_, typename = std::enable_if_t<is_endiannated_type_v<T_>>>
+void swap_byte_order_of_each_leaf (T_ *values, size_t count);
+template <typename T_, size_t N_>
+void swap_byte_order_of_each_leaf (std::array<T_,N_> *values, size_t count);
+template <typename F_, typename S_>
+void swap_byte_order_of_each_leaf (std::pair<F_,S_> *values, size_t count);
+
+template <typename T_, typename>
+void swap_byte_order_of_each_leaf (T_ *values, size_t count) {
+    swap_byte_order_of_each(values, count);
+}
+
+template <typename T_, size_t N_>
+void swap_byte_order_of_each_leaf (std::array<T_,N_> *values, size_t count) {
+    for (size_t i = 0; i < count; ++i)
+        swap_byte_order_of_each_leaf(values[i].data(), N_);
+}
+
+template <typename F_, typename S_>
+void swap_byte_order_of_each_leaf (std::pair<F_,S_> *values, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        swap_byte_order_of_each_leaf(&values[i].first, 1);
+        swap_byte_order_of_each_leaf(&values[i].second, 1);
+    }
+}
+
+} // end namespace lvd
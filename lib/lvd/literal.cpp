@@ -252,7 +252,7 @@ public:
     template <uint32_t DIGIT_>
     uint32_t digit () const {
         static_assert(DIGIT_ <= 2, "DIGIT_ must be 0, 1, or 2");
-        return (uint32_t(m_value) >> (3*DIGIT_)) & 7;
+        return (uint32_t(uint8_t(m_value)) >> (3*DIGIT_)) & 7;
     }
 
 private:
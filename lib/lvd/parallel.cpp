@@ -0,0 +1,68 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include "lvd/parallel.hpp"
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace lvd {
+
+size_t default_thread_count () {
+    return std::max(size_t(std::thread::hardware_concurrency()), size_t(1));
+}
+
+void run_in_parallel (size_t task_count, size_t thread_count, std::function<void(size_t)> const &task) {
+    if (thread_count == 0)
+        thread_count = default_thread_count();
+    thread_count = std::min(thread_count, task_count);
+
+    // There's no point in starting any threads for a single task.
+    if (thread_count <= 1) {
+        for (size_t i = 0; i < task_count; ++i)
+            task(i);
+        return;
+    }
+
+    std::atomic<size_t> next_task{0};
+    std::atomic<bool> has_failed{false};
+    std::exception_ptr first_exception;
+    std::mutex first_exception_mutex;
+    auto run_tasks = [&](){
+        while (!has_failed.load(std::memory_order_relaxed)) {
+            auto i = next_task.fetch_add(1, std::memory_order_relaxed);
+            if (i >= task_count)
+                break;
+            try {
+                task(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(first_exception_mutex);
+                if (!first_exception)
+                    first_exception = std::current_exception();
+                has_failed = true;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count-1);
+    for (size_t i = 0; i+1 < thread_count; ++i) {
+        try {
+            threads.emplace_back(run_tasks);
+        } catch (std::system_error const &) {
+            // Make do with the threads that could be started.
+            break;
+        }
+    }
+    run_tasks();
+    for (auto &thread : threads)
+        thread.join();
+
+    if (first_exception)
+        std::rethrow_exception(first_exception);
+}
+
+} // end namespace lvd
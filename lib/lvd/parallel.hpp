@@ -0,0 +1,19 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace lvd {
+
+// Returns std::thread::hardware_concurrency(), or 1 if that's unknown.
+size_t default_thread_count ();
+
+// Calls task(i) for each i in [0, task_count), using at most thread_count threads, one of which is the calling
+// thread.  A thread_count of 0 means default_thread_count().  The tasks are handed out in increasing order of i,
+// but may run in any order, and concurrently with each other.  If a task throws, then no further tasks are
+// started, and once the running tasks are done, the first exception is rethrown on the calling thread.
+void run_in_parallel (size_t task_count, size_t thread_count, std::function<void(size_t)> const &task);
+
+} // end namespace lvd
@@ -19,4 +19,16 @@ struct PopulateRandom_t<std::vector<Types_...>> {
     }
 };
 
+// std::vector<bool> elements are proxies, so they can't be populated in-place.
+template <typename Allocator_>
+struct PopulateRandom_t<std::vector<bool,Allocator_>> {
+    using Vector = std::vector<bool,Allocator_>;
+    template <typename Rng_>
+    void operator() (Vector &dest, Rng_ &rng) const {
+        dest.resize(std::uniform_int_distribution<size_t>(0, 10)(rng));
+        for (auto &&c : dest)
+            c = make_random<bool>(rng);
+    }
+};
+
 } // end namespace lvd
@@ -2,12 +2,24 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <charconv>
 #include <cstddef>
 #include "lvd/Empty.hpp"
 #include "lvd/encoding.hpp"
+#include "lvd/literal.hpp"
 #include "lvd/type.hpp"
 #include "lvd/type_string_of.hpp"
+#include "lvd/varint.hpp"
 #include <istream>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 
 namespace lvd {
 
@@ -15,12 +27,15 @@ namespace lvd {
 // using data from the stream.  Default implementation provides code for basic types.
 // Should provide
 //
-// template <typename CharT_, typename Traits_>
-// std::basic_istream<CharT_,Traits_> &operator() (
-//      std::basic_istream<CharT_,Traits_> &in,
+// template <typename Istream_>
+// Istream_ &operator() (
+//      Istream_ &in,
 //      Encoding_ const &enc,
 //      T_ &dest_val
 // ) const
+//
+// where Istream_ is std::basic_istream<CharT_,Traits_>, ByteReader, or BlockFramedReader_t, so implementations
+// should only use in.get, in.peek, in.read, in.good, and in.fail.
 template <typename T_, typename Encoding_>
 struct ReadInPlace_t;
 
@@ -29,27 +44,47 @@ struct ReadInPlace_t;
 // constructible.  The default implementation is for types that are default constructible.
 // Should provide
 //
-// template <typename CharT_, typename Traits_>
-// T_ operator() (std::basic_istream<CharT_,Traits_> &in, Encoding_ const &enc) const
+// template <typename Istream_>
+// T_ operator() (Istream_ &in, Encoding_ const &enc) const
 template <typename T_, typename Encoding_>
 struct ReadValue_t;
 
+// Defined below.
+template <typename Istream_, auto... Params_, typename ReadFrame_>
+Istream_ &read_length_framed (Istream_ &in, BinEncoding_t<Params_...> const &enc, ReadFrame_ const &read_frame);
+
 //
-// Convenience functions for type deduction.
+// Convenience functions for type deduction.  These also handle FramingEncoding::LENGTH_PREFIXED, so that
+// ReadInPlace_t and ReadValue_t implementations don't have to.
 //
 
 // NOTE: If you're getting a compile error like "invalid use of incomplete type...", then you
 // need to include <lvd/read_XXX.hpp> for some XXX, e.g. bin_array or text_pair.
-template <typename T_, typename CharT_, typename Traits_, typename Encoding_>
-inline std::basic_istream<CharT_,Traits_> &read_in_place (std::basic_istream<CharT_,Traits_> &in, Encoding_ const &enc, T_ &dest_val) {
-    return ReadInPlace_t<T_,Encoding_>()(in, enc, dest_val);
+template <typename T_, typename Istream_, typename Encoding_>
+inline Istream_ &read_in_place (Istream_ &in, Encoding_ const &enc, T_ &dest_val) {
+    if constexpr (is_length_framed_v<T_,Encoding_>) {
+        return read_length_framed(in, enc, [&enc, &dest_val](auto &frame_in){
+            ReadInPlace_t<T_,Encoding_>()(frame_in, enc, dest_val);
+        });
+    } else {
+        return ReadInPlace_t<T_,Encoding_>()(in, enc, dest_val);
+    }
 }
 
 // NOTE: If you're getting a compile error like "invalid use of incomplete type...", then you
 // need to include <lvd/read_XXX.hpp> for some XXX, e.g. bin_array or text_pair.
-template <typename T_, typename CharT_, typename Traits_, typename Encoding_>
-inline T_ read_value (std::basic_istream<CharT_,Traits_> &in, Encoding_ const &enc) {
-    return ReadValue_t<T_,Encoding_>()(in, enc);
+template <typename T_, typename Istream_, typename Encoding_>
+inline T_ read_value (Istream_ &in, Encoding_ const &enc) {
+    if constexpr (is_length_framed_v<T_,Encoding_>) {
+        // T_ isn't necessarily default-constructible, so it's constructed in the frame.
+        std::optional<T_> retval;
+        read_length_framed(in, enc, [&enc, &retval](auto &frame_in){
+            retval.emplace(ReadValue_t<T_,Encoding_>()(frame_in, enc));
+        });
+        return std::move(*retval);
+    } else {
+        return ReadValue_t<T_,Encoding_>()(in, enc);
+    }
 }
 
 //
@@ -63,15 +98,15 @@ std::basic_istream<CharT_,Traits_> &operator>> (std::basic_istream<CharT_,Traits
     return read_in_place(in, i.encoding(), i.dest_val());
 }
 
-template <TypeEncoding TYPE_ENCODING_>
-template <typename T_, typename CharT_, typename Traits_>
-T_ BinEncoding_t<TYPE_ENCODING_>::read (std::basic_istream<CharT_,Traits_> &in) const {
+template <TypeEncoding TYPE_ENCODING_, IntEncoding INT_ENCODING_, EndiannessEncoding ENDIANNESS_ENCODING_, FramingEncoding FRAMING_ENCODING_>
+template <typename T_, typename Istream_>
+T_ BinEncoding_t<TYPE_ENCODING_,INT_ENCODING_,ENDIANNESS_ENCODING_,FRAMING_ENCODING_>::read (Istream_ &in) const {
     return read_value<T_>(in, *this);
 }
 
-template <TypeEncoding TYPE_ENCODING_>
-template <typename T_, typename CharT_, typename Traits_>
-T_ TextEncoding_t<TYPE_ENCODING_>::read (std::basic_istream<CharT_,Traits_> &in) const {
+template <TypeEncoding TYPE_ENCODING_, FloatEncoding FLOAT_ENCODING_>
+template <typename T_, typename Istream_>
+T_ TextEncoding_t<TYPE_ENCODING_,FLOAT_ENCODING_>::read (Istream_ &in) const {
     return read_value<T_>(in, *this);
 }
 
@@ -85,26 +120,212 @@ struct ReadInPlace_Builtin_t;
 template <typename T_, auto... Params_>
 struct ReadInPlace_Builtin_t<T_,BinEncoding_t<Params_...>> {
     static_assert(is_endiannated_type_v<T_>);
-    template <typename CharT_, typename Traits_>
-    std::basic_istream<CharT_,Traits_> &operator() (std::basic_istream<CharT_,Traits_> &in, BinEncoding_t<Params_...> const &enc, T_ &dest_val) const {
+    template <typename Istream_>
+    Istream_ &operator() (Istream_ &in, BinEncoding_t<Params_...> const &enc, T_ &dest_val) const {
         if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
             in >> enc.with_demoted_type_encoding().in(type_of(dest_val)); // This will throw if the type doesn't match.
 
-        static_assert(sizeof(CharT_) == 1, "only supporting chars of size 1 for now");
+        static_assert(sizeof(typename Istream_::char_type) == 1, "only supporting chars of size 1 for now");
 
         if constexpr (std::is_same_v<T_,bool>) {
             dest_val = in.get() != 0;
+        } else if constexpr (enc.int_encoding() == IntEncoding::VARINT && is_varint_encodable_v<T_>) {
+            // In case of EOF, the stream's failbit is set and this is the value.
+            dest_val = T_(0);
+            // Read a byte at a time, since the stream can't be peeked ahead by more than one byte.
+            uint64_t representation = 0;
+            for (size_t i = 0; ; ++i) {
+                auto c = in.get();
+                if (c == Istream_::traits_type::eof())
+                    return in;
+                auto b = uint64_t(uint8_t(c));
+                if (i == MAX_VARINT_SIZE-1 && b > 1)
+                    throw std::runtime_error("malformed varint; it overflows uint64_t");
+                representation |= (b & 0x7F) << (7*i);
+                if ((b & 0x80) == 0)
+                    break;
+            }
+            if (!varint_representation_to(representation, dest_val))
+                throw std::runtime_error("varint value " + std::to_string(representation) + " is out of the range of type " + type_string_of<T_>());
         } else if constexpr (sizeof(T_) == 1) {
             dest_val = T_(in.get());
         } else {
             static_assert(sizeof(T_) > 1);
-            in.read(reinterpret_cast<CharT_ *>(&dest_val), sizeof(dest_val));
-            endian_change(enc.endianness(), machine_endianness(), dest_val);
+            in.read(reinterpret_cast<typename Istream_::char_type *>(&dest_val), sizeof(dest_val));
+            if constexpr (!enc.is_statically_machine_endian())
+                endian_change(enc.endianness(), machine_endianness(), dest_val);
         }
         return in;
     }
 };
 
+//
+// Helpers for reading TextEncoding_t.  The text is scanned in a single pass, a char at a time, peeking at most
+// one char ahead, and numbers are parsed with std::from_chars out of a stack buffer, so nothing is allocated
+// per token.  Whitespace is allowed before each token.  Malformed input, including premature end of input,
+// causes std::runtime_error to be thrown.
+//
+
+[[noreturn]] inline void throw_malformed_text (std::string_view expected, std::string const &got) {
+    throw std::runtime_error("malformed text encoding; expected " + std::string(expected) + " but got " + got);
+}
+
+// Skips whitespace, then returns the next char without extracting it (or eof).
+template <typename Istream_>
+typename Istream_::traits_type::int_type skip_text_whitespace (Istream_ &in) {
+    auto c = in.peek();
+    while (c == ' ' || c == '\n' || c == '\t' || c == '\r') {
+        in.get();
+        c = in.peek();
+    }
+    return c;
+}
+
+// Describes the given char (or eof) returned by in.get or in.peek, for use in error messages.
+template <typename Istream_>
+std::string text_char_description (typename Istream_::traits_type::int_type c) {
+    if (c == Istream_::traits_type::eof())
+        return "end of input";
+    return literal_of(Istream_::traits_type::to_char_type(c));
+}
+
+// Extracts the next char, throwing if the input has ended.  expected is only used in the error message.
+template <typename Istream_>
+char get_text_char (Istream_ &in, char const *expected) {
+    auto c = in.get();
+    if (c == Istream_::traits_type::eof())
+        throw_malformed_text(expected, "end of input");
+    return Istream_::traits_type::to_char_type(c);
+}
+
+// Skips whitespace, then extracts the given char, throwing if it's not there.
+template <typename Istream_>
+void expect_text_char (Istream_ &in, char expected) {
+    skip_text_whitespace(in);
+    auto c = in.get();
+    if (c != Istream_::traits_type::to_int_type(expected))
+        throw_malformed_text(literal_of(expected), text_char_description<Istream_>(c));
+}
+
+// Skips whitespace, then extracts exactly the given chars (e.g. a keyword or a type string), throwing if
+// they're not there.
+template <typename Istream_>
+void expect_text_chars (Istream_ &in, std::string_view expected) {
+    skip_text_whitespace(in);
+    for (size_t i = 0; i < expected.size(); ++i) {
+        auto c = in.get();
+        if (c != Istream_::traits_type::to_int_type(expected[i]))
+            throw_malformed_text(literal_of(std::string(expected)), text_char_description<Istream_>(c) + " after " + literal_of(std::string(expected.substr(0, i))));
+    }
+}
+
+// Skips whitespace, then extracts the given char and returns true if it's next, otherwise returns false.
+template <typename Istream_>
+bool consume_text_char (Istream_ &in, char c) {
+    if (skip_text_whitespace(in) != c)
+        return false;
+    in.get();
+    return true;
+}
+
+// Skips whitespace, then extracts a token, i.e. a maximal run of the chars that can appear in a number, bool
+// or byte (e.g. `-1.5e+07`, `inf`, `true`, `0xA7`), into buffer.  Returns a view of the token within buffer.
+template <typename Istream_>
+std::string_view read_text_token (Istream_ &in, std::array<char,64> &buffer) {
+    size_t size = 0;
+    for (auto c = skip_text_whitespace(in); ; c = in.peek()) {
+        bool is_token_char = (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '+' || c == '-' || c == '.';
+        if (!is_token_char)
+            break;
+        if (size == buffer.size())
+            throw_malformed_text("a token of at most " + std::to_string(buffer.size()) + " chars", "a longer one");
+        buffer[size++] = Istream_::traits_type::to_char_type(in.get());
+    }
+    return std::string_view(buffer.data(), size);
+}
+
+// Parses the whole of token as a T_ (an integral or floating point type) in the format of std::to_chars.
+template <typename T_>
+T_ parsed_text_number (std::string_view token, int base = 10) {
+    T_ retval;
+    std::from_chars_result result;
+    if constexpr (std::is_floating_point_v<T_>)
+        result = std::from_chars(token.data(), token.data()+token.size(), retval);
+    else
+        result = std::from_chars(token.data(), token.data()+token.size(), retval, base);
+    if (result.ec == std::errc::result_out_of_range)
+        throw std::runtime_error("value " + literal_of(std::string(token)) + " is out of the range of type " + type_string_of<T_>());
+    if (result.ec != std::errc() || result.ptr != token.data()+token.size())
+        throw_malformed_text(type_string_of<T_>(), literal_of(std::string(token)));
+    return retval;
+}
+
+// Extracts the rest of an escape sequence whose backslash has already been extracted, as produced by
+// literal_of, i.e. `\xHH`, up to 3 octal digits, or a single char, e.g. `\n` or `\\`.
+template <typename Istream_>
+char read_text_escaped_char (Istream_ &in) {
+    auto c = get_text_char(in, "escape sequence");
+    auto is_octal_digit = [](auto d){ return d >= '0' && d <= '7'; };
+    if (c == 'x') {
+        std::array<char,2> digits;
+        digits[0] = get_text_char(in, "hex digit");
+        digits[1] = get_text_char(in, "hex digit");
+        return char(parsed_text_number<uint8_t>(std::string_view(digits.data(), digits.size()), 16));
+    } else if (is_octal_digit(c)) {
+        uint32_t value = uint32_t(c - '0');
+        for (int i = 1; i < 3 && is_octal_digit(in.peek()); ++i)
+            value = 8*value + uint32_t(in.get() - '0');
+        if (value > 0xFF)
+            throw std::runtime_error("octal escape sequence value " + std::to_string(value) + " is out of range");
+        return char(value);
+    } else {
+        return char(escaped_char(uint8_t(c)));
+    }
+}
+
+template <typename T_, auto... Params_>
+struct ReadInPlace_Builtin_t<T_,TextEncoding_t<Params_...>> {
+    template <typename Istream_>
+    Istream_ &operator() (Istream_ &in, TextEncoding_t<Params_...> const &enc, T_ &dest_val) const {
+        if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED) {
+            expect_text_chars(in, type_string_of<T_>());
+            expect_text_char(in, '(');
+        }
+
+        std::array<char,64> buffer;
+        if constexpr (std::is_same_v<T_,char>) {
+            expect_text_char(in, '\'');
+            dest_val = get_text_char(in, "char");
+            if (dest_val == '\\')
+                dest_val = read_text_escaped_char(in);
+            expect_text_char(in, '\'');
+        } else {
+            auto token = read_text_token(in, buffer);
+            if constexpr (std::is_same_v<T_,bool>) {
+                if (token == "true")
+                    dest_val = true;
+                else if (token == "false")
+                    dest_val = false;
+                else
+                    throw_malformed_text("bool", literal_of(std::string(token)));
+            } else if constexpr (std::is_same_v<T_,std::byte>) {
+                if (token.size() < 3 || token[0] != '0' || (token[1] != 'x' && token[1] != 'X'))
+                    throw_malformed_text("byte", literal_of(std::string(token)));
+                dest_val = std::byte(parsed_text_number<uint8_t>(token.substr(2), 16));
+            } else if constexpr (std::is_integral_v<T_> || std::is_floating_point_v<T_>) {
+                // Note that std::from_chars parses int8_t and uint8_t as numbers, not chars.
+                dest_val = parsed_text_number<T_>(token);
+            } else {
+                static_assert(sizeof(T_) == -1, "unhandled case"); // Not sure how static_assert(false) is possible, so this is a hack
+            }
+        }
+
+        if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
+            expect_text_char(in, ')');
+        return in;
+    }
+};
+
 template <typename Encoding_> struct ReadInPlace_t<bool,Encoding_> : public ReadInPlace_Builtin_t<bool,Encoding_> { };
 template <typename Encoding_> struct ReadInPlace_t<char,Encoding_> : public ReadInPlace_Builtin_t<char,Encoding_> { };
 template <typename Encoding_> struct ReadInPlace_t<std::byte,Encoding_> : public ReadInPlace_Builtin_t<std::byte,Encoding_> { };
@@ -120,15 +341,154 @@ template <typename Encoding_> struct ReadInPlace_t<float,Encoding_> : public Rea
 template <typename Encoding_> struct ReadInPlace_t<double,Encoding_> : public ReadInPlace_Builtin_t<double,Encoding_> { };
 // TODO: Figure out how to define for long double in the case where long double == double.
 
+class ByteReader;
+
+// True iff Istream_ reads from a contiguous in-memory buffer (i.e. is ByteReader), so that it has range() and view(),
+// and the number of bytes remaining is known.  Other streams (e.g. iostreams and BlockFramedReader_t) can only be
+// read sequentially.
+template <typename Istream_>
+inline bool constexpr is_contiguous_istream_v = std::is_same_v<Istream_,ByteReader>;
+
+// Returns the number of bytes remaining in the stream if that's known (i.e. for ByteReader), and otherwise the
+// max size_t.  This is used to reject or limit claimed string and container sizes that the input can't back.
+template <typename Istream_>
+size_t available_bytes_of (Istream_ &in) {
+    if constexpr (!is_contiguous_istream_v<Istream_>)
+        return std::numeric_limits<size_t>::max();
+    else
+        return size_t(in.range().size());
+}
+
+// If the stream is known to have too few bytes remaining for count elements of element_size bytes each (i.e. for
+// ByteReader), this fails the stream the same way that reading past its end would, and returns false, so that a
+// corrupt size is rejected without reading or allocating anything.  Otherwise returns true.
+template <typename Istream_>
+bool check_available_bytes (Istream_ &in, size_t count, size_t element_size) {
+    if constexpr (!is_contiguous_istream_v<Istream_>) {
+        return true;
+    } else {
+        auto available = size_t(in.range().size());
+        if (count <= available / element_size)
+            return true;
+        in.view(available+1);
+        return false;
+    }
+}
+
+// Reads the byte length that prefixes a length-framed value.
+template <typename Istream_, auto... Params_>
+size_t read_frame_length (Istream_ &in, BinEncoding_t<Params_...> const &enc) {
+    return read_value<size_t>(in, enc.template with_type_encoding<TypeEncoding::EXCLUDED>());
+}
+
+template <typename Istream_, typename = void>
+struct has_tellg_ : public std::false_type { };
+
+template <typename Istream_>
+struct has_tellg_<Istream_,std::void_t<decltype(std::declval<Istream_ &>().tellg())>> : public std::true_type { };
+
+// Returns the position of a non-contiguous stream (as given by its tellg), or nullopt if that's unknown, i.e. if the
+// stream has no tellg, isn't good (in which case tellg would fail it), or can't report its position (e.g. a pipe).
+template <typename Istream_>
+std::optional<uint64_t> stream_position_of (Istream_ &in) {
+    if constexpr (!has_tellg_<Istream_>::value) {
+        return std::nullopt;
+    } else {
+        if (!in.good())
+            return std::nullopt;
+        auto position = in.tellg();
+        if (position == decltype(position)(-1))
+            return std::nullopt;
+        return uint64_t(std::streamoff(position));
+    }
+}
+
+// Reads the byte length of a length-framed value, and then calls read_frame with the stream to read the value
+// from.  For a ByteReader, that's a ByteReader over exactly the frame, so that the value can't be read past the
+// end of its frame.  For other streams, it's `in` itself, since they can only be read sequentially, and the bytes
+// the value took are counted via tellg instead (if the stream can report its position), so that reading past the
+// end of the frame fails `in`.  Either way, a frame having bytes left over after the value is an error.
+template <typename Istream_, auto... Params_, typename ReadFrame_>
+Istream_ &read_length_framed (Istream_ &in, BinEncoding_t<Params_...> const &enc, ReadFrame_ const &read_frame) {
+    auto length = read_frame_length(in, enc);
+    if constexpr (!is_contiguous_istream_v<Istream_>) {
+        auto start = stream_position_of(in);
+        read_frame(in);
+        auto end = stream_position_of(in);
+        if (start.has_value() && end.has_value()) {
+            auto consumed = *end - *start;
+            if (consumed > length)
+                in.setstate(std::ios_base::failbit);
+            else if (consumed < length)
+                throw std::runtime_error("length-framed value has " + std::to_string(length - consumed) + " byte(s) left over after it was read");
+        }
+    } else {
+        // If length is too big, then this fails `in` and the frame is empty, so reading from it fails too.
+        Istream_ frame_in(in.view(length));
+        read_frame(frame_in);
+        if (frame_in.fail())
+            in.setstate(std::ios_base::failbit);
+        else if (!frame_in.range().empty())
+            throw std::runtime_error("length-framed value has " + std::to_string(frame_in.range().size()) + " byte(s) left over after it was read");
+    }
+    return in;
+}
+
+// Advances the stream past count bytes, without allocating anything for them.  As with reading, this fails the
+// stream if there are fewer than count bytes.
+template <typename Istream_>
+Istream_ &skip_bytes (Istream_ &in, size_t count) {
+    static_assert(sizeof(typename Istream_::char_type) == 1, "only supporting chars of size 1 for now");
+
+    if constexpr (!is_contiguous_istream_v<Istream_>) {
+        std::array<typename Istream_::char_type,0x1000> chunk;
+        for (size_t n = 0; n < count && in.good(); n += chunk.size())
+            in.read(chunk.data(), std::min(chunk.size(), count - n));
+    } else {
+        in.view(count);
+    }
+    return in;
+}
+
+// Advances the stream past a value of type T_.  If it's length-framed (see FramingEncoding), then this doesn't
+// decode it (nor check its type), which is the point of framing.  Otherwise it's decoded and discarded.
+template <typename T_, typename Istream_, typename Encoding_>
+Istream_ &skip_value (Istream_ &in, Encoding_ const &enc) {
+    if constexpr (is_length_framed_v<T_,Encoding_>) {
+        auto length = read_frame_length(in, enc);
+        if (in.good())
+            skip_bytes(in, length);
+    } else {
+        read_value<T_>(in, enc);
+    }
+    return in;
+}
+
+// Reads count values into the array starting at `values` (without any type info or size), expecting the same
+// input as reading each one individually.  This is one in.read call, followed by a bulk byte-swap if needed.
+template <typename T_, typename Istream_, auto... Params_>
+Istream_ &read_bin_block (Istream_ &in, BinEncoding_t<Params_...> const &enc, T_ *values, size_t count) {
+    static_assert(is_bin_block_encodable_v<T_,BinEncoding_t<Params_...>>);
+    static_assert(sizeof(typename Istream_::char_type) == 1, "only supporting chars of size 1 for now");
+
+    in.read(reinterpret_cast<typename Istream_::char_type *>(values), count*sizeof(T_));
+    if constexpr (sizeof(T_) > 1 && !enc.is_statically_machine_endian()) {
+        if (enc.endianness() != machine_endianness())
+            swap_byte_order_of_each_leaf(values, count);
+    }
+    return in;
+}
+
 // Default implementation works for default-constructible T_.
 // NOTE: If you got a compile error saying "no match for call to lvd::ReadValue_t<...>" and it showed
 // you that this candidate failed, then it means you have to implement ReadValue_t<T_,Encoding_> for
 // your type T_ and for the encodings you care about.
 template <typename T_, typename Encoding_>
 struct ReadValue_t {
-    template <typename CharT_, typename Traits_, typename = std::enable_if_t<std::is_default_constructible_v<T_>>>
-    T_ operator() (std::basic_istream<CharT_,Traits_> &in, Encoding_ const &enc) const {
-        T_ retval;
+    template <typename Istream_, typename = std::enable_if_t<std::is_default_constructible_v<T_>>>
+    T_ operator() (Istream_ &in, Encoding_ const &enc) const {
+        // Value-initialized, since if the read fails, scalars would be left uninitialized.
+        T_ retval{};
         ReadInPlace_t<T_,Encoding_>()(in, enc, retval);
         return retval;
     }
@@ -136,8 +496,8 @@ struct ReadValue_t {
 
 template <auto... Params_>
 struct ReadInPlace_t<Empty,BinEncoding_t<Params_...>> {
-    template <typename CharT_, typename Traits_>
-    std::basic_istream<CharT_,Traits_> &operator() (std::basic_istream<CharT_,Traits_> &in, BinEncoding_t<Params_...> const &enc, Empty &dest_val) const {
+    template <typename Istream_>
+    Istream_ &operator() (Istream_ &in, BinEncoding_t<Params_...> const &enc, Empty &dest_val) const {
         if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
             in >> enc.with_demoted_type_encoding().in(type_of(dest_val)); // This will throw if the type doesn't match.
         // No content.
@@ -145,4 +505,16 @@ struct ReadInPlace_t<Empty,BinEncoding_t<Params_...>> {
     }
 };
 
+
+template <auto... Params_>
+struct ReadInPlace_t<Empty,TextEncoding_t<Params_...>> {
+    template <typename Istream_>
+    Istream_ &operator() (Istream_ &in, TextEncoding_t<Params_...> const &enc, Empty &dest_val) const {
+        if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
+            expect_text_chars(in, type_string_of<Empty>());
+        // No content.
+        return in;
+    }
+};
+
 } // end namespace lvd
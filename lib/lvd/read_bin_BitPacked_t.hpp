@@ -0,0 +1,85 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include <algorithm>
+#include "lvd/bitpack.hpp"
+#include "lvd/BitPacked_t.hpp"
+#include "lvd/DecodeBudget.hpp"
+#include "lvd/read.hpp"
+#include "lvd/read_bin_type.hpp"
+#include <vector>
+
+namespace lvd {
+
+// Reads a bitmap of count bools (without any type info or size), followed by the given number of bytes of 0 padding.
+// The bitmap grows a chunk at a time as it's actually read, so that a corrupt count can't cause a huge allocation
+// before the stream runs out.  The unused bits of the last byte are cleared.
+template <typename Istream_>
+std::vector<std::byte> read_bitmap (Istream_ &in, size_t count, size_t padding = 0) {
+    static_assert(sizeof(typename Istream_::char_type) == 1, "only supporting chars of size 1 for now");
+
+    std::vector<std::byte> bitmap;
+    auto size = bitmap_size_of(count);
+    if (!check_available_bytes(in, size, 1))
+        return bitmap;
+    for (size_t n = 0; n < size && in.good(); n += MAX_UNVERIFIED_RESERVE_BYTES) {
+        auto chunk_size = std::min(MAX_UNVERIFIED_RESERVE_BYTES, size - n);
+        bitmap.resize(n + chunk_size);
+        in.read(reinterpret_cast<typename Istream_::char_type *>(bitmap.data() + n), chunk_size);
+    }
+    if (in.good()) {
+        clear_unused_bitmap_bits(bitmap.data(), count);
+        bitmap.resize(size + padding, std::byte{0});
+    }
+    return bitmap;
+}
+
+template <typename Container_, auto... Params_>
+struct ReadInPlace_t<BitPacked_t<Container_>,BinEncoding_t<Params_...>> {
+    template <typename Istream_>
+    Istream_ &operator() (Istream_ &in, BinEncoding_t<Params_...> const &enc, BitPacked_t<Container_> &dest_val) const {
+        using Element = typename BitPacked_t<Container_>::Element;
+
+        if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
+            in >> enc.with_demoted_type_encoding().in(type_of(dest_val)); // This will throw if the type doesn't match.
+
+        // The type is already known at this point.
+        auto inner_enc = enc.with_demoted_type_encoding();
+        auto &dest = dest_val.container();
+        size_t size;
+        if constexpr (dest_val.has_fixed_size()) {
+            size = dest.size();
+        } else {
+            dest.clear();
+            size = read_value<size_t>(in, inner_enc);
+        }
+        charge_decode_budget<Element>(size);
+        DecodeNestingLevel nesting_level;
+
+        // The padding is for for_each_set_bit.
+        auto bitmap = read_bitmap(in, size, dest_val.is_optional_container() ? 8 : 0);
+        if (!in.good())
+            return in;
+
+        if constexpr (!dest_val.has_fixed_size())
+            dest.resize(size);
+        if constexpr (dest_val.is_optional_container()) {
+            using T = typename Element::value_type;
+            for (auto &element : dest)
+                element.reset();
+            // Only the present values are in the input, and runs of absent ones are skipped a word at a time.
+            for_each_set_bit(bitmap.data(), size, [&in, &inner_enc, &dest](size_t i){
+                if (in.good())
+                    dest[i] = read_value<T>(in, inner_enc);
+            });
+        } else {
+            auto it = dest.begin();
+            for (size_t i = 0; i < size; ++i, ++it)
+                *it = (uint8_t(bitmap[i/8]) >> (i%8)) & 1;
+        }
+        return in;
+    }
+};
+
+} // end namespace lvd
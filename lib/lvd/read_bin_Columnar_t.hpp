@@ -0,0 +1,176 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include "lvd/Columnar_t.hpp"
+#include "lvd/DecodeBudget.hpp"
+#include "lvd/read.hpp"
+#include "lvd/read_bin_type.hpp"
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace lvd {
+
+// Reads the INDEX_th field of each of the count elements starting at `it` (without any type info or size).
+// If the fields can be block-encoded, they're read a chunk at a time as a block into a local buffer, and then
+// scattered into the elements.
+template <size_t INDEX_, typename Container_, typename Istream_, auto... Params_>
+Istream_ &read_bin_column (Istream_ &in, BinEncoding_t<Params_...> const &enc, typename Container_::iterator it, size_t count) {
+    using Column = ColumnType_t<INDEX_,Container_>;
+    if constexpr (is_bin_block_encodable_v<Column,BinEncoding_t<Params_...>>) {
+        size_t constexpr CHUNK_SIZE = std::max(size_t(1), 0x1000 / sizeof(Column));
+        std::array<Column,CHUNK_SIZE> chunk;
+        for (size_t n = 0; n < count && in.good(); n += CHUNK_SIZE) {
+            auto chunk_size = std::min(CHUNK_SIZE, count - n);
+            read_bin_block(in, enc, chunk.data(), chunk_size);
+            for (size_t i = 0; i < chunk_size; ++i, ++it)
+                std::get<INDEX_>(*it) = chunk[i];
+        }
+    } else {
+        for (size_t n = 0; n < count && in.good(); ++n, ++it)
+            in >> enc.in(std::get<INDEX_>(*it));
+    }
+    return in;
+}
+
+// Reads the (OFFSET_+INDICES_)th columns into the existing elements of dest_val.
+template <size_t OFFSET_, typename Container_, typename Istream_, auto... Params_, size_t... INDICES_>
+Istream_ &read_bin_remaining_columns (Istream_ &in, BinEncoding_t<Params_...> const &enc, Container_ &dest_val, std::index_sequence<INDICES_...>) {
+    (read_bin_column<OFFSET_+INDICES_,Container_>(in, enc, dest_val.begin(), dest_val.size()), ...);
+    return in;
+}
+
+template <typename Container_, auto... Params_>
+struct ReadInPlace_t<Columnar_t<Container_>,BinEncoding_t<Params_...>> {
+    template <typename Istream_>
+    Istream_ &operator() (Istream_ &in, BinEncoding_t<Params_...> const &enc, Columnar_t<Container_> &dest_val) const {
+        if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
+            in >> enc.with_demoted_type_encoding().in(type_of(dest_val)); // This will throw if the type doesn't match.
+
+        // The type is already known at this point.
+        auto inner_enc = enc.with_demoted_type_encoding();
+        using Row = typename Columnar_t<Container_>::Row;
+        auto &dest = dest_val.container();
+        dest.clear();
+        auto size = read_value<size_t>(in, inner_enc);
+        charge_decode_budget<Row>(size);
+        DecodeNestingLevel nesting_level;
+        // The rows are added a chunk at a time as the 0th column is actually read, so that a corrupt size can't
+        // cause a huge allocation before the stream runs out.  The rest of the columns then fill in those rows.
+        size_t constexpr CHUNK_SIZE = std::max(size_t(1), MAX_UNVERIFIED_RESERVE_BYTES / sizeof(Row));
+        for (size_t n = 0; n < size && in.good(); n += CHUNK_SIZE) {
+            auto chunk_size = std::min(CHUNK_SIZE, size - n);
+            dest.resize(n + chunk_size);
+            read_bin_column<0,Container_>(in, inner_enc, std::next(dest.begin(), n), chunk_size);
+        }
+        if (in.good())
+            read_bin_remaining_columns<1>(in, inner_enc, dest, std::make_index_sequence<dest_val.column_count()-1>());
+        return in;
+    }
+};
+
+//
+// Reading only some of the columns.
+//
+
+// Reads and discards count fields of type Column_ (without any type info or size).  Block-encodable fields are
+// skipped without decoding them, and for a ByteReader, without even copying them.
+template <typename Column_, typename Istream_, auto... Params_>
+Istream_ &skip_bin_column (Istream_ &in, BinEncoding_t<Params_...> const &enc, size_t count) {
+    if constexpr (is_bin_block_encodable_v<Column_,BinEncoding_t<Params_...>>) {
+        if constexpr (!is_contiguous_istream_v<Istream_>) {
+            std::array<typename Istream_::char_type,0x1000> chunk;
+            // A field bigger than the chunk is skipped a chunk's worth of bytes at a time.
+            size_t constexpr CHUNK_SIZE = std::max(size_t(1), chunk.size() / sizeof(Column_));
+            for (size_t n = 0; n < count && in.good(); n += CHUNK_SIZE)
+                for (size_t bytes = std::min(CHUNK_SIZE, count - n) * sizeof(Column_); bytes > 0 && in.good(); bytes -= std::min(bytes, chunk.size()))
+                    in.read(chunk.data(), std::min(bytes, chunk.size()));
+        } else {
+            if (check_available_bytes(in, count, sizeof(Column_)))
+                in.view(count*sizeof(Column_));
+        }
+    } else {
+        for (size_t n = 0; n < count && in.good(); ++n)
+            read_value<Column_>(in, enc);
+    }
+    return in;
+}
+
+// Reads count fields of type Column_ (without any type info or size) into dest, which grows a chunk at a time
+// as the fields are actually read.
+template <typename Column_, typename Istream_, auto... Params_>
+Istream_ &read_bin_column_values (Istream_ &in, BinEncoding_t<Params_...> const &enc, size_t count, std::vector<Column_> &dest) {
+    dest.clear();
+    if constexpr (is_bin_block_encodable_v<Column_,BinEncoding_t<Params_...>>) {
+        if (!check_available_bytes(in, count, sizeof(Column_)))
+            return in;
+        size_t constexpr CHUNK_SIZE = std::max(size_t(1), MAX_UNVERIFIED_RESERVE_BYTES / sizeof(Column_));
+        for (size_t n = 0; n < count && in.good(); n += CHUNK_SIZE) {
+            auto chunk_size = std::min(CHUNK_SIZE, count - n);
+            dest.resize(n + chunk_size);
+            read_bin_block(in, enc, dest.data() + n, chunk_size);
+        }
+    } else {
+        dest.reserve(unverified_reserve_count<Column_>(count, available_bytes_of(in)));
+        for (size_t n = 0; n < count && in.good(); ++n)
+            dest.emplace_back(read_value<Column_>(in, enc));
+    }
+    return in;
+}
+
+// Returns the position of INDEX_ within INDICES_, or sizeof...(INDICES_) if it's not present.
+template <size_t INDEX_, size_t... INDICES_>
+size_t constexpr position_of_index () {
+    size_t position = 0;
+    static_cast<void>(((INDICES_ == INDEX_ ? false : (++position, true)) && ...));
+    return position;
+}
+
+template <typename Container_, size_t... INDICES_, typename Columns_, typename Istream_, auto... Params_, size_t... COLUMN_INDICES_>
+Istream_ &read_or_skip_bin_columns (Istream_ &in, BinEncoding_t<Params_...> const &enc, size_t count, Columns_ &columns, std::index_sequence<COLUMN_INDICES_...>) {
+    auto read_or_skip_column = [&](auto column_index){
+        size_t constexpr POSITION = position_of_index<decltype(column_index)::value,INDICES_...>();
+        if constexpr (POSITION < sizeof...(INDICES_))
+            read_bin_column_values(in, enc, count, std::get<POSITION>(columns));
+        else
+            skip_bin_column<ColumnType_t<decltype(column_index)::value,Container_>>(in, enc, count);
+    };
+    (read_or_skip_column(std::integral_constant<size_t,COLUMN_INDICES_>()), ...);
+    return in;
+}
+
+// Reads only the given columns of a columnar-encoded Container_ (i.e. as written via as_columnar), skipping the
+// rest, and returns them as a tuple of vectors, in the order given.  For example,
+//
+//     auto [ids, prices] = read_bin_columns<std::vector<std::tuple<uint32_t,std::string,double>>,0,2>(in, enc);
+//
+// The whole encoded value is consumed either way, so the stream is left positioned just past it.
+template <typename Container_, size_t... INDICES_, typename Istream_, auto... Params_>
+std::tuple<std::vector<ColumnType_t<INDICES_,Container_>>...> read_bin_columns (Istream_ &in, BinEncoding_t<Params_...> const &enc) {
+    static_assert(((INDICES_ < Columnar_t<Container_>::column_count()) && ...), "column index out of range");
+
+    std::tuple<std::vector<ColumnType_t<INDICES_,Container_>>...> retval;
+    auto read_columns = [&enc, &retval](auto &in){
+        if constexpr (BinEncoding_t<Params_...>::type_encoding() == TypeEncoding::INCLUDED)
+            in >> enc.with_demoted_type_encoding().in(ty<Columnar_t<Container_>>); // This will throw if the type doesn't match.
+
+        // The type is already known at this point.
+        auto inner_enc = enc.with_demoted_type_encoding();
+        auto size = read_value<size_t>(in, inner_enc);
+        charge_decode_budget<typename Columnar_t<Container_>::Row>(size);
+        DecodeNestingLevel nesting_level;
+        read_or_skip_bin_columns<Container_,INDICES_...>(in, inner_enc, size, retval, std::make_index_sequence<Columnar_t<Container_>::column_count()>());
+    };
+    // This bypasses read_value, so it has to handle the framing itself.
+    if constexpr (is_length_framed_v<Columnar_t<Container_>,BinEncoding_t<Params_...>>)
+        read_length_framed(in, enc, read_columns);
+    else
+        read_columns(in);
+    return retval;
+}
+
+} // end namespace lvd
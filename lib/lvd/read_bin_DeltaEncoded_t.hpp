@@ -0,0 +1,82 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include "lvd/associative_container.hpp"
+#include "lvd/bitpack.hpp"
+#include "lvd/DecodeBudget.hpp"
+#include "lvd/DeltaEncoded_t.hpp"
+#include "lvd/read.hpp"
+#include "lvd/read_bin_type.hpp"
+#include "lvd/remove_cv_recursive.hpp"
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace lvd {
+
+template <typename Container_, auto... Params_>
+struct ReadInPlace_t<DeltaEncoded_t<Container_>,BinEncoding_t<Params_...>> {
+    template <typename Istream_>
+    Istream_ &operator() (Istream_ &in, BinEncoding_t<Params_...> const &enc, DeltaEncoded_t<Container_> &dest_val) const {
+        static_assert(sizeof(typename Istream_::char_type) == 1, "only supporting chars of size 1 for now");
+        using Key = typename DeltaEncoded_t<Container_>::Key;
+        using UnsignedKey = typename DeltaEncoded_t<Container_>::UnsignedKey;
+        using ValueType = remove_cv_recursive_t<typename Container_::value_type>;
+
+        if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
+            in >> enc.with_demoted_type_encoding().in(type_of(dest_val)); // This will throw if the type doesn't match.
+
+        // The type is already known at this point.
+        auto inner_enc = enc.with_demoted_type_encoding();
+        auto &dest = dest_val.container();
+        dest.clear();
+        auto size = read_value<size_t>(in, inner_enc);
+        charge_decode_budget<ValueType>(size);
+        DecodeNestingLevel nesting_level;
+        if (size == 0 || !in.good())
+            return in;
+
+        // For a map, the keys are needed again once the mapped values (which follow all the keys) are read.
+        std::vector<Key> keys;
+        if constexpr (dest_val.is_map())
+            keys.reserve(unverified_reserve_count<Key>(size, available_bytes_of(in)));
+        auto emit_key = [&dest, &keys](Key key){
+            if constexpr (DeltaEncoded_t<Container_>::is_map())
+                keys.push_back(key);
+            else
+                emplace_in_serialized_order(dest, key);
+        };
+
+        auto previous = read_value<Key>(in, inner_enc);
+        emit_key(previous);
+        // Each block is decoded in two passes; unpacking the differences, which has no loop-carried dependency, and
+        // then summing them up.
+        std::array<uint64_t,DELTA_BLOCK_SIZE> keys_block;
+        std::array<std::byte,bit_packed_size_of(DELTA_BLOCK_SIZE,64)+BIT_PACKING_PADDING> packed;
+        for (size_t n = 1; n < size && in.good(); n += DELTA_BLOCK_SIZE) {
+            auto count = std::min(DELTA_BLOCK_SIZE, size - n);
+            auto bit_width = size_t(read_value<uint8_t>(in, inner_enc));
+            if (bit_width > 64)
+                throw std::runtime_error("invalid bit width " + std::to_string(bit_width) + " for delta-encoded keys");
+            in.read(reinterpret_cast<typename Istream_::char_type *>(packed.data()), bit_packed_size_of(count, bit_width));
+            if (!in.good())
+                break;
+            unpack_bits(packed.data(), count, bit_width, keys_block.data());
+            previous = Key(UnsignedKey(prefix_sum_in_place(keys_block.data(), count, UnsignedKey(previous))));
+            for (size_t i = 0; i < count; ++i)
+                emit_key(Key(UnsignedKey(keys_block[i])));
+        }
+
+        if constexpr (dest_val.is_map()) {
+            using Mapped = remove_cv_recursive_t<typename Container_::mapped_type>;
+            for (size_t i = 0; i < keys.size() && in.good(); ++i)
+                emplace_in_serialized_order(dest, typename Container_::value_type(keys[i], read_value<Mapped>(in, inner_enc)));
+        }
+        return in;
+    }
+};
+
+} // end namespace lvd
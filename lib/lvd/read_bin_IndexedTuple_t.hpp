@@ -9,8 +9,8 @@ namespace lvd {
 
 template <size_t INDEX_, typename... Types_, auto... Params_>
 struct ReadInPlace_t<IndexedTuple_t<INDEX_,Types_...>,BinEncoding_t<Params_...>> {
-    template <typename CharT_, typename Traits_>
-    std::basic_istream<CharT_,Traits_> &operator() (std::basic_istream<CharT_,Traits_> &in, BinEncoding_t<Params_...> const &enc, IndexedTuple_t<INDEX_,Types_...> &dest_val) const {
+    template <typename Istream_>
+    Istream_ &operator() (Istream_ &in, BinEncoding_t<Params_...> const &enc, IndexedTuple_t<INDEX_,Types_...> &dest_val) const {
         if constexpr (dest_val.has_ended()) {
             // Nothing to do, we're already at/past the end.
             return in;
@@ -22,8 +22,8 @@ struct ReadInPlace_t<IndexedTuple_t<INDEX_,Types_...>,BinEncoding_t<Params_...>>
 
 template <size_t INDEX_, typename... Types_, typename Encoding_>
 struct ReadValue_t<IndexedTuple_t<INDEX_,Types_...>,Encoding_> {
-    template <typename CharT_, typename Traits_>
-    IndexedTuple_t<INDEX_,Types_...> operator() (std::basic_istream<CharT_,Traits_> &in, Encoding_ const &enc) const {
+    template <typename Istream_>
+    IndexedTuple_t<INDEX_,Types_...> operator() (Istream_ &in, Encoding_ const &enc) const {
         IndexedTuple_t<INDEX_,Types_...> retval;
         ReadInPlace_t<IndexedTuple_t<INDEX_,Types_...>,Encoding_>()(in, enc, retval);
         return retval;
@@ -0,0 +1,33 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include "lvd/ByteReader.hpp"
+#include "lvd/LazyValue_t.hpp"
+#include "lvd/read.hpp"
+#include <type_traits>
+
+namespace lvd {
+
+// Reads a T_ as a LazyValue_t, i.e. via skip_value, so that if T_ is length-framed, it isn't decoded.  If the
+// read fails, then the returned LazyValue_t is empty.
+template <typename T_, auto... Params_>
+LazyValue_t<T_> read_lazy_value (ByteReader &in, BinEncoding_t<Params_...> const &enc) {
+    auto begin = in.range().begin();
+    skip_value<T_>(in, enc);
+    if (in.fail())
+        return LazyValue_t<T_>();
+    return LazyValue_t<T_>(Range_t<std::byte const *>(begin, in.range().begin()), enc);
+}
+
+template <typename T_, auto... Params_>
+struct ReadInPlace_t<LazyValue_t<T_>,BinEncoding_t<Params_...>> {
+    template <typename Istream_>
+    Istream_ &operator() (Istream_ &in, BinEncoding_t<Params_...> const &enc, LazyValue_t<T_> &dest_val) const {
+        static_assert(std::is_same_v<Istream_,ByteReader>, "LazyValue_t can only be read from a ByteReader, since it refers to its bytes in place");
+        dest_val = read_lazy_value<T_>(in, enc);
+        return in;
+    }
+};
+
+} // end namespace lvd
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "lvd/associative_container.hpp"
+#include "lvd/DecodeBudget.hpp"
 #include "lvd/read.hpp"
 #include "lvd/read_bin_type.hpp"
 #include "lvd/remove_cv_recursive.hpp"
@@ -14,8 +16,8 @@ struct ReadInPlace_AssociativeContainer_t;
 
 template <typename Container_, auto... Params_>
 struct ReadInPlace_AssociativeContainer_t<Container_,BinEncoding_t<Params_...>> {
-    template <typename CharT_, typename Traits_>
-    std::basic_istream<CharT_,Traits_> &operator() (std::basic_istream<CharT_,Traits_> &in, BinEncoding_t<Params_...> const &enc, Container_ &dest_val) const {
+    template <typename Istream_>
+    Istream_ &operator() (Istream_ &in, BinEncoding_t<Params_...> const &enc, Container_ &dest_val) const {
         if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
             in >> enc.with_demoted_type_encoding().in(type_of(dest_val)); // This will throw if the type doesn't match.
 
@@ -25,8 +27,12 @@ struct ReadInPlace_AssociativeContainer_t<Container_,BinEncoding_t<Params_...>>
         dest_val.clear();
         // TODO: Use uint32_t, since size_t is machine-dependent.
         auto size = read_value<size_t>(in, inner_enc);
-        for (size_t n = 0; n < size; ++n)
-            dest_val.emplace(read_value<ValueType>(in, inner_enc));
+        charge_decode_budget<ValueType>(size);
+        DecodeNestingLevel nesting_level;
+        reserve_associative_container(dest_val, unverified_reserve_count<ValueType>(size, available_bytes_of(in)));
+        // Stop upon failure, so that a corrupt size can't cause a huge amount of work.
+        for (size_t n = 0; n < size && in.good(); ++n)
+            emplace_in_serialized_order(dest_val, read_value<ValueType>(in, inner_enc));
         return in;
     }
 };
@@ -37,8 +43,8 @@ struct ReadInPlace_SequenceContainer_t;
 
 template <typename Container_, auto... Params_>
 struct ReadInPlace_SequenceContainer_t<Container_,BinEncoding_t<Params_...>> {
-    template <typename CharT_, typename Traits_>
-    std::basic_istream<CharT_,Traits_> &operator() (std::basic_istream<CharT_,Traits_> &in, BinEncoding_t<Params_...> const &enc, Container_ &dest_val) const {
+    template <typename Istream_>
+    Istream_ &operator() (Istream_ &in, BinEncoding_t<Params_...> const &enc, Container_ &dest_val) const {
         if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
             in >> enc.with_demoted_type_encoding().in(type_of(dest_val)); // This will throw if the type doesn't match.
 
@@ -47,8 +53,12 @@ struct ReadInPlace_SequenceContainer_t<Container_,BinEncoding_t<Params_...>> {
         using ValueType = remove_cv_recursive_t<typename Container_::value_type>;
         dest_val.clear();
         auto size = read_value<size_t>(in, inner_enc);
-        dest_val.reserve(size);
-        for (size_t n = 0; n < size; ++n)
+        charge_decode_budget<ValueType>(size);
+        DecodeNestingLevel nesting_level;
+        // Each element takes at least 1 byte, and beyond MAX_UNVERIFIED_RESERVE_BYTES, dest_val grows as the
+        // elements are actually read.  Stop upon failure, so that a corrupt size can't cause a huge amount of work.
+        dest_val.reserve(unverified_reserve_count<ValueType>(size, available_bytes_of(in)));
+        for (size_t n = 0; n < size && in.good(); ++n)
             dest_val.emplace_back(read_value<ValueType>(in, inner_enc));
         return in;
     }
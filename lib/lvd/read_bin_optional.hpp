@@ -11,8 +11,8 @@ namespace lvd {
 
 template <typename T_, auto... Params_>
 struct ReadInPlace_t<std::optional<T_>,BinEncoding_t<Params_...>> {
-    template <typename CharT_, typename Traits_>
-    std::basic_istream<CharT_,Traits_> &operator() (std::basic_istream<CharT_,Traits_> &in, BinEncoding_t<Params_...> const &enc, std::optional<T_> &dest_val) const {
+    template <typename Istream_>
+    Istream_ &operator() (Istream_ &in, BinEncoding_t<Params_...> const &enc, std::optional<T_> &dest_val) const {
         if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
             in >> enc.with_demoted_type_encoding().in(type_of(dest_val)); // This will throw if the type doesn't match.
 
@@ -30,8 +30,8 @@ struct ReadInPlace_t<std::optional<T_>,BinEncoding_t<Params_...>> {
 // In case T_ is not default-constructible, this is necessary.
 template <typename T_, typename Encoding_>
 struct ReadValue_t<std::optional<T_>,Encoding_> {
-    template <typename CharT_, typename Traits_>
-    std::optional<T_> operator() (std::basic_istream<CharT_,Traits_> &in, Encoding_ const &enc) const {
+    template <typename Istream_>
+    std::optional<T_> operator() (Istream_ &in, Encoding_ const &enc) const {
         if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
             in >> enc.with_demoted_type_encoding().in(ty<std::optional<T_>>); // This will throw if the type doesn't match.
 
@@ -9,8 +9,8 @@ namespace lvd {
 
 template <typename S_, typename C_, auto... Params_>
 struct ReadInPlace_t<sst::SV_t<S_,C_>,BinEncoding_t<Params_...>> {
-    template <typename CharT_, typename Traits_>
-    std::basic_istream<CharT_,Traits_> &operator() (std::basic_istream<CharT_,Traits_> &in, BinEncoding_t<Params_...> const &enc, sst::SV_t<S_,C_> &dest_val) const {
+    template <typename Istream_>
+    Istream_ &operator() (Istream_ &in, BinEncoding_t<Params_...> const &enc, sst::SV_t<S_,C_> &dest_val) const {
         if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
             in >> enc.with_demoted_type_encoding().in(type_of(dest_val)); // This will throw if the type doesn't match.
 
@@ -25,8 +25,8 @@ struct ReadInPlace_t<sst::SV_t<S_,C_>,BinEncoding_t<Params_...>> {
 // SV_t<S_,C_> is not in general default-constructible, so ReadValue_t has to be specialized.
 template <typename S_, typename C_, typename Encoding_>
 struct ReadValue_t<sst::SV_t<S_,C_>,Encoding_> {
-    template <typename CharT_, typename Traits_>
-    sst::SV_t<S_,C_> operator() (std::basic_istream<CharT_,Traits_> &in, Encoding_ const &enc) const {
+    template <typename Istream_>
+    sst::SV_t<S_,C_> operator() (Istream_ &in, Encoding_ const &enc) const {
         if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
             in >> enc.with_demoted_type_encoding().in(ty<sst::SV_t<S_,C_>>); // This will throw if the type doesn't match.
 
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include "lvd/DecodeBudget.hpp"
 #include "lvd/read.hpp"
 #include "lvd/read_bin_type.hpp"
 #include "lvd/type_string_of.hpp"
@@ -11,26 +13,40 @@ namespace lvd {
 
 template <typename... Types_, auto... Params_>
 struct ReadInPlace_t<std::basic_string<Types_...>,BinEncoding_t<Params_...>> {
-    template <typename CharT_, typename Traits_>
-    std::basic_istream<CharT_,Traits_> &operator() (std::basic_istream<CharT_,Traits_> &in, BinEncoding_t<Params_...> const &enc, std::basic_string<Types_...> &dest_val) const {
+    template <typename Istream_>
+    Istream_ &operator() (Istream_ &in, BinEncoding_t<Params_...> const &enc, std::basic_string<Types_...> &dest_val) const {
         if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
             in >> enc.with_demoted_type_encoding().in(type_of(dest_val)); // This will throw if the type doesn't match.
 
-        static_assert(sizeof(CharT_) == 1, "only supporting chars of size 1 for now");
+        static_assert(sizeof(typename Istream_::char_type) == 1, "only supporting chars of size 1 for now");
 
         // This will suppress unnecessary inner element type info, since it's already present in the given type.
         auto inner_enc = enc.with_demoted_type_encoding();
+        using CharType = typename std::basic_string<Types_...>::value_type;
         auto size = inner_enc.template read<size_t>(in);
-        // TODO: Probably put a limit on the size to avoid bugs in which a huge value is read
-        // causing memory to fill up.
-        dest_val.resize(size);
-        in.read(reinterpret_cast<CharT_ *>(&dest_val[0]), size*sizeof(dest_val[0]));
-        // If called for, endian-swap the contents.
-        if (machine_endianness() != enc.endianness()) {
-            for (auto &c : dest_val)
-                swap_byte_order_of(c);
+        charge_decode_budget<CharType>(size);
+        DecodeNestingLevel nesting_level;
+        dest_val.clear();
+        if constexpr (is_bin_block_encodable_v<CharType,decltype(inner_enc)>) {
+            if (!check_available_bytes(in, size, sizeof(CharType)))
+                return in;
+            // Grow dest_val a chunk at a time as the chars are actually read, so that a corrupt size can't
+            // cause a huge allocation before the stream runs out.  This only byte-swaps if needed, and never
+            // for 1-byte chars.
+            size_t constexpr CHUNK_SIZE = MAX_UNVERIFIED_RESERVE_BYTES / sizeof(CharType);
+            for (size_t n = 0; n < size && in.good(); n += CHUNK_SIZE) {
+                auto chunk_size = std::min(CHUNK_SIZE, size - n);
+                dest_val.resize(n + chunk_size);
+                read_bin_block(in, inner_enc, dest_val.data() + n, chunk_size);
+            }
+            return in;
+        } else {
+            // E.g. wide chars that are varint-encoded.  Each takes at least 1 byte.
+            dest_val.reserve(unverified_reserve_count<CharType>(size, available_bytes_of(in)));
+            for (size_t n = 0; n < size && in.good(); ++n)
+                dest_val += inner_enc.template read<CharType>(in);
+            return in;
         }
-        return in;
     }
 };
 
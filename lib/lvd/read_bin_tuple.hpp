@@ -11,8 +11,8 @@ namespace lvd {
 
 template <typename... Types_, auto... Params_>
 struct ReadInPlace_t<std::tuple<Types_...>,BinEncoding_t<Params_...>> {
-    template <typename CharT_, typename Traits_>
-    std::basic_istream<CharT_,Traits_> &operator() (std::basic_istream<CharT_,Traits_> &in, BinEncoding_t<Params_...> const &enc, std::tuple<Types_...> &dest_val) const {
+    template <typename Istream_>
+    Istream_ &operator() (Istream_ &in, BinEncoding_t<Params_...> const &enc, std::tuple<Types_...> &dest_val) const {
         if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
             in >> enc.with_demoted_type_encoding().in(type_of(dest_val)); // This will throw if the type doesn't match.
 
@@ -25,8 +25,8 @@ struct ReadInPlace_t<std::tuple<Types_...>,BinEncoding_t<Params_...>> {
 // In case either of the pair elements are not default-constructible, this is necessary.
 template <typename Encoding_>
 struct ReadValue_t<std::tuple<>,Encoding_> {
-    template <typename CharT_, typename Traits_>
-    std::tuple<> operator() (std::basic_istream<CharT_,Traits_> &in, Encoding_ const &enc) const {
+    template <typename Istream_>
+    std::tuple<> operator() (Istream_ &in, Encoding_ const &enc) const {
         if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
             in >> enc.with_demoted_type_encoding().in(ty<std::tuple<>>); // This will throw if the type doesn't match.
 
@@ -38,8 +38,8 @@ struct ReadValue_t<std::tuple<>,Encoding_> {
 // In case either of the pair elements are not default-constructible, this is necessary.
 template <typename First_, typename Encoding_>
 struct ReadValue_t<std::tuple<First_>,Encoding_> {
-    template <typename CharT_, typename Traits_>
-    std::tuple<First_> operator() (std::basic_istream<CharT_,Traits_> &in, Encoding_ const &enc) const {
+    template <typename Istream_>
+    std::tuple<First_> operator() (Istream_ &in, Encoding_ const &enc) const {
         if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
             in >> enc.with_demoted_type_encoding().in(ty<std::tuple<First_>>); // This will throw if the type doesn't match.
 
@@ -52,8 +52,8 @@ struct ReadValue_t<std::tuple<First_>,Encoding_> {
 // In case either of the pair elements are not default-constructible, this is necessary.
 template <typename First_, typename... Rest_, typename Encoding_>
 struct ReadValue_t<std::tuple<First_,Rest_...>,Encoding_> {
-    template <typename CharT_, typename Traits_>
-    std::tuple<First_,Rest_...> operator() (std::basic_istream<CharT_,Traits_> &in, Encoding_ const &enc) const {
+    template <typename Istream_>
+    std::tuple<First_,Rest_...> operator() (Istream_ &in, Encoding_ const &enc) const {
         if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
             in >> enc.with_demoted_type_encoding().in(ty<std::tuple<First_,Rest_...>>); // This will throw if the type doesn't match.
 
@@ -61,7 +61,9 @@ struct ReadValue_t<std::tuple<First_,Rest_...>,Encoding_> {
         auto inner_enc = enc.with_demoted_type_encoding();
         // Have to do this separately to guarantee evaluation order.
         auto tuple_first = std::tuple<First_>(inner_enc.template read<First_>(in));
-        return std::tuple_cat(tuple_first, inner_enc.template read<std::tuple<Rest_...>>(in));
+        // The rest of the elements aren't a value on their own, so this bypasses read_value, which would expect
+        // them to be length-framed under FramingEncoding::LENGTH_PREFIXED.
+        return std::tuple_cat(tuple_first, ReadValue_t<std::tuple<Rest_...>,decltype(inner_enc)>()(in, inner_enc));
     }
 };
 
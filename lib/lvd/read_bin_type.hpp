@@ -2,16 +2,53 @@
 
 #pragma once
 
+#include "lvd/literal.hpp"
 #include "lvd/read.hpp"
 #include "lvd/type.hpp"
+#include "lvd/type_id.hpp"
+#include "lvd/type_interning.hpp"
 #include "lvd/type_string_of.hpp"
 
 namespace lvd {
 
+// Reads a type tag (see TypeTag_t) from in, appending its bytes to type_tag.  depth is the nesting depth of type
+// template arguments, which is limited since the input may be untrusted.
+template <typename Istream_, auto... Params_>
+void read_type_tag (Istream_ &in, BinEncoding_t<Params_...> const &enc, std::string &type_tag, size_t depth) {
+    // A type tag is a sequence of varints and varint-length-prefixed strings, regardless of enc.
+    auto varint_enc = enc.template with_type_encoding<TypeEncoding::EXCLUDED>()
+                         .template with_int_encoding<IntEncoding::VARINT>()
+                         .template with_framing_encoding<FramingEncoding::UNFRAMED>();
+    if (depth > MAX_TYPE_TAG_DEPTH)
+        throw std::runtime_error("type tag is nested too deeply");
+
+    auto type_id = varint_enc.template read<uint64_t>(in);
+    if (!in.good())
+        return;
+    type_tag += type_tag_varint(type_id);
+    if (type_id == UNREGISTERED_TYPE_ID) {
+        std::string type_string;
+        in >> varint_enc.in(type_string);
+        if (in.good())
+            type_tag += type_tag_varint(type_string.size()) + type_string;
+    } else if (is_type_template_id(type_id)) {
+        auto template_id = TypeTemplateId(type_id);
+        uint64_t arity = type_template_arity(template_id);
+        if (arity == VARIADIC_TYPE_TEMPLATE_ARITY) {
+            arity = varint_enc.template read<uint64_t>(in);
+            type_tag += type_tag_varint(arity);
+        }
+        for (uint64_t i = 0; i < arity && in.good(); ++i)
+            read_type_tag(in, enc, type_tag, depth+1);
+        if (template_id == TypeTemplateId::ARRAY && in.good())
+            type_tag += type_tag_varint(varint_enc.template read<uint64_t>(in));
+    }
+}
+
 template <typename T_, auto... Params_>
 struct ReadInPlace_t<Type_t<T_>,BinEncoding_t<Params_...>> {
-    template <typename CharT_, typename Traits_>
-    std::basic_istream<CharT_,Traits_> &operator() (std::basic_istream<CharT_,Traits_> &in, BinEncoding_t<Params_...> const &enc, Type_t<T_> &dest_val) const {
+    template <typename Istream_>
+    Istream_ &operator() (Istream_ &in, BinEncoding_t<Params_...> const &enc, Type_t<T_> &dest_val) const {
         if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED) {
             auto s = enc.with_demoted_type_encoding().template read<std::string>(in);
             if (s != "type") // This is somewhat informally defined and may need to change later.
@@ -20,8 +57,31 @@ struct ReadInPlace_t<Type_t<T_>,BinEncoding_t<Params_...>> {
 
         // This will suppress unnecessary inner element type info, since it's already present in the given type.
         auto inner_enc = enc.with_demoted_type_encoding();
-        // This is the string that encodes T_
-        auto s = inner_enc.template read<std::string>(in);
+        auto varint_enc = inner_enc.template with_int_encoding<IntEncoding::VARINT>();
+        // If a TypeInterningReadSession is attached, T_ is encoded as a back-reference to a TypeString that was
+        // already read, or as a TypeString in full.
+        if (auto session = TypeInterningReadSession::of(in); session != nullptr) {
+            auto back_reference = varint_enc.template read<uint64_t>(in);
+            if (!in.good())
+                return in;
+            if (back_reference == 0) {
+                std::string s;
+                in >> inner_enc.in(s);
+                if (!in.good())
+                    return in;
+                back_reference = session->add(std::move(s));
+            }
+            session->validate(size_t(back_reference), TypeString_t<T_>::get());
+            return in;
+        }
+        // Otherwise T_ is encoded as its type tag, which in the common case only has to be compared to the expected one.
+        std::string type_tag;
+        read_type_tag(in, enc, type_tag, 0);
+        if (!in.good() || type_tag == type_tag_of<T_>())
+            return in;
+
+        // Otherwise a type is registered on only one side, or the type doesn't match, so fall back to comparing TypeStrings.
+        auto s = type_string_of_type_tag(type_tag);
         // This just asserts that the type matches.
         if (s != TypeString_t<T_>::get())
             throw std::runtime_error("type mismatch; expected " + literal_of(TypeString_t<T_>::get()) + " but got " + literal_of(s));
@@ -18,8 +18,8 @@ struct ReadInPlace_t<std::variant<Types_...>,BinEncoding_t<Params_...>> {
     static_assert(sizeof...(Types_) > 0, "empty variants not (yet) supported");
     static_assert(sizeof...(Types_) < 0x10000, "that's a lot of types, guy!");
 
-    template <typename CharT_, typename Traits_>
-    std::basic_istream<CharT_,Traits_> &operator() (std::basic_istream<CharT_,Traits_> &in, BinEncoding_t<Params_...> const &enc, std::variant<Types_...> &dest_val) const {
+    template <typename Istream_>
+    Istream_ &operator() (Istream_ &in, BinEncoding_t<Params_...> const &enc, std::variant<Types_...> &dest_val) const {
         if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
             in >> enc.with_demoted_type_encoding().in(type_of(dest_val)); // This will throw if the type doesn't match.
 
@@ -49,8 +49,8 @@ struct ReadValue_t<std::variant<Types_...>,Encoding_> {
     static_assert(sizeof...(Types_) > 0, "empty variants not (yet) supported");
     static_assert(sizeof...(Types_) < 0x10000, "that's a lot of types, guy!");
 
-    template <typename CharT_, typename Traits_>
-    std::variant<Types_...> operator() (std::basic_istream<CharT_,Traits_> &in, Encoding_ const &enc) const {
+    template <typename Istream_>
+    std::variant<Types_...> operator() (Istream_ &in, Encoding_ const &enc) const {
         if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
             in >> enc.with_demoted_type_encoding().in(ty<std::variant<Types_...>>); // This will throw if the type doesn't match.
 
@@ -2,13 +2,46 @@
 
 #pragma once
 
+#include <algorithm>
+#include "lvd/DecodeBudget.hpp"
 #include "lvd/read_bin_container.hpp"
 #include "lvd/type_string_of_vector.hpp"
 #include <vector>
 
 namespace lvd {
 
-template <typename... Types_, typename Encoding_>
-struct ReadInPlace_t<std::vector<Types_...>,Encoding_> : public ReadInPlace_SequenceContainer_t<std::vector<Types_...>,Encoding_> { };
+template <typename... Types_, auto... Params_>
+struct ReadInPlace_t<std::vector<Types_...>,BinEncoding_t<Params_...>> {
+    template <typename Istream_>
+    Istream_ &operator() (Istream_ &in, BinEncoding_t<Params_...> const &enc, std::vector<Types_...> &dest_val) const {
+        using ValueType = typename std::vector<Types_...>::value_type;
+        // The type is already known at this point.
+        auto inner_enc = enc.with_demoted_type_encoding();
+        if constexpr (is_bin_block_encodable_v<ValueType,decltype(inner_enc)>) {
+            // Same input as ReadInPlace_SequenceContainer_t, but the elements are read as a block.
+            if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
+                in >> enc.with_demoted_type_encoding().in(type_of(dest_val)); // This will throw if the type doesn't match.
+            auto size = read_value<size_t>(in, inner_enc);
+            charge_decode_budget<ValueType>(size);
+            DecodeNestingLevel nesting_level;
+            if (!check_available_bytes(in, size, sizeof(ValueType))) {
+                dest_val.clear();
+                return in;
+            }
+            // Grow dest_val a chunk at a time as the elements are actually read, so that a corrupt size can't
+            // cause a huge allocation before the stream runs out.
+            size_t constexpr CHUNK_SIZE = std::max(size_t(1), MAX_UNVERIFIED_RESERVE_BYTES / sizeof(ValueType));
+            dest_val.clear();
+            for (size_t n = 0; n < size && in.good(); n += CHUNK_SIZE) {
+                auto chunk_size = std::min(CHUNK_SIZE, size - n);
+                dest_val.resize(n + chunk_size);
+                read_bin_block(in, inner_enc, dest_val.data() + n, chunk_size);
+            }
+            return in;
+        } else {
+            return ReadInPlace_SequenceContainer_t<std::vector<Types_...>,BinEncoding_t<Params_...>>()(in, enc, dest_val);
+        }
+    }
+};
 
 } // end namespace lvd
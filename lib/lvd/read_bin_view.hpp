@@ -0,0 +1,137 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include <array>
+#include "lvd/ByteReader.hpp"
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include "lvd/read.hpp"
+#include "lvd/read_bin_type.hpp"
+#include "lvd/serialization_view.hpp"
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include "lvd/type_string_of_array.hpp"
+#include "lvd/type_string_of_vector.hpp"
+#include <vector>
+
+namespace lvd {
+
+//
+// Zero-copy reading from a ByteReader (e.g. over a MappedFile).  Instead of materializing owning values, these
+// produce read-only views which refer directly into the ByteReader's buffer, so the buffer must outlive the views.
+// The input is the same as for reading the corresponding owning type (std::basic_string, std::vector or
+// std::array).  If the read fails, then an empty view is returned, and the ByteReader's failbit is set.
+//
+
+// Reads the frame's length if T_ is length-framed (the view readers bypass read_value, so they have to do this
+// themselves), and otherwise returns nullopt.
+template <typename T_, auto... Params_>
+std::optional<size_t> read_view_frame_length (ByteReader &in, BinEncoding_t<Params_...> const &enc) {
+    if constexpr (is_length_framed_v<T_,BinEncoding_t<Params_...>>)
+        return read_frame_length(in, enc);
+    else
+        return std::nullopt;
+}
+
+// Checks that the bytes read since frame_begin (if they were framed) match the frame's length, as read_length_framed
+// does, i.e. reading past the end of the frame fails in, and a frame having bytes left over is an error.  Returns
+// in.good().
+inline bool check_view_frame_length (ByteReader &in, std::optional<size_t> const &frame_length, std::byte const *frame_begin) {
+    if (!frame_length.has_value() || !in.good())
+        return in.good();
+    auto consumed = size_t(in.range().begin() - frame_begin);
+    if (consumed > *frame_length)
+        in.setstate(std::ios_base::failbit);
+    else if (consumed < *frame_length)
+        throw std::runtime_error("length-framed value has " + std::to_string(*frame_length - consumed) + " byte(s) left over after it was read");
+    return in.good();
+}
+
+// Reads a std::basic_string<Char_> as a view.  This is always zero-copy, and is only defined for 1-byte Char_.
+template <typename Char_ = char, auto... Params_>
+std::basic_string_view<Char_> read_bin_string_view (ByteReader &in, BinEncoding_t<Params_...> const &enc) {
+    static_assert(sizeof(Char_) == 1, "zero-copy string views are only supported for 1-byte character types");
+
+    auto frame_length = read_view_frame_length<std::basic_string<Char_>>(in, enc);
+    auto frame_begin = in.range().begin();
+
+    if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
+        in >> enc.with_demoted_type_encoding().in(ty<std::basic_string<Char_>>); // This will throw if the type doesn't match.
+
+    auto inner_enc = enc.with_demoted_type_encoding();
+    auto size = inner_enc.template read<size_t>(in);
+    if (!in.good())
+        return {};
+    auto bytes = in.view(size);
+    if (!check_view_frame_length(in, frame_length, frame_begin))
+        return {};
+    return std::basic_string_view<Char_>(reinterpret_cast<Char_ const *>(bytes.begin()), size_t(bytes.size()));
+}
+
+// Produces a view of count elements of type T_ in the given bytes.  If they can be used in-place (i.e. the
+// encoded byte order matches the machine's and the elements are suitably aligned), the view is zero-copy.
+// Otherwise it owns a converted copy.
+template <typename T_, auto... Params_>
+SequenceView_t<T_> bin_sequence_view_of (Range_t<std::byte const *> const &bytes, BinEncoding_t<Params_...> const &enc) {
+    static_assert(is_bin_block_encodable_v<T_,BinEncoding_t<Params_...>>);
+    auto count = size_t(bytes.size()) / sizeof(T_);
+    bool needs_swap = false;
+    if constexpr (sizeof(T_) > 1 && !enc.is_statically_machine_endian())
+        needs_swap = enc.endianness() != machine_endianness();
+    bool is_aligned = reinterpret_cast<std::uintptr_t>(bytes.begin()) % alignof(T_) == 0;
+    if (!needs_swap && is_aligned) {
+        auto elements = reinterpret_cast<T_ const *>(bytes.begin());
+        return SequenceView_t<T_>(Range_t<T_ const *>(elements, elements+count));
+    } else {
+        std::vector<T_> storage(count);
+        // Calling memcpy with nullptr is undefined, even with a 0 count.
+        if (count > 0)
+            std::memcpy(storage.data(), bytes.begin(), count*sizeof(T_));
+        if (needs_swap)
+            swap_byte_order_of_each_leaf(storage.data(), count);
+        return SequenceView_t<T_>(std::move(storage));
+    }
+}
+
+// Reads a std::vector<T_> as a view.
+template <typename T_, auto... Params_>
+SequenceView_t<T_> read_bin_vector_view (ByteReader &in, BinEncoding_t<Params_...> const &enc) {
+    auto frame_length = read_view_frame_length<std::vector<T_>>(in, enc);
+    auto frame_begin = in.range().begin();
+
+    if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
+        in >> enc.with_demoted_type_encoding().in(ty<std::vector<T_>>); // This will throw if the type doesn't match.
+
+    auto inner_enc = enc.with_demoted_type_encoding();
+    auto size = inner_enc.template read<size_t>(in);
+    // Check the size before multiplying, so that a corrupt size can't overflow.
+    if (!in.good() || size > size_t(in.range().size()) / sizeof(T_)) {
+        in.setstate(std::ios_base::eofbit | std::ios_base::failbit);
+        return SequenceView_t<T_>(Range_t<T_ const *>(nullptr, nullptr));
+    }
+    auto bytes = in.view(size*sizeof(T_));
+    if (!check_view_frame_length(in, frame_length, frame_begin))
+        return SequenceView_t<T_>(Range_t<T_ const *>(nullptr, nullptr));
+    return bin_sequence_view_of<T_>(bytes, inner_enc);
+}
+
+// Reads a std::array<T_,N_> as a view.
+template <typename T_, size_t N_, auto... Params_>
+SequenceView_t<T_> read_bin_array_view (ByteReader &in, BinEncoding_t<Params_...> const &enc) {
+    auto frame_length = read_view_frame_length<std::array<T_,N_>>(in, enc);
+    auto frame_begin = in.range().begin();
+
+    if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
+        in >> enc.with_demoted_type_encoding().in(ty<std::array<T_,N_>>); // This will throw if the type doesn't match.
+
+    auto inner_enc = enc.with_demoted_type_encoding();
+    auto bytes = in.view(N_*sizeof(T_));
+    if (!check_view_frame_length(in, frame_length, frame_begin))
+        return SequenceView_t<T_>(Range_t<T_ const *>(nullptr, nullptr));
+    return bin_sequence_view_of<T_>(bytes, inner_enc);
+}
+
+} // end namespace lvd
@@ -0,0 +1,32 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include <array>
+#include "lvd/read.hpp"
+#include "lvd/type_string_of_array.hpp"
+
+namespace lvd {
+
+template <typename T_, size_t N_, auto... Params_>
+struct ReadInPlace_t<std::array<T_,N_>,TextEncoding_t<Params_...>> {
+    template <typename Istream_>
+    Istream_ &operator() (Istream_ &in, TextEncoding_t<Params_...> const &enc, std::array<T_,N_> &dest_val) const {
+        if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
+            expect_text_chars(in, type_string_of<std::array<T_,N_>>()); // This will throw if the type doesn't match.
+
+        // The type is already known at this point.
+        auto inner_enc = enc.with_demoted_type_encoding();
+        // Unlike the other containers, the number of elements is fixed.
+        expect_text_char(in, '(');
+        for (size_t i = 0; i < N_; ++i) {
+            if (i > 0)
+                expect_text_char(in, ',');
+            read_in_place(in, inner_enc, dest_val[i]);
+        }
+        expect_text_char(in, ')');
+        return in;
+    }
+};
+
+} // end namespace lvd
@@ -0,0 +1,80 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include "lvd/associative_container.hpp"
+#include "lvd/DecodeBudget.hpp"
+#include "lvd/read.hpp"
+#include "lvd/remove_cv_recursive.hpp"
+#include "lvd/type_string_of.hpp"
+
+namespace lvd {
+
+// Reads the parenthesized, comma-delimited elements of a container, e.g. `(1, 2, 3)` or `()`, calling
+// read_element() for each element, which must read exactly that element from in.  The text doesn't claim a size
+// up front, so the current DecodeBudget (if any) is charged for each element of type T_ as it's read.
+template <typename T_, typename Istream_, typename ReadElement_>
+void read_text_elements (Istream_ &in, ReadElement_ &&read_element) {
+    auto budget = DecodeBudget::current();
+    DecodeNestingLevel nesting_level;
+    expect_text_char(in, '(');
+    if (consume_text_char(in, ')'))
+        return;
+    while (true) {
+        if (budget != nullptr)
+            budget->charge(1, sizeof(T_));
+        read_element();
+        skip_text_whitespace(in);
+        auto c = in.get();
+        if (c == ')')
+            return;
+        if (c != ',')
+            throw_malformed_text("',' or ')'", text_char_description<Istream_>(c));
+    }
+}
+
+// Helper template
+template <typename Container_, typename Encoding_>
+struct ReadInPlace_AssociativeContainer_t;
+
+template <typename Container_, auto... Params_>
+struct ReadInPlace_AssociativeContainer_t<Container_,TextEncoding_t<Params_...>> {
+    template <typename Istream_>
+    Istream_ &operator() (Istream_ &in, TextEncoding_t<Params_...> const &enc, Container_ &dest_val) const {
+        if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
+            expect_text_chars(in, type_string_of<Container_>()); // This will throw if the type doesn't match.
+
+        // The type is already known at this point.
+        auto inner_enc = enc.with_demoted_type_encoding();
+        using ValueType = remove_cv_recursive_t<typename Container_::value_type>;
+        dest_val.clear();
+        read_text_elements<ValueType>(in, [&in, &inner_enc, &dest_val](){
+            emplace_in_serialized_order(dest_val, read_value<ValueType>(in, inner_enc));
+        });
+        return in;
+    }
+};
+
+// Helper template
+template <typename Container_, typename Encoding_>
+struct ReadInPlace_SequenceContainer_t;
+
+template <typename Container_, auto... Params_>
+struct ReadInPlace_SequenceContainer_t<Container_,TextEncoding_t<Params_...>> {
+    template <typename Istream_>
+    Istream_ &operator() (Istream_ &in, TextEncoding_t<Params_...> const &enc, Container_ &dest_val) const {
+        if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
+            expect_text_chars(in, type_string_of<Container_>()); // This will throw if the type doesn't match.
+
+        // The type is already known at this point.
+        auto inner_enc = enc.with_demoted_type_encoding();
+        using ValueType = remove_cv_recursive_t<typename Container_::value_type>;
+        dest_val.clear();
+        read_text_elements<ValueType>(in, [&in, &inner_enc, &dest_val](){
+            dest_val.emplace_back(read_value<ValueType>(in, inner_enc));
+        });
+        return in;
+    }
+};
+
+} // end namespace lvd
@@ -0,0 +1,15 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include "lvd/read_text_container.hpp"
+#include "lvd/read_text_pair.hpp"
+#include "lvd/type_string_of_map.hpp"
+#include <map>
+
+namespace lvd {
+
+template <typename... Types_, auto... Params_>
+struct ReadInPlace_t<std::map<Types_...>,TextEncoding_t<Params_...>> : public ReadInPlace_AssociativeContainer_t<std::map<Types_...>,TextEncoding_t<Params_...>> { };
+
+} // end namespace lvd
@@ -0,0 +1,51 @@
+// 2021.02.13 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include "lvd/read.hpp"
+#include "lvd/type_string_of_optional.hpp"
+#include <optional>
+
+namespace lvd {
+
+// In case T_ is not default-constructible, this is the primary implementation.
+template <typename T_, auto... Params_>
+struct ReadValue_t<std::optional<T_>,TextEncoding_t<Params_...>> {
+    template <typename Istream_>
+    std::optional<T_> operator() (Istream_ &in, TextEncoding_t<Params_...> const &enc) const {
+        if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED) {
+            expect_text_chars(in, type_string_of<std::optional<T_>>()); // This will throw if the type doesn't match.
+            expect_text_char(in, '(');
+        }
+
+        // The type is already known at this point.
+        auto inner_enc = enc.with_demoted_type_encoding();
+        std::optional<T_> retval;
+        if (skip_text_whitespace(in) != 'n') {
+            retval.emplace(inner_enc.template read<T_>(in));
+        } else if constexpr (std::is_floating_point_v<T_>) {
+            // Both `nullopt` and `nan` start with 'n', and only one char can be peeked, so read the whole token.
+            std::array<char,64> buffer;
+            auto token = read_text_token(in, buffer);
+            if (token != "nullopt")
+                retval.emplace(parsed_text_number<T_>(token));
+        } else {
+            expect_text_chars(in, "nullopt");
+        }
+
+        if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
+            expect_text_char(in, ')');
+        return retval;
+    }
+};
+
+template <typename T_, auto... Params_>
+struct ReadInPlace_t<std::optional<T_>,TextEncoding_t<Params_...>> {
+    template <typename Istream_>
+    Istream_ &operator() (Istream_ &in, TextEncoding_t<Params_...> const &enc, std::optional<T_> &dest_val) const {
+        dest_val = ReadValue_t<std::optional<T_>,TextEncoding_t<Params_...>>()(in, enc);
+        return in;
+    }
+};
+
+} // end namespace lvd
@@ -0,0 +1,50 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include "lvd/read.hpp"
+#include "lvd/type_string_of_pair.hpp"
+#include <utility>
+
+namespace lvd {
+
+template <typename... Types_, auto... Params_>
+struct ReadInPlace_t<std::pair<Types_...>,TextEncoding_t<Params_...>> {
+    template <typename Istream_>
+    Istream_ &operator() (Istream_ &in, TextEncoding_t<Params_...> const &enc, std::pair<Types_...> &dest_val) const {
+        if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
+            expect_text_chars(in, type_string_of<std::pair<Types_...>>()); // This will throw if the type doesn't match.
+
+        // The type is already known at this point.
+        auto inner_enc = enc.with_demoted_type_encoding();
+        expect_text_char(in, '(');
+        read_in_place(in, inner_enc, dest_val.first);
+        expect_text_char(in, ',');
+        read_in_place(in, inner_enc, dest_val.second);
+        expect_text_char(in, ')');
+        return in;
+    }
+};
+
+// In case either of the pair elements are not default-constructible, this is necessary.
+template <typename F_, typename S_, auto... Params_>
+struct ReadValue_t<std::pair<F_,S_>,TextEncoding_t<Params_...>> {
+    template <typename Istream_>
+    std::pair<F_,S_> operator() (Istream_ &in, TextEncoding_t<Params_...> const &enc) const {
+        if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
+            expect_text_chars(in, type_string_of<std::pair<F_,S_>>()); // This will throw if the type doesn't match.
+
+        // The type is already known at this point.
+        auto inner_enc = enc.with_demoted_type_encoding();
+        // Because we can't depend on the order of evaluation of function arguments, we have to guarantee order this way.
+        // This may not work if the types are not movable.
+        expect_text_char(in, '(');
+        auto first = inner_enc.template read<F_>(in);
+        expect_text_char(in, ',');
+        auto second = inner_enc.template read<S_>(in);
+        expect_text_char(in, ')');
+        return std::pair<F_,S_>(std::move(first), std::move(second));
+    }
+};
+
+} // end namespace lvd
@@ -0,0 +1,42 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include "lvd/read.hpp"
+#include "lvd/sst/SV_t.hpp"
+#include "lvd/type_string_of.hpp"
+
+namespace lvd {
+
+template <typename S_, typename C_, auto... Params_>
+struct ReadInPlace_t<sst::SV_t<S_,C_>,TextEncoding_t<Params_...>> {
+    template <typename Istream_>
+    Istream_ &operator() (Istream_ &in, TextEncoding_t<Params_...> const &enc, sst::SV_t<S_,C_> &dest_val) const {
+        if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED) {
+            expect_text_chars(in, type_string_of<sst::SV_t<S_,C_>>()); // This will throw if the type doesn't match.
+            expect_text_char(in, '(');
+        }
+
+        // The type is already known at this point.
+        auto inner_enc = enc.with_demoted_type_encoding();
+        // Use assign-move so that the validity check is done automatically.
+        dest_val = inner_enc.template read<C_>(in);
+
+        if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
+            expect_text_char(in, ')');
+        return in;
+    }
+};
+
+// SV_t<S_,C_> is not in general default-constructible, so ReadValue_t has to be specialized.
+template <typename S_, typename C_, auto... Params_>
+struct ReadValue_t<sst::SV_t<S_,C_>,TextEncoding_t<Params_...>> {
+    template <typename Istream_>
+    sst::SV_t<S_,C_> operator() (Istream_ &in, TextEncoding_t<Params_...> const &enc) const {
+        auto retval = sst::SV_t<S_,C_>{sst::no_check};
+        ReadInPlace_t<sst::SV_t<S_,C_>,TextEncoding_t<Params_...>>()(in, enc, retval);
+        return retval;
+    }
+};
+
+} // end namespace lvd
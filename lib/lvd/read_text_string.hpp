@@ -0,0 +1,36 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include "lvd/read.hpp"
+#include "lvd/type_string_of.hpp"
+#include <string>
+
+namespace lvd {
+
+// TODO: Implement one for generic std::basic_string
+template <auto... Params_>
+struct ReadInPlace_t<std::string,TextEncoding_t<Params_...>> {
+    template <typename Istream_>
+    Istream_ &operator() (Istream_ &in, TextEncoding_t<Params_...> const &enc, std::string &dest_val) const {
+        if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED) {
+            expect_text_chars(in, type_string_of<std::string>());
+            expect_text_char(in, '(');
+        }
+
+        // This is the string literal format produced by literal_of.  Appending to dest_val reuses its capacity.
+        dest_val.clear();
+        expect_text_char(in, '"');
+        for (auto c = get_text_char(in, "'\"'"); c != '"'; c = get_text_char(in, "'\"'")) {
+            if (c == '\\')
+                c = read_text_escaped_char(in);
+            dest_val += c;
+        }
+
+        if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
+            expect_text_char(in, ')');
+        return in;
+    }
+};
+
+} // end namespace lvd
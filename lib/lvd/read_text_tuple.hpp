@@ -0,0 +1,99 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include "lvd/read.hpp"
+#include "lvd/type_string_of_tuple.hpp"
+#include <tuple>
+#include <utility>
+
+namespace lvd {
+
+// Reads the comma-delimited elements of a text-encoded tuple (not including its parens) in-place, in order.
+template <typename Istream_, typename Encoding_, typename... Types_, size_t... INDICES_>
+void read_text_tuple_elements_in_place (Istream_ &in, Encoding_ const &inner_enc, std::tuple<Types_...> &dest_val, std::index_sequence<INDICES_...>) {
+    // The comma operator guarantees left-to-right evaluation order.
+    ((INDICES_ > 0 ? expect_text_char(in, ',') : void(), void(read_in_place(in, inner_enc, std::get<INDICES_>(dest_val)))), ...);
+}
+
+// Reads the comma-delimited elements of a text-encoded tuple (not including its parens) in order, producing
+// the tuple.  This works even if the element types aren't default-constructible.
+template <typename First_, typename... Rest_, typename Istream_, typename Encoding_>
+std::tuple<First_,Rest_...> read_text_tuple_elements (Istream_ &in, Encoding_ const &inner_enc) {
+    // Have to do this separately to guarantee evaluation order.
+    auto tuple_first = std::tuple<First_>(inner_enc.template read<First_>(in));
+    if constexpr (sizeof...(Rest_) == 0) {
+        return tuple_first;
+    } else {
+        expect_text_char(in, ',');
+        return std::tuple_cat(std::move(tuple_first), read_text_tuple_elements<Rest_...>(in, inner_enc));
+    }
+}
+
+// Reads a text-encoded tuple, e.g. `()`, `(x,)`, or `(x, y, z)`, producing the tuple.
+template <typename... Types_, typename Istream_, auto... Params_>
+std::tuple<Types_...> read_text_tuple (Istream_ &in, TextEncoding_t<Params_...> const &enc) {
+    if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
+        expect_text_chars(in, type_string_of<std::tuple<Types_...>>()); // This will throw if the type doesn't match.
+
+    // The type is already known at this point.
+    auto inner_enc = enc.with_demoted_type_encoding();
+    expect_text_char(in, '(');
+    if constexpr (sizeof...(Types_) == 0) {
+        expect_text_char(in, ')');
+        return std::tuple<>();
+    } else {
+        auto retval = read_text_tuple_elements<Types_...>(in, inner_enc);
+        if constexpr (sizeof...(Types_) == 1)
+            expect_text_char(in, ','); // A 1-tuple is written as (value,)
+        expect_text_char(in, ')');
+        return retval;
+    }
+}
+
+template <typename... Types_, auto... Params_>
+struct ReadInPlace_t<std::tuple<Types_...>,TextEncoding_t<Params_...>> {
+    template <typename Istream_>
+    Istream_ &operator() (Istream_ &in, TextEncoding_t<Params_...> const &enc, std::tuple<Types_...> &dest_val) const {
+        if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
+            expect_text_chars(in, type_string_of<std::tuple<Types_...>>()); // This will throw if the type doesn't match.
+
+        // The type is already known at this point.
+        auto inner_enc = enc.with_demoted_type_encoding();
+        expect_text_char(in, '(');
+        if constexpr (sizeof...(Types_) > 0)
+            read_text_tuple_elements_in_place(in, inner_enc, dest_val, std::index_sequence_for<Types_...>());
+        if constexpr (sizeof...(Types_) == 1)
+            expect_text_char(in, ','); // A 1-tuple is written as (value,)
+        expect_text_char(in, ')');
+        return in;
+    }
+};
+
+// In case any of the tuple elements are not default-constructible, these are necessary.  They mirror the
+// ReadValue_t specializations in read_bin_tuple.hpp so that neither is ambiguous with the other.
+template <auto... Params_>
+struct ReadValue_t<std::tuple<>,TextEncoding_t<Params_...>> {
+    template <typename Istream_>
+    std::tuple<> operator() (Istream_ &in, TextEncoding_t<Params_...> const &enc) const {
+        return read_text_tuple<>(in, enc);
+    }
+};
+
+template <typename First_, auto... Params_>
+struct ReadValue_t<std::tuple<First_>,TextEncoding_t<Params_...>> {
+    template <typename Istream_>
+    std::tuple<First_> operator() (Istream_ &in, TextEncoding_t<Params_...> const &enc) const {
+        return read_text_tuple<First_>(in, enc);
+    }
+};
+
+template <typename First_, typename... Rest_, auto... Params_>
+struct ReadValue_t<std::tuple<First_,Rest_...>,TextEncoding_t<Params_...>> {
+    template <typename Istream_>
+    std::tuple<First_,Rest_...> operator() (Istream_ &in, TextEncoding_t<Params_...> const &enc) const {
+        return read_text_tuple<First_,Rest_...>(in, enc);
+    }
+};
+
+} // end namespace lvd
@@ -0,0 +1,27 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include "lvd/read.hpp"
+#include "lvd/type.hpp"
+#include "lvd/type_string_of.hpp"
+
+namespace lvd {
+
+template <typename T_, auto... Params_>
+struct ReadInPlace_t<Type_t<T_>,TextEncoding_t<Params_...>> {
+    template <typename Istream_>
+    Istream_ &operator() (Istream_ &in, TextEncoding_t<Params_...> const &enc, Type_t<T_> &dest_val) const {
+        if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED) {
+            expect_text_chars(in, "type"); // This is somewhat informally defined and may need to change later.
+            expect_text_char(in, '(');
+        }
+        // This will throw if the type doesn't match.
+        expect_text_chars(in, type_string_of<T_>());
+        if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
+            expect_text_char(in, ')');
+        return in;
+    }
+};
+
+} // end namespace lvd
@@ -0,0 +1,14 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include "lvd/read_text_container.hpp"
+#include "lvd/type_string_of_vector.hpp"
+#include <vector>
+
+namespace lvd {
+
+template <typename... Types_, auto... Params_>
+struct ReadInPlace_t<std::vector<Types_...>,TextEncoding_t<Params_...>> : public ReadInPlace_SequenceContainer_t<std::vector<Types_...>,TextEncoding_t<Params_...>> { };
+
+} // end namespace lvd
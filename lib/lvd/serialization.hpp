@@ -2,10 +2,18 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include "lvd/associative_container.hpp"
+#include "lvd/bitpack.hpp"
+#include <cassert>
 #include <cstddef>
+#include <cstring>
+#include "lvd/DecodeBudget.hpp"
 #include "lvd/endian.hpp"
+#include "lvd/fixed_layout.hpp"
 #include "lvd/g_req_context.hpp"
+#include <iterator>
 #include "lvd/Range_t.hpp"
 #include "lvd/remove_cv_recursive.hpp"
 #include <map>
@@ -41,6 +49,12 @@ template <typename T_> struct DeserializeTo_t;
 //     template <typename Range_, typename = std::enable_if_t<lvd::is_Range_t<Range_>>>
 //     T_ operator() (Range_ &&source_range) const
 template <typename T_> struct DeserializedTo_t;
+// Defines the exact number of bytes that SerializeFrom_t<T_> produces for a given value, so that a buffer
+// can be sized before serializing into it.  Template-specialization should provide
+//     static bool constexpr IS_FIXED;     // true iff every value of T_ serializes to the same number of bytes
+//     static size_t constexpr FIXED_SIZE; // that number of bytes if IS_FIXED, otherwise 0
+//     size_t operator() (T_ const &source) const
+template <typename T_> struct SerializedSize_t;
 
 //
 // These are convenience functions that do type deduction and generally reduce boilerplate.
@@ -58,12 +72,107 @@ void deserialize_to (T_ &dest, Range_ &&source_range) {
     DeserializeTo_t<T_>()(dest, std::forward<Range_>(source_range));
 }
 
-// Convenience function to get the serialized value as a std::vector<std::byte>.
+// Returns the number of bytes that serialize_from(source, ...) produces.  Convenience function for using
+// SerializedSize_t with type deduction.
+template <typename T_>
+size_t serialized_size_of (T_ const &source) {
+    return SerializedSize_t<T_>()(source);
+}
+
+// Is true iff SerializedSize_t is implemented for T_.  In particular, it's false for a type that only
+// specializes SerializeFrom_t, or for a container of such a type.
+template <typename T_>
+inline bool constexpr has_serialized_size_v = std::is_invocable_r_v<size_t,SerializedSize_t<T_> const &,T_ const &>;
+
+// Output iterator which writes bytes to a raw buffer.  All copies share the write position (the referenced
+// std::byte pointer), so like std::back_insert_iterator, it can be passed by value through nested calls to
+// serialize_from.  If constructed with the end of the buffer, then writing past it is a req failure (which
+// leaves the buffer untouched past its end); otherwise it doesn't do any bounds checking, so the buffer must have
+// at least serialized_size_of(source) bytes available.  This is for serializing directly into e.g. a network frame
+// or shared memory.
+class ByteInserter_t {
+public:
+
+    using iterator_category = std::output_iterator_tag;
+    using value_type = void;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = void;
+
+    explicit ByteInserter_t (std::byte *&cursor) : m_cursor(&cursor), m_end(nullptr) { }
+    ByteInserter_t (std::byte *&cursor, std::byte const *end) : m_cursor(&cursor), m_end(end) { }
+
+    ByteInserter_t &operator = (std::byte b) {
+        check_available(1);
+        *(*m_cursor)++ = b;
+        return *this;
+    }
+    ByteInserter_t &operator * () { return *this; }
+    ByteInserter_t &operator ++ () { return *this; }
+    ByteInserter_t operator ++ (int) { return *this; }
+
+    // Bulk version of operator=, which is a single memcpy.
+    void write (std::byte const *bytes, size_t count) {
+        check_available(count);
+        std::memcpy(*m_cursor, bytes, count);
+        *m_cursor += count;
+    }
+
+private:
+
+    void check_available (size_t count) const {
+        // The req is only evaluated upon failure, since it's much more expensive than the comparison.
+        if (m_end != nullptr && count > size_t(m_end - *m_cursor))
+            LVD_G_REQ_LEQ(count, size_t(m_end - *m_cursor), "write would overrun the end of the buffer (does SerializedSize_t disagree with SerializeFrom_t?)");
+    }
+
+    std::byte **m_cursor;
+    std::byte const *m_end;
+};
+
+// Defined in lvd/serialization_segments.hpp.
+class SegmentInserter_t;
+
+// Copies [begin, end) into dest, using ByteInserter_t::write or SegmentInserter_t::write if possible, otherwise
+// std::copy.  Returns the advanced dest iterator.
+template <typename DestIterator_>
+DestIterator_ copy_bytes (std::byte const *begin, std::byte const *end, DestIterator_ dest) {
+    if constexpr (std::is_same_v<DestIterator_,ByteInserter_t> || std::is_same_v<DestIterator_,SegmentInserter_t>) {
+        dest.write(begin, end - begin);
+        return dest;
+    } else {
+        return std::copy(begin, end, dest);
+    }
+}
+
+// Same as copy_bytes, except that [begin, end) must be the in-memory representation of (part of) the value being
+// serialized, rather than of a temporary, so that a SegmentInserter_t can refer to it in place instead of copying it.
+template <typename DestIterator_>
+DestIterator_ reference_bytes (std::byte const *begin, std::byte const *end, DestIterator_ dest) {
+    if constexpr (std::is_same_v<DestIterator_,SegmentInserter_t>) {
+        dest.write_reference(begin, end - begin);
+        return dest;
+    } else {
+        return copy_bytes(begin, end, dest);
+    }
+}
+
+// Convenience function to get the serialized value as a std::vector<std::byte>.  If SerializedSize_t is
+// implemented for T_, then the vector is allocated exactly once and written through a raw pointer, and it's
+// a req failure if SerializedSize_t disagrees with SerializeFrom_t.
 template <typename T_>
 std::vector<std::byte> serialized_from (T_ const &source) {
-    std::vector<std::byte> retval;
-    serialize_from(source, std::back_inserter(retval));
-    return retval;
+    if constexpr (has_serialized_size_v<T_>) {
+        std::vector<std::byte> retval(serialized_size_of(source));
+        std::byte *cursor = retval.data();
+        serialize_from(source, ByteInserter_t(cursor, retval.data() + retval.size()));
+        LVD_G_REQ_EQ(size_t(cursor - retval.data()), retval.size(), "SerializedSize_t disagrees with SerializeFrom_t");
+        return retval;
+    } else {
+        std::vector<std::byte> retval;
+        serialize_from(source, std::back_inserter(retval));
+        return retval;
+    }
 }
 
 // Convenience function to get a deserialized value.
@@ -81,6 +190,87 @@ T_ deserialized_to (Args_&&... args) {
 template <typename T_>
 inline bool constexpr is_basic_serializable_v = std::is_arithmetic_v<T_> || std::is_same_v<T_,std::byte>;
 
+// LeafPredicate_ for is_fixed_layout_v which accepts basic-serializable leaf types.
+struct BasicSerializableLeaf {
+    template <typename T_>
+    static bool constexpr value = is_basic_serializable_v<T_>;
+};
+
+// Is true iff T_ is basic-serializable, or a fixed-layout aggregate (see lvd/fixed_layout.hpp) of basic-serializable
+// values, e.g. std::pair<int32_t,float> or std::array<uint16_t,3>.  The serialized representation of such a value is
+// its in-memory representation (modulo byte order), so it and contiguous arrays of it are [de]serialized as a block.
+template <typename T_>
+inline bool constexpr is_fixed_layout_serializable_v = is_fixed_layout_v<T_,BasicSerializableLeaf>;
+
+// A Range_t whose size has already been checked to be sufficient for everything that will be deserialized from
+// it, so that the per-value size checks can be skipped.  This is only ever constructed by deserialize_validated
+// (below), and only for types that have a fixed serialized size, so that the single up-front check is exact.
+template <typename Iterator_>
+class PrevalidatedRange_t : public Range_t<Iterator_> {
+public:
+
+    using Range_t<Iterator_>::Range_t;
+};
+
+template <typename Iterator_> struct is_Range_t_<PrevalidatedRange_t<Iterator_>> : public std::true_type { };
+template <typename Iterator_> struct Range_t_iterator<PrevalidatedRange_t<Iterator_>> { using type = Iterator_; };
+
+template <typename T_> struct is_PrevalidatedRange_t_ : public std::false_type { };
+template <typename Iterator_> struct is_PrevalidatedRange_t_<PrevalidatedRange_t<Iterator_>> : public std::true_type { };
+
+// Determines if a given type T_ (ignoring references and cv-qualifiers) is a PrevalidatedRange_t<Iterator_>.
+template <typename T_>
+inline bool constexpr is_PrevalidatedRange_t = is_PrevalidatedRange_t_<std::decay_t<T_>>::value;
+
+// Specialized in lvd/serialization_segments.hpp for GatheredRange_t, which is the source range used to finish a
+// gather-read, in which the blocks that were referenced in place were read directly into the destination.
+template <typename T_> struct is_GatheredRange_t_ : public std::false_type { };
+
+// Determines if a given type T_ (ignoring references and cv-qualifiers) is a GatheredRange_t.
+template <typename T_>
+inline bool constexpr is_GatheredRange_t = is_GatheredRange_t_<std::decay_t<T_>>::value;
+
+// Requires that source_range has at least byte_count bytes remaining, unless it's a PrevalidatedRange_t.  The
+// comparison is done inline so that the failure-reporting machinery is only invoked upon failure.
+template <typename Range_>
+void require_source_size (Range_ const &source_range, size_t byte_count) {
+    if constexpr (!is_PrevalidatedRange_t<Range_>) {
+        // It's probably rude to abort upon an input error.  But for now, whateva.
+        if (size_t(source_range.size()) < byte_count)
+            LVD_G_REQ_GEQ(size_t(source_range.size()), byte_count, "source_range.size() is not large enough to read the dest value");
+    }
+}
+
+// Same as require_source_size, but for the block of count basic-serializable values which DeserializeTo_Range_t
+// reads, and which a GatheredRange_t may already have read in place.
+template <typename Range_>
+void require_source_block_size (Range_ const &source_range, size_t byte_count) {
+    if constexpr (is_GatheredRange_t<Range_>) {
+        if (source_range.is_at_reference(byte_count))
+            return;
+    }
+    require_source_size(source_range, byte_count);
+}
+
+// Calls function(range) to deserialize count values of type T_ from source_range.  If T_ has a fixed serialized
+// size, then the size of source_range is checked once for all count values, and range is a PrevalidatedRange_t,
+// so no further checks are done while deserializing the values.  Otherwise range is source_range itself.  In
+// either case, source_range is advanced past what was read.  function should pass range on to deserialize_to
+// etc as an rvalue (i.e. std::move(range)), as is the convention for Range_ parameters.  Note that because the check is done before any
+// values are deserialized, it also rejects a corrupt count before it's used to allocate anything.
+template <typename T_, typename Range_, typename Function_>
+void deserialize_validated (Range_ &source_range, size_t count, Function_ const &function) {
+    // A GatheredRange_t can't be prevalidated, since its bytes aren't all in one buffer.
+    if constexpr (SerializedSize_t<T_>::IS_FIXED && !is_PrevalidatedRange_t<Range_> && !is_GatheredRange_t<Range_>) {
+        require_source_size(source_range, count*SerializedSize_t<T_>::FIXED_SIZE);
+        auto prevalidated_range = PrevalidatedRange_t<Range_t_iterator_t<std::decay_t<Range_>>>(source_range.begin(), source_range.end());
+        function(prevalidated_range);
+        source_range.begin() = prevalidated_range.begin();
+    } else {
+        function(source_range);
+    }
+}
+
 // This default implementation works only for integral or floating point types.
 template <typename T_>
 struct SerializeFrom_t {
@@ -90,7 +280,7 @@ struct SerializeFrom_t {
         endian_change(machine_endianness(), Endianness::LIL, source);
         std::byte const *source_begin = reinterpret_cast<std::byte const *>(&source);
         std::byte const *source_end = source_begin + sizeof(T_);
-        std::copy(source_begin, source_end, dest);
+        copy_bytes(source_begin, source_end, dest);
     }
 };
 
@@ -99,8 +289,7 @@ template <typename T_>
 struct DeserializeTo_t {
     template <typename Range_, typename = std::enable_if_t<is_Range_t<Range_>>, typename = std::enable_if_t<is_basic_serializable_v<T_>>>
     void operator() (T_ &dest, Range_ &&source_range) const {
-        // It's probably rude to abort upon an input error.  But for now, whateva.
-        LVD_G_REQ_GEQ(size_t(source_range.size()), sizeof(T_), "source_range.size() is not large enough to read a value of the dest type");
+        require_source_size(source_range, sizeof(T_));
 
         std::byte *dest_begin = reinterpret_cast<std::byte *>(&dest);
         std::copy(source_range.begin(), source_range.begin()+sizeof(T_), dest_begin);
@@ -111,6 +300,31 @@ struct DeserializeTo_t {
     }
 };
 
+// Helper for SerializedSize_t specializations where each value has the same serialized size.
+template <typename T_, size_t FIXED_SIZE_>
+struct SerializedSize_FixedSize_t {
+    static bool constexpr IS_FIXED = true;
+    static size_t constexpr FIXED_SIZE = FIXED_SIZE_;
+    size_t constexpr operator() (T_ const &) const { return FIXED_SIZE; }
+};
+
+// Helper for SerializedSize_t specializations where the serialized size depends on the value.
+struct SerializedSize_VariableSize_t {
+    static bool constexpr IS_FIXED = false;
+    static size_t constexpr FIXED_SIZE = 0;
+};
+
+// This default implementation works only for integral or floating point types.  For other types, it
+// provides no operator(), so has_serialized_size_v is false.
+template <typename T_>
+struct SerializedSize_t
+    :   public std::conditional_t<
+            is_basic_serializable_v<T_>,
+            SerializedSize_FixedSize_t<T_,sizeof(T_)>,
+            SerializedSize_VariableSize_t
+        >
+{ };
+
 // This default implementation works only for default-constructible types.
 template <typename T_>
 struct DeserializedTo_t {
@@ -128,15 +342,47 @@ struct DeserializedTo_t {
 // meant to be more low-level and raw.
 //
 
+// Is true iff Iterator_ is a pointer into a contiguous array of basic-serializable (or, more generally,
+// fixed-layout-serializable) values.  A Range_t over such an Iterator_ is [de]serialized as a single block copy,
+// followed by a bulk byte-swap only if the machine endianness differs from the serialized endianness (which is
+// always LIL).
+template <typename Iterator_>
+inline bool constexpr is_contiguous_basic_serializable_iterator_v =
+    std::is_pointer_v<Iterator_> && is_fixed_layout_serializable_v<std::remove_cv_t<std::remove_pointer_t<Iterator_>>>;
+
+// Is true iff Iterator_ is known to iterate over a contiguous array of std::byte, so that e.g. a view can
+// point directly into it.  C++17 has no way to detect contiguous iterators in general, so this only accepts
+// pointers and the iterators of std::vector<std::byte>.
+template <typename Iterator_>
+inline bool constexpr is_contiguous_byte_iterator_v =
+    std::is_same_v<Iterator_,std::byte *> ||
+    std::is_same_v<Iterator_,std::byte const *> ||
+    std::is_same_v<Iterator_,std::vector<std::byte>::iterator> ||
+    std::is_same_v<Iterator_,std::vector<std::byte>::const_iterator>;
+
 template <typename Iterator_>
 struct SerializeFrom_Range_t {
     template <typename DestIterator_>
     void operator() (lvd::Range_t<Iterator_> const &source_range, DestIterator_ dest) const {
-        // TODO: Could add another case where the range represents a contiguous sequence of values
-        // that could be byte-copied and then endian-corrected.
-        if constexpr (std::is_same_v<Iterator_,std::byte const *>) {
-            // If the range is over bytes, a direct copy of bytes works, no per-element byte-swapping necessary.
-            std::copy(source_range.begin(), source_range.begin()+source_range.size(), dest);
+        if constexpr (is_contiguous_basic_serializable_iterator_v<Iterator_>) {
+            using ValueType = std::remove_cv_t<std::remove_pointer_t<Iterator_>>;
+            auto count = size_t(source_range.size());
+            if (sizeof(ValueType) == 1 || machine_endianness() == Endianness::LIL) {
+                // The in-memory representation is already the serialized representation, so copy it as one block.
+                auto source_bytes = reinterpret_cast<std::byte const *>(source_range.begin());
+                reference_bytes(source_bytes, source_bytes+count*sizeof(ValueType), dest);
+            } else {
+                // The source can't be swapped in-place, so swap a chunk at a time in a local buffer.
+                size_t constexpr CHUNK_SIZE = std::max(size_t(1), 0x1000 / sizeof(ValueType));
+                std::array<ValueType,CHUNK_SIZE> chunk;
+                for (size_t i = 0; i < count; i += CHUNK_SIZE) {
+                    auto chunk_count = std::min(CHUNK_SIZE, count - i);
+                    std::copy(source_range.begin()+i, source_range.begin()+i+chunk_count, chunk.data());
+                    swap_byte_order_of_each_leaf(chunk.data(), chunk_count);
+                    auto chunk_bytes = reinterpret_cast<std::byte const *>(chunk.data());
+                    dest = copy_bytes(chunk_bytes, chunk_bytes+chunk_count*sizeof(ValueType), dest);
+                }
+            }
         } else {
             for (auto const &source : source_range)
                 serialize_from(source, dest);
@@ -148,16 +394,30 @@ template <typename Iterator_>
 struct DeserializeTo_Range_t {
     template <typename Range_, typename = std::enable_if_t<is_Range_t<Range_>>>
     void operator() (lvd::Range_t<Iterator_> &dest_range, Range_ &&source_range) const {
-        // TODO: Could add another case where the range represents a contiguous sequence of values
-        // that could be byte-copied and then endian-corrected.
-        if constexpr (std::is_same_v<Iterator_,std::byte const *>) {
-            // If the range is over bytes, a direct copy of bytes works, no per-element byte-swapping necessary.
-            auto size = dest_range.size();
-            std::copy(source_range.begin(), source_range.begin()+size, dest_range.begin());
-            source_range.begin() += size;
+        if constexpr (is_contiguous_basic_serializable_iterator_v<Iterator_>) {
+            using ValueType = std::remove_cv_t<std::remove_pointer_t<Iterator_>>;
+            auto count = size_t(dest_range.size());
+            auto byte_count = count*sizeof(ValueType);
+            if constexpr (is_GatheredRange_t<Range_>) {
+                // If this block was referenced when it was gathered, then it was read in place, and is already
+                // in the (LIL-endian) machine representation, since only those blocks are referenced.
+                if (source_range.take_reference(reinterpret_cast<std::byte const *>(dest_range.begin()), byte_count))
+                    return;
+            }
+            require_source_size(source_range, byte_count);
+
+            // Copy the bytes as one block, then byte-swap the whole range in-place, if called for.
+            std::copy(source_range.begin(), source_range.begin()+byte_count, reinterpret_cast<std::byte *>(dest_range.begin()));
+            if (sizeof(ValueType) > 1 && machine_endianness() != Endianness::LIL)
+                swap_byte_order_of_each_leaf(dest_range.begin(), count);
+            // Advance source_range.begin() so it's ready to continue reading from the next spot.
+            source_range.begin() += byte_count;
         } else {
-            for (auto &dest : dest_range)
-                deserialize_to(dest, std::forward<Range_>(source_range));
+            using ValueType = std::remove_cv_t<std::remove_reference_t<decltype(*dest_range.begin())>>;
+            deserialize_validated<ValueType>(source_range, size_t(dest_range.size()), [&dest_range](auto &range){
+                for (auto &dest : dest_range)
+                    deserialize_to(dest, std::move(range));
+            });
         }
     }
 };
@@ -179,6 +439,36 @@ void deserialize_to_range (lvd::Range_t<Iterator_> dest, Range_ &&source_range)
     DeserializeTo_Range_t<Iterator_>()(dest, std::forward<Range_>(source_range));
 }
 
+// Is true iff Container_ stores its elements contiguously and exposes them through data(), e.g. std::vector,
+// std::basic_string, and std::array, but not std::vector<bool>.
+template <typename Container_, typename = void>
+struct is_contiguous_container : public std::false_type { };
+template <typename Container_>
+struct is_contiguous_container<Container_,std::void_t<decltype(std::declval<Container_ &>().data())>>
+    : public std::is_same<decltype(std::declval<Container_ &>().data()),typename Container_::value_type *> { };
+template <typename Container_>
+inline bool constexpr is_contiguous_container_v = is_contiguous_container<Container_>::value;
+
+// Returns a Range_t over the elements of container, using a pointer Range_t if the container is contiguous,
+// so that SerializeFrom_Range_t and DeserializeTo_Range_t can use their block-copy path.
+template <typename Container_>
+auto serialization_range_of (Container_ const &container) {
+    if constexpr (is_contiguous_container_v<Container_>)
+        return lvd::range(container.data(), container.data()+container.size());
+    else
+        return lvd::range(container);
+}
+
+// Returns a Range_t over the elements of container, using a pointer Range_t if the container is contiguous,
+// so that SerializeFrom_Range_t and DeserializeTo_Range_t can use their block-copy path.
+template <typename Container_>
+auto serialization_range_of (Container_ &container) {
+    if constexpr (is_contiguous_container_v<Container_>)
+        return lvd::range(container.data(), container.data()+container.size());
+    else
+        return lvd::range(container);
+}
+
 //
 // Implementation helper for any seqentual container type that has begin(), end(), and a dynamic size.
 //
@@ -189,8 +479,7 @@ struct SerializeFrom_SequenceContainer_DynamicSize_t {
     void operator() (Container_ const &source, DestIterator_ dest) const {
         LVD_G_REQ_LT(source.size(), 0x100000000ull, "source container is too big; this serialize function uses uint32_t for container size");
         serialize_from<uint32_t>(source.size(), dest);
-//         serialize_from(lvd::range(source), dest);
-        serialize_from_range(lvd::range(source), dest);
+        serialize_from_range(serialization_range_of(source), dest);
     }
 };
 
@@ -199,20 +488,52 @@ struct DeserializeTo_SequenceContainer_DynamicSize_t {
     template <typename Range_, typename = std::enable_if_t<is_Range_t<Range_>>>
     void operator() (Container_ &dest, Range_ &&source_range) const {
         using ValueType = typename Container_::value_type;
-        if constexpr (is_basic_serializable_v<ValueType>) {
-            dest.resize(deserialized_to<uint32_t>(std::forward<Range_>(source_range)));
-            deserialize_to_range(lvd::range(dest), std::forward<Range_>(source_range));
+        size_t size = deserialized_to<uint32_t>(std::forward<Range_>(source_range));
+        charge_decode_budget<ValueType>(size);
+        DecodeNestingLevel nesting_level;
+        if constexpr (is_fixed_layout_serializable_v<ValueType>) {
+            // Check the size before resizing, so that a corrupt size can't cause a huge allocation.
+            require_source_block_size(source_range, size*sizeof(ValueType));
+            dest.resize(size);
+            deserialize_to_range(serialization_range_of(dest), std::forward<Range_>(source_range));
         } else {
+            if constexpr (is_GatheredRange_t<Range_>) {
+                // Deserialize into the existing elements, so that their blocks which were read in place stay put.
+                if (dest.size() == size) {
+                    for (auto &element : dest)
+                        deserialize_to(element, std::forward<Range_>(source_range));
+                    return;
+                }
+            }
             dest.clear();
-            size_t size = deserialized_to<uint32_t>(std::forward<Range_>(source_range));
-            dest.reserve(size);
-            for (size_t i = 0; i < size; ++i)
-                dest.push_back(deserialized_to<ValueType>(std::forward<Range_>(source_range)));
+            deserialize_validated<ValueType>(source_range, size, [&dest, size](auto &range){
+                // Each element takes at least 1 byte, so don't reserve more than that many.
+                dest.reserve(unverified_reserve_count<ValueType>(size, size_t(range.size())));
+                for (size_t i = 0; i < size; ++i)
+                    dest.push_back(deserialized_to<ValueType>(std::move(range)));
+            });
             assert(dest.size() == size);
         }
     }
 };
 
+// Implementation helper for any container type whose serialized form is its uint32_t size followed by its elements.
+template <typename Container_>
+struct SerializedSize_Container_t : public SerializedSize_VariableSize_t {
+    template <typename Element_ = remove_cv_recursive_t<typename Container_::value_type>, typename = std::enable_if_t<has_serialized_size_v<Element_>>>
+    size_t operator() (Container_ const &source) const {
+        if constexpr (SerializedSize_t<Element_>::IS_FIXED) {
+            // No need to iterate.
+            return sizeof(uint32_t) + source.size()*SerializedSize_t<Element_>::FIXED_SIZE;
+        } else {
+            size_t retval = sizeof(uint32_t);
+            for (auto const &element : source)
+                retval += serialized_size_of(element);
+            return retval;
+        }
+    }
+};
+
 //
 // Definitions for specific sequential container types.
 // -    std::basic_string
@@ -225,11 +546,60 @@ template <typename... Types_>
 struct SerializeFrom_t<std::basic_string<Types_...>> : SerializeFrom_SequenceContainer_DynamicSize_t<std::basic_string<Types_...>> { };
 template <typename... Types_>
 struct DeserializeTo_t<std::basic_string<Types_...>> : DeserializeTo_SequenceContainer_DynamicSize_t<std::basic_string<Types_...>> { };
+template <typename... Types_>
+struct SerializedSize_t<std::basic_string<Types_...>> : SerializedSize_Container_t<std::basic_string<Types_...>> { };
 
 template <typename... Types_>
 struct SerializeFrom_t<std::vector<Types_...>> : SerializeFrom_SequenceContainer_DynamicSize_t<std::vector<Types_...>> { };
 template <typename... Types_>
 struct DeserializeTo_t<std::vector<Types_...>> : DeserializeTo_SequenceContainer_DynamicSize_t<std::vector<Types_...>> { };
+template <typename... Types_>
+struct SerializedSize_t<std::vector<Types_...>> : SerializedSize_Container_t<std::vector<Types_...>> { };
+
+//
+// std::vector<bool> is bit-packed, i.e. its uint32_t size is followed by a bitmap (see lvd/bitpack.hpp) having
+// one bit per element instead of one byte.
+//
+
+template <typename Allocator_>
+struct SerializeFrom_t<std::vector<bool,Allocator_>> {
+    template <typename DestIterator_>
+    void operator() (std::vector<bool,Allocator_> const &source, DestIterator_ dest) const {
+        LVD_G_REQ_LT(source.size(), 0x100000000ull, "source container is too big; this serialize function uses uint32_t for container size");
+        serialize_from<uint32_t>(source.size(), dest);
+        for (size_t i = 0; i < source.size(); i += 8) {
+            uint8_t byte = 0;
+            for (size_t j = 0; j < 8 && i+j < source.size(); ++j)
+                byte |= uint8_t(uint8_t(source[i+j]) << j);
+            serialize_from(byte, dest);
+        }
+    }
+};
+
+template <typename Allocator_>
+struct DeserializeTo_t<std::vector<bool,Allocator_>> {
+    template <typename Range_, typename = std::enable_if_t<is_Range_t<Range_>>>
+    void operator() (std::vector<bool,Allocator_> &dest, Range_ &&source_range) const {
+        size_t size = deserialized_to<uint32_t>(std::forward<Range_>(source_range));
+        charge_decode_budget<bool>(size);
+        DecodeNestingLevel nesting_level;
+        // Check the size before resizing, so that a corrupt size can't cause a huge allocation.
+        require_source_size(source_range, bitmap_size_of(size));
+        dest.resize(size);
+        for (size_t i = 0; i < size; i += 8) {
+            auto byte = deserialized_to<uint8_t>(std::forward<Range_>(source_range));
+            for (size_t j = 0; j < 8 && i+j < size; ++j)
+                dest[i+j] = (byte >> j) & 1;
+        }
+    }
+};
+
+template <typename Allocator_>
+struct SerializedSize_t<std::vector<bool,Allocator_>> : public SerializedSize_VariableSize_t {
+    size_t operator() (std::vector<bool,Allocator_> const &source) const {
+        return sizeof(uint32_t) + bitmap_size_of(source.size());
+    }
+};
 
 //
 // std::array<T,N>
@@ -239,7 +609,7 @@ template <typename T_, size_t N_>
 struct SerializeFrom_t<std::array<T_,N_>> {
     template <typename DestIterator_>
     void operator() (std::array<T_,N_> const &source, DestIterator_ dest) const {
-        serialize_from_range(lvd::range(source), dest);
+        serialize_from_range(serialization_range_of(source), dest);
     }
 };
 
@@ -247,7 +617,25 @@ template <typename T_, size_t N_>
 struct DeserializeTo_t<std::array<T_,N_>> {
     template <typename Range_, typename = std::enable_if_t<is_Range_t<Range_>>>
     void operator() (std::array<T_,N_> &dest, Range_ &&source_range) const {
-        deserialize_to_range(lvd::range(dest), std::forward<Range_>(source_range));
+        deserialize_to_range(serialization_range_of(dest), std::forward<Range_>(source_range));
+    }
+};
+
+template <typename T_, size_t N_>
+struct SerializedSize_t<std::array<T_,N_>> {
+    static bool constexpr IS_FIXED = SerializedSize_t<T_>::IS_FIXED;
+    static size_t constexpr FIXED_SIZE = N_*SerializedSize_t<T_>::FIXED_SIZE;
+
+    template <typename Element_ = T_, typename = std::enable_if_t<has_serialized_size_v<Element_>>>
+    size_t operator() (std::array<T_,N_> const &source) const {
+        if constexpr (IS_FIXED) {
+            return FIXED_SIZE;
+        } else {
+            size_t retval = 0;
+            for (auto const &element : source)
+                retval += serialized_size_of(element);
+            return retval;
+        }
     }
 };
 
@@ -261,8 +649,13 @@ template <typename F_, typename S_>
 struct SerializeFrom_t<std::pair<F_,S_>> {
     template <typename DestIterator_>
     void operator() (std::pair<F_,S_> const &source, DestIterator_ dest) const {
-        serialize_from(source.first, dest);
-        serialize_from(source.second, dest);
+        if constexpr (is_fixed_layout_serializable_v<std::pair<F_,S_>>) {
+            // Copy the whole pair as one block.
+            serialize_from_range(lvd::range(&source, &source+1), dest);
+        } else {
+            serialize_from(source.first, dest);
+            serialize_from(source.second, dest);
+        }
     }
 };
 
@@ -270,8 +663,16 @@ template <typename F_, typename S_>
 struct DeserializeTo_t<std::pair<F_,S_>> {
     template <typename Range_, typename = std::enable_if_t<is_Range_t<Range_>>>
     void operator() (std::pair<F_,S_> &dest, Range_ &&source_range) const {
-        deserialize_to(dest.first, std::forward<Range_>(source_range));
-        deserialize_to(dest.second, std::forward<Range_>(source_range));
+        if constexpr (is_fixed_layout_serializable_v<std::pair<F_,S_>>) {
+            // Copy the whole pair as one block.
+            deserialize_to_range(lvd::range(&dest, &dest+1), std::forward<Range_>(source_range));
+        } else {
+            // If the pair has a fixed serialized size, this checks the size of source_range once for both elements.
+            deserialize_validated<std::pair<F_,S_>>(source_range, 1, [&dest](auto &range){
+                deserialize_to(dest.first, std::move(range));
+                deserialize_to(dest.second, std::move(range));
+            });
+        }
     }
 };
 
@@ -293,6 +694,24 @@ struct DeserializedTo_t<std::pair<F_,S_>> {
     }
 };
 
+// F_ and S_ may be const, e.g. for std::map<K,V>::value_type, which is std::pair<K const,V>.
+template <typename F_, typename S_>
+struct SerializedSize_t<std::pair<F_,S_>> {
+    using First = std::remove_cv_t<F_>;
+    using Second = std::remove_cv_t<S_>;
+
+    static bool constexpr IS_FIXED = SerializedSize_t<First>::IS_FIXED && SerializedSize_t<Second>::IS_FIXED;
+    static size_t constexpr FIXED_SIZE = IS_FIXED ? SerializedSize_t<First>::FIXED_SIZE + SerializedSize_t<Second>::FIXED_SIZE : 0;
+
+    template <typename First_ = First, typename Second_ = Second, typename = std::enable_if_t<has_serialized_size_v<First_> && has_serialized_size_v<Second_>>>
+    size_t operator() (std::pair<F_,S_> const &source) const {
+        if constexpr (IS_FIXED)
+            return FIXED_SIZE;
+        else
+            return SerializedSize_t<First>()(source.first) + SerializedSize_t<Second>()(source.second);
+    }
+};
+
 //
 // Implementation helper for any associative container type.
 //
@@ -315,9 +734,15 @@ struct DeserializeTo_AssociativeContainer_t {
         // remove_cv_recursive is needed because for std::map and std::unordered_map, value_type is std::pair<Key_ const, T_>.
         using ValueType = remove_cv_recursive_t<typename Container_::value_type>;
         size_t size = deserialized_to<uint32_t>(std::forward<Range_>(source_range));
+        charge_decode_budget<ValueType>(size);
+        DecodeNestingLevel nesting_level;
         dest.clear();
-        for (size_t i = 0; i < size; ++i)
-            dest.emplace(deserialized_to<ValueType>(std::forward<Range_>(source_range)));
+        deserialize_validated<ValueType>(source_range, size, [&dest, size](auto &range){
+            // Each element takes at least 1 byte, so don't reserve more than that many.
+            reserve_associative_container(dest, unverified_reserve_count<ValueType>(size, size_t(range.size())));
+            for (size_t i = 0; i < size; ++i)
+                emplace_in_serialized_order(dest, deserialized_to<ValueType>(std::move(range)));
+        });
     }
 };
 
@@ -334,21 +759,29 @@ template <typename... Types_>
 struct SerializeFrom_t<std::map<Types_...>> : public SerializeFrom_AssociativeContainer_t<std::map<Types_...>> { };
 template <typename... Types_>
 struct DeserializeTo_t<std::map<Types_...>> : public DeserializeTo_AssociativeContainer_t<std::map<Types_...>> { };
+template <typename... Types_>
+struct SerializedSize_t<std::map<Types_...>> : public SerializedSize_Container_t<std::map<Types_...>> { };
 
 template <typename... Types_>
 struct SerializeFrom_t<std::set<Types_...>> : public SerializeFrom_AssociativeContainer_t<std::set<Types_...>> { };
 template <typename... Types_>
 struct DeserializeTo_t<std::set<Types_...>> : public DeserializeTo_AssociativeContainer_t<std::set<Types_...>> { };
+template <typename... Types_>
+struct SerializedSize_t<std::set<Types_...>> : public SerializedSize_Container_t<std::set<Types_...>> { };
 
 template <typename... Types_>
 struct SerializeFrom_t<std::unordered_map<Types_...>> : public SerializeFrom_AssociativeContainer_t<std::unordered_map<Types_...>> { };
 template <typename... Types_>
 struct DeserializeTo_t<std::unordered_map<Types_...>> : public DeserializeTo_AssociativeContainer_t<std::unordered_map<Types_...>> { };
+template <typename... Types_>
+struct SerializedSize_t<std::unordered_map<Types_...>> : public SerializedSize_Container_t<std::unordered_map<Types_...>> { };
 
 template <typename... Types_>
 struct SerializeFrom_t<std::unordered_set<Types_...>> : public SerializeFrom_AssociativeContainer_t<std::unordered_set<Types_...>> { };
 template <typename... Types_>
 struct DeserializeTo_t<std::unordered_set<Types_...>> : public DeserializeTo_AssociativeContainer_t<std::unordered_set<Types_...>> { };
+template <typename... Types_>
+struct SerializedSize_t<std::unordered_set<Types_...>> : public SerializedSize_Container_t<std::unordered_set<Types_...>> { };
 
 //
 // std::optional<T_>
@@ -376,4 +809,12 @@ struct DeserializeTo_t<std::optional<T_>> {
     }
 };
 
+template <typename T_>
+struct SerializedSize_t<std::optional<T_>> : public SerializedSize_VariableSize_t {
+    template <typename Element_ = T_, typename = std::enable_if_t<has_serialized_size_v<Element_>>>
+    size_t operator() (std::optional<T_> const &source) const {
+        return serialized_size_of(source.has_value()) + (source.has_value() ? serialized_size_of(source.value()) : 0);
+    }
+};
+
 } // end namespace lvd
@@ -0,0 +1,278 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "lvd/associative_container.hpp"
+#include "lvd/DecodeBudget.hpp"
+#include "lvd/parallel.hpp"
+#include "lvd/Range_t.hpp"
+#include "lvd/remove_cv_recursive.hpp"
+#include "lvd/serialization.hpp"
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace lvd {
+
+//
+// Parallel chunked serialization of very large containers.  The elements are split into chunks of chunk_size
+// elements, each chunk is serialized on a worker thread, and the chunks are stitched together behind a table of
+// their offsets, so that they can also be deserialized on worker threads.  The serialized form is
+//
+//     uint64_t size                   // number of elements
+//     uint64_t chunk_size             // number of elements in each chunk but the last
+//     uint64_t chunk_end[chunk_count] // end offset of each chunk, relative to the start of the first chunk
+//     ...                             // the elements, serialized as by serialize_from, back to back
+//
+// where chunk_count is size/chunk_size rounded up.  This is a different format than that of serialize_from for the
+// container, so it must be read by deserialize_to_parallel.  Supported containers are those whose elements are
+// contiguous (e.g. std::vector and std::basic_string, but not std::vector<bool>), and associative containers
+// (e.g. std::map and std::unordered_map).  The elements of an associative container are deserialized in parallel,
+// but are necessarily inserted into it on the calling thread.
+//
+
+inline size_t constexpr DEFAULT_PARALLEL_CHUNK_SIZE = 0x10000;
+
+struct ParallelSerializationOptions {
+    // Number of elements per chunk (only used when serializing).
+    size_t chunk_size = DEFAULT_PARALLEL_CHUNK_SIZE;
+    // Max number of threads to use, including the calling thread, where 0 means default_thread_count().
+    size_t thread_count = 0;
+};
+
+template <typename Container_>
+inline bool constexpr is_parallel_serializable_container_v =
+    is_contiguous_container_v<Container_> ||
+    is_associative_container_v<Container_>;
+
+// The elements of a container, split into chunks.  chunk(i) is a Range_t over the elements of the ith chunk.
+template <typename Container_>
+class ParallelChunks_t {
+public:
+
+    using Iterator = Range_t_iterator_t<decltype(serialization_range_of(std::declval<Container_ const &>()))>;
+
+    ParallelChunks_t (Container_ const &source, size_t chunk_size) {
+        LVD_G_REQ_GT(chunk_size, size_t(0), "chunk_size must be positive");
+        auto elements = serialization_range_of(source);
+        // For a non-random-access container, this is the only pass over the elements that isn't parallel.
+        m_chunk_begins.reserve(source.size() / chunk_size + 2);
+        auto it = elements.begin();
+        for (size_t remaining = source.size(); remaining > 0; ) {
+            auto count = std::min(remaining, chunk_size);
+            m_chunk_begins.push_back(it);
+            it = std::next(it, count);
+            remaining -= count;
+        }
+        m_chunk_begins.push_back(elements.end());
+    }
+
+    size_t chunk_count () const { return m_chunk_begins.size() - 1; }
+    Range_t<Iterator> chunk (size_t i) const { return Range_t<Iterator>(m_chunk_begins[i], m_chunk_begins[i+1]); }
+
+private:
+
+    std::vector<Iterator> m_chunk_begins;
+};
+
+// Returns the number of bytes that serialize_from_range(elements, ...) produces.
+template <typename Iterator_>
+size_t serialized_size_of_range (Range_t<Iterator_> const &elements) {
+    using ValueType = remove_cv_recursive_t<typename std::iterator_traits<Iterator_>::value_type>;
+    if constexpr (SerializedSize_t<ValueType>::IS_FIXED) {
+        return size_t(elements.size())*SerializedSize_t<ValueType>::FIXED_SIZE;
+    } else {
+        size_t retval = 0;
+        for (auto const &element : elements)
+            retval += serialized_size_of(element);
+        return retval;
+    }
+}
+
+// Serializes each chunk into its own buffer, in parallel.
+template <typename Container_>
+std::vector<std::vector<std::byte>> serialized_chunks_of (ParallelChunks_t<Container_> const &chunks, size_t thread_count) {
+    using ValueType = remove_cv_recursive_t<typename Container_::value_type>;
+    std::vector<std::vector<std::byte>> retval(chunks.chunk_count());
+    run_in_parallel(chunks.chunk_count(), thread_count, [&chunks, &retval](size_t i){
+        auto elements = chunks.chunk(i);
+        auto &buffer = retval[i];
+        if constexpr (has_serialized_size_v<ValueType>) {
+            buffer.resize(serialized_size_of_range(elements));
+            std::byte *cursor = buffer.data();
+            serialize_from_range(elements, ByteInserter_t(cursor, buffer.data() + buffer.size()));
+            LVD_G_REQ_EQ(size_t(cursor - buffer.data()), buffer.size(), "SerializedSize_t disagrees with SerializeFrom_t");
+        } else {
+            serialize_from_range(elements, std::back_inserter(buffer));
+        }
+    });
+    return retval;
+}
+
+// Serializes the header, i.e. everything before the first chunk, given the size of each chunk.
+template <typename DestIterator_>
+void serialize_parallel_header (size_t size, size_t chunk_size, std::vector<size_t> const &chunk_byte_counts, DestIterator_ dest) {
+    serialize_from<uint64_t>(size, dest);
+    serialize_from<uint64_t>(chunk_size, dest);
+    uint64_t chunk_end = 0;
+    for (auto chunk_byte_count : chunk_byte_counts) {
+        chunk_end += chunk_byte_count;
+        serialize_from(chunk_end, dest);
+    }
+}
+
+// Serializes source into dest in the parallel chunked form.  The chunks are serialized in parallel into their own
+// buffers, then copied into dest on the calling thread.
+template <typename Container_, typename DestIterator_>
+void serialize_from_parallel (Container_ const &source, DestIterator_ dest, ParallelSerializationOptions const &options = ParallelSerializationOptions{}) {
+    static_assert(is_parallel_serializable_container_v<Container_>, "Container_ must be contiguous or associative");
+    ParallelChunks_t<Container_> chunks(source, options.chunk_size);
+    auto chunk_buffers = serialized_chunks_of(chunks, options.thread_count);
+    std::vector<size_t> chunk_byte_counts;
+    chunk_byte_counts.reserve(chunk_buffers.size());
+    for (auto const &chunk_buffer : chunk_buffers)
+        chunk_byte_counts.push_back(chunk_buffer.size());
+    serialize_parallel_header(source.size(), options.chunk_size, chunk_byte_counts, dest);
+    for (auto const &chunk_buffer : chunk_buffers)
+        dest = copy_bytes(chunk_buffer.data(), chunk_buffer.data()+chunk_buffer.size(), dest);
+}
+
+// Convenience function to get the parallel chunked form of source as a std::vector<std::byte>.  If SerializedSize_t
+// is implemented for the elements, then the sizes of the chunks are computed in parallel, and then each chunk is
+// serialized in parallel directly into its place in the returned vector.  Otherwise the chunks are serialized in
+// parallel into their own buffers, which are then copied in parallel into the returned vector.
+template <typename Container_>
+std::vector<std::byte> serialized_from_parallel (Container_ const &source, ParallelSerializationOptions const &options = ParallelSerializationOptions{}) {
+    static_assert(is_parallel_serializable_container_v<Container_>, "Container_ must be contiguous or associative");
+    using ValueType = remove_cv_recursive_t<typename Container_::value_type>;
+    ParallelChunks_t<Container_> chunks(source, options.chunk_size);
+    auto header_size = 2*sizeof(uint64_t) + chunks.chunk_count()*sizeof(uint64_t);
+
+    std::vector<std::vector<std::byte>> chunk_buffers;
+    std::vector<size_t> chunk_byte_counts(chunks.chunk_count());
+    if constexpr (has_serialized_size_v<ValueType>) {
+        run_in_parallel(chunks.chunk_count(), options.thread_count, [&chunks, &chunk_byte_counts](size_t i){
+            chunk_byte_counts[i] = serialized_size_of_range(chunks.chunk(i));
+        });
+    } else {
+        chunk_buffers = serialized_chunks_of(chunks, options.thread_count);
+        for (size_t i = 0; i < chunk_buffers.size(); ++i)
+            chunk_byte_counts[i] = chunk_buffers[i].size();
+    }
+
+    std::vector<size_t> chunk_offsets(chunks.chunk_count());
+    size_t total_size = header_size;
+    for (size_t i = 0; i < chunks.chunk_count(); ++i) {
+        chunk_offsets[i] = total_size;
+        total_size += chunk_byte_counts[i];
+    }
+
+    std::vector<std::byte> retval(total_size);
+    std::byte *cursor = retval.data();
+    serialize_parallel_header(source.size(), options.chunk_size, chunk_byte_counts, ByteInserter_t(cursor));
+    assert(cursor == retval.data() + header_size);
+    run_in_parallel(chunks.chunk_count(), options.thread_count, [&](size_t i){
+        std::byte *chunk_cursor = retval.data() + chunk_offsets[i];
+        if constexpr (has_serialized_size_v<ValueType>) {
+            // The inserter is bounded by the end of this chunk, so a SerializedSize_t that undercounts can't
+            // overwrite the next chunk (which another thread may be writing); the failure is rethrown by
+            // run_in_parallel.
+            std::byte *chunk_end = retval.data() + chunk_offsets[i] + chunk_byte_counts[i];
+            serialize_from_range(chunks.chunk(i), ByteInserter_t(chunk_cursor, chunk_end));
+            LVD_G_REQ_EQ(size_t(chunk_cursor - retval.data()), size_t(chunk_end - retval.data()), "SerializedSize_t disagrees with SerializeFrom_t");
+        } else {
+            std::memcpy(chunk_cursor, chunk_buffers[i].data(), chunk_buffers[i].size());
+            // Free each buffer as soon as it's copied, so that there's at most about one extra copy of the serialized bytes.
+            chunk_buffers[i] = std::vector<std::byte>();
+        }
+    });
+    return retval;
+}
+
+// Deserializes the parallel chunked form from source_range, which must be over a contiguous byte buffer, into dest.
+// source_range is advanced past what was read.  The chunks are deserialized in parallel, except that if there's a
+// current DecodeBudget (which is per thread), then they're all deserialized on the calling thread, so that the
+// budget is enforced on everything.  Throws (or whatever g_req_context does) if the chunk table is inconsistent
+// with size and chunk_size, or if any chunk isn't exactly the serialized form of its elements.
+template <typename Container_, typename Range_, typename = std::enable_if_t<is_Range_t<Range_>>>
+void deserialize_to_parallel (Container_ &dest, Range_ &&source_range, size_t thread_count = 0) {
+    static_assert(is_parallel_serializable_container_v<Container_>, "Container_ must be contiguous or associative");
+    static_assert(is_contiguous_byte_iterator_v<Range_t_iterator_t<std::decay_t<Range_>>>, "source_range must be over a contiguous byte buffer");
+    using ValueType = remove_cv_recursive_t<typename Container_::value_type>;
+
+    size_t size = deserialized_to<uint64_t>(std::forward<Range_>(source_range));
+    size_t chunk_size = deserialized_to<uint64_t>(std::forward<Range_>(source_range));
+    if (size > 0)
+        LVD_G_REQ_GT(chunk_size, size_t(0), "chunk_size must be positive");
+    size_t chunk_count = size == 0 ? 0 : size / chunk_size + (size % chunk_size != 0);
+    LVD_G_REQ_LEQ(chunk_count, size_t(source_range.size()) / sizeof(uint64_t), "source_range.size() is not large enough to read the chunk table");
+    std::vector<size_t> chunk_ends(chunk_count);
+    size_t payload_size = 0;
+    for (auto &chunk_end : chunk_ends) {
+        chunk_end = deserialized_to<uint64_t>(std::forward<Range_>(source_range));
+        // The chunk ends must be nondecreasing, so that it's enough to check the last one against the source size.
+        LVD_G_REQ_LEQ(payload_size, chunk_end, "chunk table is corrupt");
+        payload_size = chunk_end;
+    }
+    require_source_size(source_range, payload_size);
+    // Check the size before allocating, so that a corrupt size can't cause a huge allocation.
+    if constexpr (SerializedSize_t<ValueType>::IS_FIXED) {
+        if constexpr (SerializedSize_t<ValueType>::FIXED_SIZE > 0)
+            LVD_G_REQ_EQ(size, payload_size / SerializedSize_t<ValueType>::FIXED_SIZE, "chunk table is inconsistent with size");
+    } else {
+        // Each element takes at least 1 byte.
+        LVD_G_REQ_LEQ(size, payload_size, "chunk table is inconsistent with size");
+    }
+    charge_decode_budget<ValueType>(size);
+    DecodeNestingLevel nesting_level;
+
+    // Calling &* on an empty range would be undefined, and no chunk has any bytes in that case anyway.
+    std::byte const *payload = payload_size == 0 ? nullptr : &*source_range.begin();
+    auto chunk_source_range = [payload, &chunk_ends](size_t i){
+        return Range_t<std::byte const *>(payload + (i == 0 ? 0 : chunk_ends[i-1]), payload + chunk_ends[i]);
+    };
+    auto chunk_element_count = [size, chunk_size](size_t i){
+        return std::min(chunk_size, size - i*chunk_size);
+    };
+    auto require_chunk_exhausted = [](Range_t<std::byte const *> const &chunk_range){
+        LVD_G_REQ_IS_TRUE(chunk_range.empty(), "chunk has bytes left over after deserializing its elements");
+    };
+    if (DecodeBudget::current() != nullptr)
+        thread_count = 1;
+
+    if constexpr (is_contiguous_container_v<Container_>) {
+        dest.resize(size);
+        run_in_parallel(chunk_count, thread_count, [&](size_t i){
+            auto chunk_range = chunk_source_range(i);
+            auto elements = dest.data() + i*chunk_size;
+            deserialize_to_range(lvd::range(elements, elements+chunk_element_count(i)), std::move(chunk_range));
+            require_chunk_exhausted(chunk_range);
+        });
+    } else {
+        std::vector<std::vector<ValueType>> chunk_elements(chunk_count);
+        run_in_parallel(chunk_count, thread_count, [&](size_t i){
+            auto chunk_range = chunk_source_range(i);
+            auto count = chunk_element_count(i);
+            auto &elements = chunk_elements[i];
+            elements.reserve(count);
+            for (size_t j = 0; j < count; ++j)
+                elements.push_back(deserialized_to<ValueType>(std::move(chunk_range)));
+            require_chunk_exhausted(chunk_range);
+        });
+        dest.clear();
+        reserve_associative_container(dest, size);
+        for (auto &elements : chunk_elements) {
+            for (auto &element : elements)
+                emplace_in_serialized_order(dest, std::move(element));
+            elements = std::vector<ValueType>();
+        }
+    }
+    source_range.begin() += payload_size;
+}
+
+} // end namespace lvd
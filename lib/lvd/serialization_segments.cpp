@@ -0,0 +1,85 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include "lvd/serialization_segments.hpp"
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+namespace lvd {
+
+namespace {
+
+#ifdef IOV_MAX
+size_t constexpr MAX_IOVEC_COUNT = IOV_MAX;
+#else
+size_t constexpr MAX_IOVEC_COUNT = 1024;
+#endif
+
+// Calls transfer(segments, count, transferred_so_far) until all the segments have been transferred, advancing past
+// whatever each call transfers.  transfer returns what readv/writev etc return.
+template <typename Transfer_>
+void transfer_segments (std::vector<iovec> &segments, char const *what, Transfer_ const &transfer) {
+    auto it = segments.data();
+    auto end = segments.data() + segments.size();
+    size_t transferred = 0;
+    while (true) {
+        // Skip empty segments, so that a 0 return value unambiguously means the end of the file.
+        while (it != end && it->iov_len == 0)
+            ++it;
+        if (it == end)
+            break;
+
+        auto result = transfer(it, int(std::min(size_t(end - it), MAX_IOVEC_COUNT)), transferred);
+        if (result < 0) {
+            if (errno == EINTR)
+                continue;
+            throw std::runtime_error(std::string(what) + " failed: " + std::strerror(errno));
+        }
+        if (result == 0)
+            throw std::runtime_error(std::string(what) + " reached the end of the file after " + std::to_string(transferred) + " bytes");
+
+        transferred += size_t(result);
+        for (auto remaining = size_t(result); remaining > 0; ) {
+            if (remaining >= it->iov_len) {
+                remaining -= it->iov_len;
+                ++it;
+            } else {
+                it->iov_base = static_cast<std::byte *>(it->iov_base) + remaining;
+                it->iov_len -= remaining;
+                remaining = 0;
+            }
+        }
+    }
+}
+
+} // end of anonymous namespace
+
+void write_segments (int fd, std::vector<iovec> segments) {
+    transfer_segments(segments, "writev", [fd](iovec const *iov, int count, size_t){
+        return ::writev(fd, iov, count);
+    });
+}
+
+void pwrite_segments (int fd, std::vector<iovec> segments, off_t offset) {
+    transfer_segments(segments, "pwritev", [fd, offset](iovec const *iov, int count, size_t transferred){
+        return ::pwritev(fd, iov, count, offset + off_t(transferred));
+    });
+}
+
+void read_segments (int fd, std::vector<iovec> segments) {
+    transfer_segments(segments, "readv", [fd](iovec const *iov, int count, size_t){
+        return ::readv(fd, iov, count);
+    });
+}
+
+void pread_segments (int fd, std::vector<iovec> segments, off_t offset) {
+    transfer_segments(segments, "preadv", [fd, offset](iovec const *iov, int count, size_t transferred){
+        return ::preadv(fd, iov, count, offset + off_t(transferred));
+    });
+}
+
+} // end namespace lvd
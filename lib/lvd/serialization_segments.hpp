@@ -0,0 +1,240 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include "lvd/Range_t.hpp"
+#include "lvd/serialization.hpp"
+#include <stdexcept>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <vector>
+
+namespace lvd {
+
+//
+// Scatter-gather serialization.  Instead of copying the whole serialized form of a value into one buffer (as
+// serialized_from does), serialized_segments_from produces a list of segments which can be passed straight to
+// writev or pwritev (see write_segments).  The small parts (e.g. sizes and scalars) are copied into an owned
+// arena, while blocks of at least reference_threshold bytes which already have their serialized representation
+// in memory (i.e. contiguous containers, e.g. std::vector and std::basic_string, of basic-serializable values, on
+// a little-endian machine) are referred to in place.  The concatenation of the segments is exactly the output of
+// serialized_from.
+//
+// The matching gather-read is for a destination which already has the shape (i.e. container sizes) of the value
+// that was serialized, e.g. because the sizes were sent ahead in a header.  gather_segments_for(dest) produces
+// segments whose referenced blocks are dest's own memory, so that read_segments reads those blocks directly into
+// dest, and deserialize_gathered then decodes the small parts from the arena.  For example
+//
+//     auto segments = serialized_segments_from(source);
+//     write_segments(fd, segments.iovecs());
+//     ...
+//     auto segments = gather_segments_for(dest);
+//     read_segments(fd, segments.iovecs());
+//     deserialize_gathered(dest, segments);
+//
+
+inline size_t constexpr DEFAULT_SEGMENT_REFERENCE_THRESHOLD = 0x1000;
+
+// The result of serialized_segments_from.  The referenced blocks are in the serialized value, so it must outlive
+// this, and must not be modified while this is in use.
+class SerializedSegments {
+public:
+
+    // A block that's referred to in place, which goes between the arena bytes before and after arena_offset.
+    struct Reference {
+        size_t arena_offset;
+        std::byte const *data;
+        size_t size;
+    };
+
+    // Blocks smaller than reference_threshold are copied into the arena.
+    explicit SerializedSegments (size_t reference_threshold = DEFAULT_SEGMENT_REFERENCE_THRESHOLD)
+        :   m_reference_threshold(std::max(reference_threshold, size_t(1)))
+    { }
+
+    size_t reference_threshold () const { return m_reference_threshold; }
+    std::vector<std::byte> const &arena () const { return m_arena; }
+    std::vector<Reference> const &references () const { return m_references; }
+    // The total number of serialized bytes.
+    size_t size () const { return m_arena.size() + m_referenced_size; }
+
+    void copy (std::byte const *data, size_t size) {
+        m_arena.insert(m_arena.end(), data, data + size);
+    }
+    void reference (std::byte const *data, size_t size) {
+        if (size < m_reference_threshold) {
+            copy(data, size);
+        } else {
+            m_references.push_back(Reference{m_arena.size(), data, size});
+            m_referenced_size += size;
+        }
+    }
+
+    // Returns the segments in order, as passable to writev or readv.  The arena segments point into this, so
+    // they're invalidated by copy and reference.  The segments are writable, so that they can be read into by
+    // read_segments, which only makes sense for segments made by gather_segments_for.
+    std::vector<iovec> iovecs () const {
+        std::vector<iovec> retval;
+        retval.reserve(2*m_references.size() + 1);
+        auto arena_segment = [this, &retval](size_t begin, size_t end){
+            if (begin < end)
+                retval.push_back(iovec{const_cast<std::byte *>(m_arena.data() + begin), end - begin});
+        };
+        size_t arena_offset = 0;
+        for (auto const &reference : m_references) {
+            arena_segment(arena_offset, reference.arena_offset);
+            retval.push_back(iovec{const_cast<std::byte *>(reference.data), reference.size});
+            arena_offset = reference.arena_offset;
+        }
+        arena_segment(arena_offset, m_arena.size());
+        return retval;
+    }
+
+    // Returns the concatenation of the segments, which is the same as what serialized_from produces.
+    std::vector<std::byte> joined () const {
+        std::vector<std::byte> retval;
+        retval.reserve(size());
+        for (auto const &segment : iovecs()) {
+            auto data = static_cast<std::byte const *>(segment.iov_base);
+            retval.insert(retval.end(), data, data + segment.iov_len);
+        }
+        return retval;
+    }
+
+private:
+
+    size_t m_reference_threshold;
+    std::vector<std::byte> m_arena;
+    std::vector<Reference> m_references;
+    size_t m_referenced_size = 0;
+};
+
+// Output iterator which appends to a SerializedSegments.  Like ByteInserter_t, copies share the destination, so it
+// can be passed by value through nested calls to serialize_from.
+class SegmentInserter_t {
+public:
+
+    using iterator_category = std::output_iterator_tag;
+    using value_type = void;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = void;
+
+    explicit SegmentInserter_t (SerializedSegments &segments) : m_segments(&segments) { }
+
+    SegmentInserter_t &operator = (std::byte b) {
+        m_segments->copy(&b, 1);
+        return *this;
+    }
+    SegmentInserter_t &operator * () { return *this; }
+    SegmentInserter_t &operator ++ () { return *this; }
+    SegmentInserter_t operator ++ (int) { return *this; }
+
+    // Bulk version of operator= (see copy_bytes).
+    void write (std::byte const *bytes, size_t count) {
+        m_segments->copy(bytes, count);
+    }
+    // Refers to the bytes in place, if there are enough of them (see reference_bytes).
+    void write_reference (std::byte const *bytes, size_t count) {
+        m_segments->reference(bytes, count);
+    }
+
+private:
+
+    SerializedSegments *m_segments;
+};
+
+// Serializes source into segments.  source must outlive the returned value, and must not be modified while it's
+// in use.
+template <typename T_>
+SerializedSegments serialized_segments_from (T_ const &source, size_t reference_threshold = DEFAULT_SEGMENT_REFERENCE_THRESHOLD) {
+    SerializedSegments segments(reference_threshold);
+    serialize_from(source, SegmentInserter_t(segments));
+    return segments;
+}
+
+// Returns the segments to read the serialized form of a value having the same shape as dest into, so that its
+// referenced blocks are read directly into dest.  These are the same as the segments of dest itself.
+template <typename T_>
+SerializedSegments gather_segments_for (T_ const &dest, size_t reference_threshold = DEFAULT_SEGMENT_REFERENCE_THRESHOLD) {
+    return serialized_segments_from(dest, reference_threshold);
+}
+
+// The source range for deserialize_gathered, which is over the arena of a SerializedSegments, up to its next
+// reference.  DeserializeTo_Range_t takes the references (see take_reference) in place of reading blocks.
+class GatheredRange_t : public Range_t<std::byte const *> {
+public:
+
+    explicit GatheredRange_t (SerializedSegments const &segments)
+        :   Range_t<std::byte const *>(segments.arena().data(), segments.arena().data())
+        ,   m_segments(&segments)
+    {
+        update_end();
+    }
+    // Copies would have their own state, which would be lost.
+    GatheredRange_t (GatheredRange_t const &) = delete;
+    GatheredRange_t (GatheredRange_t &&) = default;
+
+    // Returns true iff the next reference is here, and has the given size.
+    bool is_at_reference (size_t size) const {
+        auto const &references = m_segments->references();
+        return size > 0 && m_next < references.size() && arena_offset() == references[m_next].arena_offset && references[m_next].size == size;
+    }
+    // If the next reference is here, then this advances past it and returns true, and otherwise returns false.  Throws
+    // if it's not the given block of dest, since then dest doesn't have the shape that the segments were made for.
+    bool take_reference (std::byte const *data, size_t size) {
+        auto const &references = m_segments->references();
+        if (size == 0 || m_next >= references.size() || arena_offset() != references[m_next].arena_offset)
+            return false;
+        if (references[m_next].data != data || references[m_next].size != size)
+            throw std::runtime_error("gathered block doesn't match the destination; the destination must have the shape (i.e. the container sizes) that the gather segments were made for");
+        ++m_next;
+        update_end();
+        return true;
+    }
+    bool is_exhausted () const {
+        return empty() && m_next == m_segments->references().size();
+    }
+
+private:
+
+    size_t arena_offset () const { return size_t(begin() - m_segments->arena().data()); }
+    void update_end () {
+        auto const &references = m_segments->references();
+        end() = m_segments->arena().data() + (m_next < references.size() ? references[m_next].arena_offset : m_segments->arena().size());
+    }
+
+    SerializedSegments const *m_segments;
+    size_t m_next = 0;
+};
+
+template <> struct is_Range_t_<GatheredRange_t> : public std::true_type { };
+template <> struct Range_t_iterator<GatheredRange_t> { using type = std::byte const *; };
+template <> struct is_GatheredRange_t_<GatheredRange_t> : public std::true_type { };
+
+// Finishes a gather-read into dest, whose segments were made by gather_segments_for(dest), and then read into (e.g.
+// by read_segments).  The referenced blocks are already in place, so only the arena is decoded.  Throws if dest
+// doesn't have the shape that was read, or if the gathered bytes aren't entirely used.
+template <typename T_>
+void deserialize_gathered (T_ &dest, SerializedSegments const &segments) {
+    GatheredRange_t range(segments);
+    deserialize_to(dest, std::move(range));
+    if (!range.is_exhausted())
+        throw std::runtime_error("gathered bytes were left over after deserializing the destination");
+}
+
+//
+// Transferring segments.  These retry after partial transfers and EINTR, split the segments into batches of at
+// most IOV_MAX, and throw std::runtime_error upon error, or if the end of the file is reached before the read
+// segments are filled.
+//
+
+void write_segments (int fd, std::vector<iovec> segments);
+void pwrite_segments (int fd, std::vector<iovec> segments, off_t offset);
+void read_segments (int fd, std::vector<iovec> segments);
+void pread_segments (int fd, std::vector<iovec> segments, off_t offset);
+
+} // end namespace lvd
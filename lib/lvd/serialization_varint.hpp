@@ -0,0 +1,310 @@
+// 2021.01.04 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include "lvd/associative_container.hpp"
+#include <cstddef>
+#include <cstdint>
+#include "lvd/DecodeBudget.hpp"
+#include "lvd/g_req_context.hpp"
+#include "lvd/Range_t.hpp"
+#include "lvd/remove_cv_recursive.hpp"
+#include "lvd/serialization.hpp"
+#include "lvd/varint.hpp"
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace lvd {
+
+//
+// Alternate [de]serialization policy to that of SerializeFrom_t/DeserializeTo_t, where container sizes and
+// integers are LEB128 varint-encoded (see lvd/varint.hpp), signed integers being zigzag-encoded first.  This
+// is much more compact when most sizes and integers are small.  Other types (e.g. floating point types, 1-byte
+// types, and types that have no specialization here) fall back to SerializeFrom_t/DeserializeTo_t.
+//
+
+// Defines how to serialize T_ under the varint policy.  Template-specialization should provide method
+// `template <typename DestIterator_> void operator() (T_ const &source, DestIterator_ dest) const`
+template <typename T_> struct SerializeFrom_Varint_t;
+// Defines how to deserialize T_ in-place under the varint policy.  Template-specialization should provide method
+//     template <typename Range_, typename = std::enable_if_t<lvd::is_Range_t<Range_>>>
+//     void operator() (T_ &dest, Range_ &&source_range) const
+template <typename T_> struct DeserializeTo_Varint_t;
+
+//
+// Convenience functions, analogous to those in lvd/serialization.hpp.
+//
+
+template <typename T_, typename DestIterator_>
+void serialize_from_varint (T_ const &source, DestIterator_ dest) {
+    SerializeFrom_Varint_t<T_>()(source, dest);
+}
+
+template <typename T_, typename Range_, typename = std::enable_if_t<is_Range_t<Range_>>>
+void deserialize_to_varint (T_ &dest, Range_ &&source_range) {
+    DeserializeTo_Varint_t<T_>()(dest, std::forward<Range_>(source_range));
+}
+
+template <typename T_>
+std::vector<std::byte> serialized_from_varint (T_ const &source) {
+    std::vector<std::byte> retval;
+    serialize_from_varint(source, std::back_inserter(retval));
+    return retval;
+}
+
+// This requires T_ to be default-constructible.
+template <typename T_, typename Range_, typename = std::enable_if_t<is_Range_t<Range_>>>
+T_ deserialized_to_varint (Range_ &&source_range) {
+    // Value-initialized, since if deserialization fails partway, scalars would be left uninitialized.
+    T_ retval{};
+    deserialize_to_varint(retval, std::forward<Range_>(source_range));
+    return retval;
+}
+
+// Writes the varint encoding of x to dest.
+template <typename DestIterator_>
+void serialize_varint (uint64_t x, DestIterator_ dest) {
+    std::array<std::byte,MAX_VARINT_SIZE> buffer;
+    auto size = encode_varint(x, buffer.data());
+    copy_bytes(buffer.data(), buffer.data()+size, dest);
+}
+
+// Reads a varint from source_range, advancing source_range past it.  If source_range is over a contiguous
+// byte buffer, then this decodes directly from it (using the multi-byte fast path of decode_varint when
+// possible), otherwise the bytes are copied out first.
+template <typename Range_, typename = std::enable_if_t<is_Range_t<Range_>>>
+uint64_t deserialized_varint (Range_ &&source_range) {
+    uint64_t value = 0;
+    size_t size;
+    if constexpr (is_contiguous_byte_iterator_v<Range_t_iterator_t<std::decay_t<Range_>>>) {
+        // Calling &* on an empty range would be undefined.
+        std::byte const *begin = source_range.empty() ? nullptr : &*source_range.begin();
+        size = decode_varint(begin, begin+source_range.size(), value);
+    } else {
+        std::array<std::byte,MAX_VARINT_SIZE> buffer;
+        auto count = std::min(size_t(source_range.size()), MAX_VARINT_SIZE);
+        std::copy(source_range.begin(), source_range.begin()+count, buffer.data());
+        size = decode_varint(buffer.data(), buffer.data()+count, value);
+    }
+    if (size == 0)
+        LVD_G_REQ_NEQ(size, size_t(0), "source_range does not begin with a valid varint");
+    source_range.begin() += size;
+    return value;
+}
+
+//
+// Implementations for various types.
+//
+
+// Default implementation varint-encodes integral types and otherwise falls back to SerializeFrom_t.
+template <typename T_>
+struct SerializeFrom_Varint_t {
+    template <typename DestIterator_>
+    void operator() (T_ const &source, DestIterator_ dest) const {
+        if constexpr (is_varint_encodable_v<T_>)
+            serialize_varint(varint_representation_of(source), dest);
+        else
+            serialize_from(source, dest);
+    }
+};
+
+// Default implementation varint-decodes integral types and otherwise falls back to DeserializeTo_t.
+template <typename T_>
+struct DeserializeTo_Varint_t {
+    template <typename Range_, typename = std::enable_if_t<is_Range_t<Range_>>>
+    void operator() (T_ &dest, Range_ &&source_range) const {
+        if constexpr (is_varint_encodable_v<T_>) {
+            auto representation = deserialized_varint(std::forward<Range_>(source_range));
+            if (!varint_representation_to(representation, dest))
+                LVD_G_REQ_IS_TRUE(false, "varint value is out of the range of the dest type");
+        } else {
+            deserialize_to(dest, std::forward<Range_>(source_range));
+        }
+    }
+};
+
+// Reads a varint container size from source_range, and checks it against the number of bytes remaining,
+// given that each element takes at least min_element_size bytes.  This rejects a corrupt size before it's
+// used to allocate anything.
+template <typename Range_>
+size_t deserialized_varint_container_size (Range_ &source_range, size_t min_element_size) {
+    auto size = deserialized_varint(std::move(source_range));
+    // Divide rather than multiply, so that a huge size can't overflow.
+    if (size > size_t(source_range.size()) / min_element_size)
+        LVD_G_REQ_LEQ(size, size_t(source_range.size()) / min_element_size, "varint container size exceeds the number of bytes remaining in source_range");
+    return size_t(size);
+}
+
+// The minimum number of bytes a value of T_ takes under the varint policy.
+template <typename T_>
+inline size_t constexpr min_varint_serialized_size_v = is_basic_serializable_v<T_> && !is_varint_encodable_v<T_> ? sizeof(T_) : 1;
+
+//
+// Implementation helpers for containers.  Note that sequences of non-varint-encoded basic types (e.g. float,
+// std::byte, or the chars of std::string) are [de]serialized as a block, just as by SerializeFrom_t.
+//
+
+template <typename Container_>
+struct SerializeFrom_Varint_Container_t {
+    template <typename DestIterator_>
+    void operator() (Container_ const &source, DestIterator_ dest) const {
+        using ValueType = remove_cv_recursive_t<typename Container_::value_type>;
+        serialize_varint(source.size(), dest);
+        if constexpr (is_basic_serializable_v<ValueType> && !is_varint_encodable_v<ValueType>) {
+            serialize_from_range(serialization_range_of(source), dest);
+        } else {
+            for (auto const &element : source)
+                serialize_from_varint(element, dest);
+        }
+    }
+};
+
+template <typename Container_>
+struct DeserializeTo_Varint_SequenceContainer_t {
+    template <typename Range_, typename = std::enable_if_t<is_Range_t<Range_>>>
+    void operator() (Container_ &dest, Range_ &&source_range) const {
+        using ValueType = typename Container_::value_type;
+        auto size = deserialized_varint_container_size(source_range, min_varint_serialized_size_v<ValueType>);
+        charge_decode_budget<ValueType>(size);
+        DecodeNestingLevel nesting_level;
+        if constexpr (is_basic_serializable_v<ValueType> && !is_varint_encodable_v<ValueType>) {
+            dest.resize(size);
+            deserialize_to_range(serialization_range_of(dest), std::forward<Range_>(source_range));
+        } else {
+            dest.clear();
+            dest.reserve(size);
+            for (size_t i = 0; i < size; ++i)
+                dest.push_back(deserialized_to_varint<ValueType>(std::forward<Range_>(source_range)));
+        }
+    }
+};
+
+template <typename Container_>
+struct DeserializeTo_Varint_AssociativeContainer_t {
+    template <typename Range_, typename = std::enable_if_t<is_Range_t<Range_>>>
+    void operator() (Container_ &dest, Range_ &&source_range) const {
+        // remove_cv_recursive is needed because for std::map and std::unordered_map, value_type is std::pair<Key_ const, T_>.
+        using ValueType = remove_cv_recursive_t<typename Container_::value_type>;
+        auto size = deserialized_varint_container_size(source_range, min_varint_serialized_size_v<ValueType>);
+        charge_decode_budget<ValueType>(size);
+        DecodeNestingLevel nesting_level;
+        dest.clear();
+        // size has already been checked against the number of bytes remaining.
+        reserve_associative_container(dest, size);
+        for (size_t i = 0; i < size; ++i)
+            emplace_in_serialized_order(dest, deserialized_to_varint<ValueType>(std::forward<Range_>(source_range)));
+    }
+};
+
+template <typename... Types_>
+struct SerializeFrom_Varint_t<std::basic_string<Types_...>> : public SerializeFrom_Varint_Container_t<std::basic_string<Types_...>> { };
+template <typename... Types_>
+struct DeserializeTo_Varint_t<std::basic_string<Types_...>> : public DeserializeTo_Varint_SequenceContainer_t<std::basic_string<Types_...>> { };
+
+template <typename... Types_>
+struct SerializeFrom_Varint_t<std::vector<Types_...>> : public SerializeFrom_Varint_Container_t<std::vector<Types_...>> { };
+template <typename... Types_>
+struct DeserializeTo_Varint_t<std::vector<Types_...>> : public DeserializeTo_Varint_SequenceContainer_t<std::vector<Types_...>> { };
+
+template <typename... Types_>
+struct SerializeFrom_Varint_t<std::map<Types_...>> : public SerializeFrom_Varint_Container_t<std::map<Types_...>> { };
+template <typename... Types_>
+struct DeserializeTo_Varint_t<std::map<Types_...>> : public DeserializeTo_Varint_AssociativeContainer_t<std::map<Types_...>> { };
+
+template <typename... Types_>
+struct SerializeFrom_Varint_t<std::set<Types_...>> : public SerializeFrom_Varint_Container_t<std::set<Types_...>> { };
+template <typename... Types_>
+struct DeserializeTo_Varint_t<std::set<Types_...>> : public DeserializeTo_Varint_AssociativeContainer_t<std::set<Types_...>> { };
+
+template <typename... Types_>
+struct SerializeFrom_Varint_t<std::unordered_map<Types_...>> : public SerializeFrom_Varint_Container_t<std::unordered_map<Types_...>> { };
+template <typename... Types_>
+struct DeserializeTo_Varint_t<std::unordered_map<Types_...>> : public DeserializeTo_Varint_AssociativeContainer_t<std::unordered_map<Types_...>> { };
+
+template <typename... Types_>
+struct SerializeFrom_Varint_t<std::unordered_set<Types_...>> : public SerializeFrom_Varint_Container_t<std::unordered_set<Types_...>> { };
+template <typename... Types_>
+struct DeserializeTo_Varint_t<std::unordered_set<Types_...>> : public DeserializeTo_Varint_AssociativeContainer_t<std::unordered_set<Types_...>> { };
+
+//
+// std::array<T,N> -- the size is not serialized, since it's known statically.
+//
+
+template <typename T_, size_t N_>
+struct SerializeFrom_Varint_t<std::array<T_,N_>> {
+    template <typename DestIterator_>
+    void operator() (std::array<T_,N_> const &source, DestIterator_ dest) const {
+        if constexpr (is_basic_serializable_v<T_> && !is_varint_encodable_v<T_>) {
+            serialize_from(source, dest);
+        } else {
+            for (auto const &element : source)
+                serialize_from_varint(element, dest);
+        }
+    }
+};
+
+template <typename T_, size_t N_>
+struct DeserializeTo_Varint_t<std::array<T_,N_>> {
+    template <typename Range_, typename = std::enable_if_t<is_Range_t<Range_>>>
+    void operator() (std::array<T_,N_> &dest, Range_ &&source_range) const {
+        if constexpr (is_basic_serializable_v<T_> && !is_varint_encodable_v<T_>) {
+            deserialize_to(dest, std::forward<Range_>(source_range));
+        } else {
+            for (auto &element : dest)
+                deserialize_to_varint(element, std::forward<Range_>(source_range));
+        }
+    }
+};
+
+//
+// std::pair<F,S>
+//
+
+template <typename F_, typename S_>
+struct SerializeFrom_Varint_t<std::pair<F_,S_>> {
+    template <typename DestIterator_>
+    void operator() (std::pair<F_,S_> const &source, DestIterator_ dest) const {
+        serialize_from_varint(source.first, dest);
+        serialize_from_varint(source.second, dest);
+    }
+};
+
+template <typename F_, typename S_>
+struct DeserializeTo_Varint_t<std::pair<F_,S_>> {
+    template <typename Range_, typename = std::enable_if_t<is_Range_t<Range_>>>
+    void operator() (std::pair<F_,S_> &dest, Range_ &&source_range) const {
+        deserialize_to_varint(dest.first, std::forward<Range_>(source_range));
+        deserialize_to_varint(dest.second, std::forward<Range_>(source_range));
+    }
+};
+
+//
+// std::optional<T_>
+//
+
+template <typename T_>
+struct SerializeFrom_Varint_t<std::optional<T_>> {
+    template <typename DestIterator_>
+    void operator() (std::optional<T_> const &source, DestIterator_ dest) const {
+        serialize_from(source.has_value(), dest);
+        if (source.has_value())
+            serialize_from_varint(source.value(), dest);
+    }
+};
+
+template <typename T_>
+struct DeserializeTo_Varint_t<std::optional<T_>> {
+    template <typename Range_, typename = std::enable_if_t<is_Range_t<Range_>>>
+    void operator() (std::optional<T_> &dest, Range_ &&source_range) const {
+        auto has_value = deserialized_to<bool>(std::forward<Range_>(source_range));
+        if (has_value)
+            dest = std::make_optional<T_>(deserialized_to_varint<T_>(std::forward<Range_>(source_range)));
+        else
+            dest = std::nullopt;
+    }
+};
+
+} // end namespace lvd
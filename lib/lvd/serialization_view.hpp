@@ -0,0 +1,146 @@
+// 2021.01.04 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "lvd/endian.hpp"
+#include "lvd/Range_t.hpp"
+#include "lvd/serialization.hpp"
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace lvd {
+
+//
+// Zero-copy deserialization.  Instead of materializing an owning value, these produce a read-only view
+// which refers directly into the source buffer, so the source buffer must outlive the view.  The serialized
+// form is the same as for DeserializeTo_t.
+//
+
+// Defines how to deserialize a read-only view of a serialized T_.  Template-specialization should provide
+//     using View = ...;
+//     template <typename Range_, typename = std::enable_if_t<lvd::is_Range_t<Range_>>>
+//     View operator() (Range_ &&source_range) const
+// where source_range must be over a contiguous byte buffer (see is_contiguous_byte_iterator_v).
+template <typename T_> struct DeserializedView_t;
+
+// Convenience function to get a deserialized view.  source_range is advanced past the viewed value.
+template <typename T_, typename Range_, typename = std::enable_if_t<is_Range_t<Range_>>>
+typename DeserializedView_t<T_>::View deserialized_view_of (Range_ &&source_range) {
+    return DeserializedView_t<T_>()(std::forward<Range_>(source_range));
+}
+
+// Reads the uint32_t size of a serialized sequence of T_ from source_range, checks that the elements are all
+// present, and returns a pointer to the first byte of the elements.  source_range is advanced past the elements.
+template <typename T_, typename Range_>
+std::pair<std::byte const *,size_t> deserialized_sequence_bytes (Range_ &source_range) {
+    static_assert(is_contiguous_byte_iterator_v<Range_t_iterator_t<std::decay_t<Range_>>>, "source_range must be over a contiguous byte buffer");
+    size_t size = deserialized_to<uint32_t>(std::move(source_range));
+    require_source_size(source_range, size*sizeof(T_));
+    // Calling &* on an empty range would be undefined, so use nullptr instead (which is valid for a 0-sized view).
+    std::byte const *bytes = size == 0 ? nullptr : &*source_range.begin();
+    source_range.begin() += size*sizeof(T_);
+    return {bytes, size};
+}
+
+//
+// std::basic_string<Char_,...> -- viewed as std::basic_string_view<Char_,...>.  This is always zero-copy,
+// and is only defined for 1-byte Char_, since the view has no way to fix the byte order of wider characters.
+//
+
+template <typename Char_, typename Traits_, typename Allocator_>
+struct DeserializedView_t<std::basic_string<Char_,Traits_,Allocator_>> {
+    static_assert(sizeof(Char_) == 1, "zero-copy string views are only supported for 1-byte character types");
+
+    using View = std::basic_string_view<Char_,Traits_>;
+
+    template <typename Range_, typename = std::enable_if_t<is_Range_t<Range_>>>
+    View operator() (Range_ &&source_range) const {
+        auto [bytes, size] = deserialized_sequence_bytes<Char_>(source_range);
+        return View(reinterpret_cast<Char_ const *>(bytes), size);
+    }
+};
+
+//
+// std::vector<T_> for basic-serializable T_ -- viewed as SequenceView_t<T_>.
+//
+
+// Read-only view of a deserialized sequence of T_.  If the serialized elements can be used in-place (i.e. the
+// serialized byte order matches the machine's and the elements are suitably aligned), then this refers directly
+// into the source buffer.  Otherwise it owns a converted copy.  In either case, range() is contiguous.
+template <typename T_>
+class SequenceView_t {
+public:
+
+    using value_type = T_;
+    using const_iterator = T_ const *;
+
+    // Views the given elements in-place.
+    explicit SequenceView_t (Range_t<T_ const *> const &range)
+        :   m_range(range)
+        ,   m_is_zero_copy(true)
+    { }
+    // Takes ownership of the given elements.  Note that std::vector's move constructor doesn't move its
+    // elements, so m_range remains valid when this is moved.
+    explicit SequenceView_t (std::vector<T_> &&storage)
+        :   m_range(storage.data(), storage.data()+storage.size())
+        ,   m_storage(std::move(storage))
+        ,   m_is_zero_copy(false)
+    { }
+    // Copying would invalidate m_range in the owning case.
+    SequenceView_t (SequenceView_t const &) = delete;
+    SequenceView_t (SequenceView_t &&) = default;
+
+    SequenceView_t &operator = (SequenceView_t const &) = delete;
+    SequenceView_t &operator = (SequenceView_t &&) = default;
+
+    T_ const *begin () const { return m_range.begin(); }
+    T_ const *end () const { return m_range.end(); }
+    T_ const *data () const { return m_range.begin(); }
+    size_t size () const { return size_t(m_range.size()); }
+    bool empty () const { return m_range.empty(); }
+    T_ const &operator [] (size_t i) const { return m_range.begin()[i]; }
+
+    Range_t<T_ const *> const &range () const { return m_range; }
+    // Returns true iff this refers directly into the source buffer (as opposed to owning a copy).
+    bool is_zero_copy () const { return m_is_zero_copy; }
+
+    // Produces an owning copy, e.g. for when the view needs to outlive the source buffer.
+    std::vector<T_> to_vector () const { return std::vector<T_>(begin(), end()); }
+
+private:
+
+    Range_t<T_ const *> m_range;
+    std::vector<T_> m_storage;
+    // An owned copy can be empty, so this can't be determined from m_storage.
+    bool m_is_zero_copy;
+};
+
+template <typename T_, typename Allocator_>
+struct DeserializedView_t<std::vector<T_,Allocator_>> {
+    // bool is excluded because std::vector<bool> has no data(), and because it's serialized as a bitmap.
+    static_assert(is_basic_serializable_v<T_> && !std::is_same_v<T_,bool>, "zero-copy vector views are only supported for basic-serializable element types other than bool");
+
+    using View = SequenceView_t<T_>;
+
+    template <typename Range_, typename = std::enable_if_t<is_Range_t<Range_>>>
+    View operator() (Range_ &&source_range) const {
+        auto [bytes, size] = deserialized_sequence_bytes<T_>(source_range);
+        bool is_aligned = reinterpret_cast<std::uintptr_t>(bytes) % alignof(T_) == 0;
+        if ((sizeof(T_) == 1 || machine_endianness() == Endianness::LIL) && is_aligned) {
+            auto elements = reinterpret_cast<T_ const *>(bytes);
+            return View(Range_t<T_ const *>(elements, elements+size));
+        } else {
+            // Either the elements have to be byte-swapped, or they're misaligned (e.g. 8-byte elements following
+            // the 4-byte size), so they have to be copied out.
+            std::vector<T_> storage(size);
+            deserialize_to_range(lvd::range(storage.data(), storage.data()+size), Range_t<std::byte const *>(bytes, bytes+size*sizeof(T_)));
+            return View(std::move(storage));
+        }
+    }
+};
+
+} // end namespace lvd
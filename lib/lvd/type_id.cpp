@@ -0,0 +1,105 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#include <array>
+#include <limits>
+#include "lvd/type_id.hpp"
+#include "lvd/varint.hpp"
+
+namespace lvd {
+
+namespace {
+
+// Parses the type tag starting at *cursor (advancing *cursor past it), and appends its type string to type_string.
+void append_type_string_of_type_tag (std::byte const *&cursor, std::byte const *end, std::string &type_string, size_t depth) {
+    if (depth > MAX_TYPE_TAG_DEPTH)
+        throw std::runtime_error("type tag is nested too deeply");
+
+    auto read_varint = [&cursor, end](){
+        uint64_t x;
+        auto size = decode_varint(cursor, end, x);
+        if (size == 0)
+            throw std::runtime_error("malformed type tag");
+        cursor += size;
+        return x;
+    };
+
+    auto type_id = read_varint();
+    if (type_id == UNREGISTERED_TYPE_ID) {
+        auto size = read_varint();
+        if (size > uint64_t(end - cursor))
+            throw std::runtime_error("malformed type tag");
+        type_string.append(reinterpret_cast<char const *>(cursor), size_t(size));
+        cursor += size;
+    } else if (is_type_template_id(type_id)) {
+        auto template_id = TypeTemplateId(type_id);
+        auto arity = type_template_arity(template_id);
+        if (arity == VARIADIC_TYPE_TEMPLATE_ARITY)
+            arity = read_varint();
+        type_string += as_string(template_id);
+        type_string += '<';
+        for (uint64_t i = 0; i < arity; ++i) {
+            if (i > 0)
+                type_string += ',';
+            append_type_string_of_type_tag(cursor, end, type_string, depth+1);
+        }
+        if (template_id == TypeTemplateId::ARRAY) {
+            type_string += ',';
+            type_string += std::to_string(read_varint());
+        }
+        type_string += '>';
+    } else if (type_id <= std::numeric_limits<TypeId>::max()) {
+        auto registered_type_string = static_association_singleton<TypeIdRegistry>().type_string_of(TypeId(type_id));
+        if (registered_type_string == nullptr)
+            throw std::runtime_error("unregistered type id " + std::to_string(type_id));
+        type_string += *registered_type_string;
+    } else {
+        throw std::runtime_error("malformed type tag");
+    }
+}
+
+} // end of anonymous namespace
+
+std::string type_tag_varint (uint64_t x) {
+    std::array<std::byte,MAX_VARINT_SIZE> buffer;
+    auto size = encode_varint(x, buffer.data());
+    return std::string(reinterpret_cast<char const *>(buffer.data()), size);
+}
+
+std::string type_tag_of_type_string (std::string const &type_string, std::string &&unregistered_type_tag) {
+    auto type_id = static_association_singleton<TypeIdRegistry>().type_id_of(type_string);
+    if (type_id == UNREGISTERED_TYPE_ID)
+        return std::move(unregistered_type_tag);
+    else
+        return type_tag_varint(type_id);
+}
+
+std::string type_string_of_type_tag (std::string const &type_tag) {
+    auto cursor = reinterpret_cast<std::byte const *>(type_tag.data());
+    auto end = cursor + type_tag.size();
+    std::string retval;
+    append_type_string_of_type_tag(cursor, end, retval, 0);
+    if (cursor != end)
+        throw std::runtime_error("malformed type tag");
+    return retval;
+}
+
+} // end namespace lvd
+
+
+// These ids are part of the binary format, so they must never change.  Ids up to MIN_USER_TYPE_ID-1 are
+// reserved for lvd, and ids 32 through 63 are used by TypeTemplateId.
+LVD_REGISTER_TYPE_ID(bool, 1, bool)
+LVD_REGISTER_TYPE_ID(byte, 2, std::byte)
+LVD_REGISTER_TYPE_ID(char, 3, char)
+LVD_REGISTER_TYPE_ID(int8_t, 4, int8_t)
+LVD_REGISTER_TYPE_ID(uint8_t, 5, uint8_t)
+LVD_REGISTER_TYPE_ID(int16_t, 6, int16_t)
+LVD_REGISTER_TYPE_ID(uint16_t, 7, uint16_t)
+LVD_REGISTER_TYPE_ID(int32_t, 8, int32_t)
+LVD_REGISTER_TYPE_ID(uint32_t, 9, uint32_t)
+LVD_REGISTER_TYPE_ID(int64_t, 10, int64_t)
+LVD_REGISTER_TYPE_ID(uint64_t, 11, uint64_t)
+LVD_REGISTER_TYPE_ID(float, 12, float)
+LVD_REGISTER_TYPE_ID(double, 13, double)
+LVD_REGISTER_TYPE_ID(string, 14, std::string)
+LVD_REGISTER_TYPE_ID(Empty, 15, lvd::Empty)
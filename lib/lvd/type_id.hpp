@@ -0,0 +1,203 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "lvd/StaticAssociation_t.hpp"
+#include "lvd/type_string_of.hpp"
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace lvd {
+
+//
+// Registry of small integer type ids, which are used to tag values in TypeEncoding::INCLUDED binary encodings
+// in place of their (much longer) type strings.  Ids are assigned explicitly at registration, so they're
+// deterministic across processes, but the writer and the reader of a stream must register the same ids.
+// Ids 1 through 31 are reserved for lvd's builtin types (see type_id.cpp), and ids 32 through 63 for the standard
+// type templates (see TypeTemplateId); other registrations should use ids starting at 64 (ids less than 128 take
+// a single byte in the encoding, and those less than 16384 take two).
+//
+
+using TypeId = uint32_t;
+
+// Indicates that a type has no registered id.  In this case, the type string is encoded instead.
+inline TypeId constexpr UNREGISTERED_TYPE_ID = 0;
+// The smallest id that isn't reserved for lvd.
+inline TypeId constexpr MIN_USER_TYPE_ID = 64;
+
+// Ids of the standard type templates.  An instance of one of these which doesn't have its own registered id is
+// tagged with the template id followed by the type tags of its arguments (see TypeTag_t).  For the variadic ones
+// (std::tuple and std::variant), the argument count precedes the arguments, and for std::array, the size follows
+// the element type.  These ids are part of the binary format, so they must never change.
+enum class TypeTemplateId : TypeId {
+    ARRAY = 32,
+    MAP,
+    OPTIONAL,
+    PAIR,
+    SET,
+    TUPLE,
+    UNORDERED_MAP,
+    UNORDERED_SET,
+    VARIANT,
+    VECTOR,
+
+    __LOWEST__ = ARRAY,
+    __HIGHEST__ = VECTOR
+};
+
+inline bool constexpr is_type_template_id (uint64_t type_id) {
+    return TypeId(TypeTemplateId::__LOWEST__) <= type_id && type_id <= TypeId(TypeTemplateId::__HIGHEST__);
+}
+
+// Indicates a type template that takes any number of type arguments.
+inline size_t constexpr VARIADIC_TYPE_TEMPLATE_ARITY = size_t(-1);
+
+// Returns the number of type arguments that the given type template is tagged with.
+inline size_t constexpr type_template_arity (TypeTemplateId template_id) {
+    switch (template_id) {
+        case TypeTemplateId::MAP:
+        case TypeTemplateId::PAIR:
+        case TypeTemplateId::UNORDERED_MAP:
+            return 2;
+        case TypeTemplateId::TUPLE:
+        case TypeTemplateId::VARIANT:
+            return VARIADIC_TYPE_TEMPLATE_ARITY;
+        default:
+            return 1;
+    }
+}
+
+// Returns the name of the given type template, as it appears in type strings, e.g. "vector".
+inline std::string const &as_string (TypeTemplateId x) {
+    auto constexpr COUNT = size_t(TypeTemplateId::__HIGHEST__) - size_t(TypeTemplateId::__LOWEST__) + 1;
+    static std::array<std::string,COUNT> const TABLE{
+        "array",
+        "map",
+        "optional",
+        "pair",
+        "set",
+        "tuple",
+        "unordered_map",
+        "unordered_set",
+        "variant",
+        "vector",
+    };
+    return TABLE.at(size_t(x) - size_t(TypeTemplateId::__LOWEST__));
+}
+
+// The maximum depth of type template arguments that a type tag being read can have, since it may be untrusted.
+inline size_t constexpr MAX_TYPE_TAG_DEPTH = 0x100;
+
+// Bidirectional map between type strings and type ids, for use as the container of a static association.
+class TypeIdRegistry_t {
+public:
+
+    // Registers the given type string with the given type id.  Returns false if either one is already registered.
+    std::pair<TypeId,bool> emplace (std::string const &type_string, TypeId type_id) {
+        if (type_id == UNREGISTERED_TYPE_ID)
+            throw std::domain_error("type id " + std::to_string(UNREGISTERED_TYPE_ID) + " is reserved to mean unregistered");
+        if (is_type_template_id(type_id))
+            throw std::domain_error("type id " + std::to_string(type_id) + " is reserved for a type template");
+        if (m_type_id_of.find(type_string) != m_type_id_of.end() || m_type_string_of.find(type_id) != m_type_string_of.end())
+            return {type_id, false};
+        m_type_id_of.emplace(type_string, type_id);
+        m_type_string_of.emplace(type_id, type_string);
+        return {type_id, true};
+    }
+
+    // Returns UNREGISTERED_TYPE_ID if type_string isn't registered.
+    TypeId type_id_of (std::string const &type_string) const {
+        auto it = m_type_id_of.find(type_string);
+        return it == m_type_id_of.end() ? UNREGISTERED_TYPE_ID : it->second;
+    }
+    // Returns nullptr if type_id isn't registered.
+    std::string const *type_string_of (TypeId type_id) const {
+        auto it = m_type_string_of.find(type_id);
+        return it == m_type_string_of.end() ? nullptr : &it->second;
+    }
+
+    size_t size () const { return m_type_id_of.size(); }
+
+private:
+
+    std::unordered_map<std::string,TypeId> m_type_id_of;
+    std::unordered_map<TypeId,std::string> m_type_string_of;
+};
+
+struct TypeIdRegistry { using Container = TypeIdRegistry_t; };
+
+// Returns the registered id of T_, or UNREGISTERED_TYPE_ID.  The lookup is done once per T_, so this must
+// not be called before the registration of T_ has happened (i.e. during static initialization).
+template <typename T_>
+TypeId type_id_of () {
+    static TypeId const TYPE_ID = static_association_singleton<TypeIdRegistry>().type_id_of(type_string_of<T_>());
+    return TYPE_ID;
+}
+
+//
+// A type tag is the byte sequence that identifies a type in TypeEncoding::INCLUDED binary encodings.  It's
+// the varint-encoded registered id of the type if it has one.  Otherwise, for an instance of one of the standard
+// type templates (see TypeTemplateId), it's the template id followed by the type tags of its arguments, and for
+// anything else, it's UNREGISTERED_TYPE_ID followed by the varint-encoded length of the type string and the type
+// string itself.  Thus e.g. std::map<std::string,std::vector<float>> is tagged with 4 bytes.
+//
+
+// Returns the varint encoding of x, for building type tags.
+std::string type_tag_varint (uint64_t x);
+
+// Returns the type tag of the type having the given type string, given the type tag that it has if it doesn't
+// have its own registered id.
+std::string type_tag_of_type_string (std::string const &type_string, std::string &&unregistered_type_tag);
+
+// Returns the type tag of the type having the given type string, for a type that isn't a type template instance.
+inline std::string type_tag_of_type_string (std::string const &type_string) {
+    return type_tag_of_type_string(type_string, type_tag_varint(UNREGISTERED_TYPE_ID) + type_tag_varint(type_string.size()) + type_string);
+}
+
+// Returns the type tag of an instance of the given type template, given the type tags of its arguments.
+template <typename... TypeTags_>
+std::string type_tag_of_template (TypeTemplateId template_id, TypeTags_ const &... argument_type_tags) {
+    auto retval = type_tag_varint(TypeId(template_id));
+    if (type_template_arity(template_id) == VARIADIC_TYPE_TEMPLATE_ARITY)
+        retval += type_tag_varint(sizeof...(TypeTags_));
+    ((retval += argument_type_tags), ...);
+    return retval;
+}
+
+// Returns the type string of the type having the given type tag.  Throws if type_tag is malformed, or if it
+// contains a type id that isn't registered.
+std::string type_string_of_type_tag (std::string const &type_tag);
+
+// Defines the type tag of T_.  Type template instances specialize this (see e.g. type_string_of_vector.hpp).
+// The type tag is computed once per T_, so this has the same caveat about static initialization as type_id_of.
+template <typename T_>
+struct TypeTag_t {
+    static std::string const &get () {
+        static std::string const TAG{type_tag_of_type_string(type_string_of<T_>())};
+        return TAG;
+    }
+};
+
+template <typename T_>
+struct TypeTag_t<Type_t<T_>> {
+    static std::string const &get () {
+        return TypeTag_t<T_>::get();
+    }
+};
+
+template <typename T_>
+std::string const &type_tag_of () {
+    return TypeTag_t<T_>::get();
+}
+
+} // end namespace lvd
+
+// Use this macro (at global scope, in exactly one translation unit per type) to register the given type id for
+// the given type.  The type is last so that template types having commas in them work.
+#define LVD_REGISTER_TYPE_ID(unique_id, type_id, ...) \
+    namespace { inline static lvd::StaticAssociationRegistrar_t<lvd::TypeIdRegistry> __TypeIdRegistry__##unique_id{lvd::FiLoc(__FILE__, __LINE__), lvd::type_string_of<__VA_ARGS__>(), lvd::TypeId(type_id)}; }
@@ -0,0 +1,149 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include <cstddef>
+#include <ios>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace lvd {
+
+//
+// Per-stream interning of the type strings that tag values in TypeEncoding::INCLUDED binary encodings.
+// While a session is attached to a stream, the first occurrence of each type string is written in full, and
+// later occurrences are written as a varint back-reference into the table of type strings written so far.
+// The session is found via the stream's pword storage, so no change is needed in how values are written or
+// read.  Within a session, types are always tagged by their type strings (i.e. registered type ids aren't
+// used), so the stream is self-describing.  Both ends of the stream must use a session.
+//
+// The tag format is a varint n, where n == 0 means that a new type string follows (and is appended to the
+// table), and n > 0 is a back-reference to the (n-1)th type string in the table.
+//
+
+// Attaches an interning session to an output stream for its lifetime, restoring the previous one (if any)
+// upon destruction.
+class TypeInterningWriteSession {
+public:
+
+    explicit TypeInterningWriteSession (std::ios_base &stream)
+        :   m_stream(stream)
+        ,   m_previous(stream.pword(pword_index()))
+    {
+        m_stream.pword(pword_index()) = this;
+    }
+    TypeInterningWriteSession (TypeInterningWriteSession const &) = delete;
+    TypeInterningWriteSession (TypeInterningWriteSession &&) = delete;
+    ~TypeInterningWriteSession () {
+        m_stream.pword(pword_index()) = m_previous;
+    }
+
+    TypeInterningWriteSession &operator = (TypeInterningWriteSession const &) = delete;
+    TypeInterningWriteSession &operator = (TypeInterningWriteSession &&) = delete;
+
+    // Returns the session attached to the given stream, or nullptr if there is none.  Sessions can only be
+    // attached to iostreams, so this is always nullptr for other streams (e.g. ByteWriter and ByteReader).
+    template <typename Stream_>
+    static TypeInterningWriteSession *of (Stream_ &stream) {
+        if constexpr (std::is_base_of_v<std::ios_base,Stream_>)
+            return static_cast<TypeInterningWriteSession *>(stream.pword(pword_index()));
+        else
+            return nullptr;
+    }
+
+    // Returns the back-reference to type_string if it's already in the table.  Otherwise adds it and returns 0,
+    // meaning that type_string must be written in full.  Type strings are identified by address (see
+    // TypeString_t<T_>::get, which returns a singleton), so that this doesn't have to hash them.
+    size_t back_reference_of (std::string const &type_string) {
+        auto [it, inserted] = m_back_reference_of.emplace(&type_string, m_back_reference_of.size()+1);
+        return inserted ? 0 : it->second;
+    }
+
+    size_t table_size () const { return m_back_reference_of.size(); }
+
+private:
+
+    static int pword_index () {
+        static int const PWORD_INDEX = std::ios_base::xalloc();
+        return PWORD_INDEX;
+    }
+
+    std::ios_base &m_stream;
+    void *m_previous;
+    std::unordered_map<std::string const *,size_t> m_back_reference_of;
+};
+
+// Attaches an interning session to an input stream for its lifetime, restoring the previous one (if any)
+// upon destruction.
+class TypeInterningReadSession {
+public:
+
+    explicit TypeInterningReadSession (std::ios_base &stream)
+        :   m_stream(stream)
+        ,   m_previous(stream.pword(pword_index()))
+    {
+        m_stream.pword(pword_index()) = this;
+    }
+    TypeInterningReadSession (TypeInterningReadSession const &) = delete;
+    TypeInterningReadSession (TypeInterningReadSession &&) = delete;
+    ~TypeInterningReadSession () {
+        m_stream.pword(pword_index()) = m_previous;
+    }
+
+    TypeInterningReadSession &operator = (TypeInterningReadSession const &) = delete;
+    TypeInterningReadSession &operator = (TypeInterningReadSession &&) = delete;
+
+    // Returns the session attached to the given stream, or nullptr if there is none.  Sessions can only be
+    // attached to iostreams, so this is always nullptr for other streams (e.g. ByteWriter and ByteReader).
+    template <typename Stream_>
+    static TypeInterningReadSession *of (Stream_ &stream) {
+        if constexpr (std::is_base_of_v<std::ios_base,Stream_>)
+            return static_cast<TypeInterningReadSession *>(stream.pword(pword_index()));
+        else
+            return nullptr;
+    }
+
+    // Appends a type string that was read in full, and returns its back-reference.
+    size_t add (std::string &&type_string) {
+        m_entries.push_back(Entry{std::move(type_string), nullptr});
+        return m_entries.size();
+    }
+
+    // Throws if the type string having the given back-reference doesn't match expected_type_string, which must
+    // be a singleton (see TypeString_t<T_>::get).  Each entry remembers what it was last validated as, so
+    // repeated occurrences of the same type only cost a pointer compare.
+    void validate (size_t back_reference, std::string const &expected_type_string) {
+        if (back_reference == 0 || back_reference > m_entries.size())
+            throw std::runtime_error("invalid type string back-reference " + std::to_string(back_reference) + " (table size is " + std::to_string(m_entries.size()) + ')');
+        auto &entry = m_entries[back_reference-1];
+        if (entry.validated_as == &expected_type_string)
+            return;
+        if (entry.type_string != expected_type_string)
+            throw std::runtime_error("type mismatch; expected \"" + expected_type_string + "\" but got \"" + entry.type_string + '"');
+        entry.validated_as = &expected_type_string;
+    }
+
+    size_t table_size () const { return m_entries.size(); }
+
+private:
+
+    struct Entry {
+        std::string type_string;
+        std::string const *validated_as;
+    };
+
+    static int pword_index () {
+        static int const PWORD_INDEX = std::ios_base::xalloc();
+        return PWORD_INDEX;
+    }
+
+    std::ios_base &m_stream;
+    void *m_previous;
+    std::vector<Entry> m_entries;
+};
+
+} // end namespace lvd
@@ -4,6 +4,7 @@
 
 #include <array>
 #include "lvd/fmt.hpp"
+#include "lvd/type_id.hpp"
 #include "lvd/type_string_of.hpp"
 
 namespace lvd {
@@ -16,4 +17,12 @@ struct TypeString_t<std::array<T_,N_>> {
     }
 };
 
+template <typename T_, size_t N_>
+struct TypeTag_t<std::array<T_,N_>> {
+    static std::string const &get () {
+        static std::string const TAG{type_tag_of_type_string(type_string_of<std::array<T_,N_>>(), type_tag_of_template(TypeTemplateId::ARRAY, type_tag_of<T_>()) + type_tag_varint(N_))};
+        return TAG;
+    }
+};
+
 } // end namespace lvd
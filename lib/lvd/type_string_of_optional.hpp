@@ -2,8 +2,9 @@
 
 #pragma once
 
-#include "lvd/type_string_of.hpp"
 #include <optional>
+#include "lvd/type_id.hpp"
+#include "lvd/type_string_of.hpp"
 
 namespace lvd {
 
@@ -15,4 +16,12 @@ struct TypeString_t<std::optional<T_>> {
     }
 };
 
+template <typename T_>
+struct TypeTag_t<std::optional<T_>> {
+    static std::string const &get () {
+        static std::string const TAG{type_tag_of_type_string(type_string_of<std::optional<T_>>(), type_tag_of_template(TypeTemplateId::OPTIONAL, type_tag_of<T_>()))};
+        return TAG;
+    }
+};
+
 } // end namespace lvd
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "lvd/type_id.hpp"
 #include "lvd/type_string_of.hpp"
 #include <utility>
 
@@ -15,4 +16,12 @@ struct TypeString_t<std::pair<Types_...>> {
     }
 };
 
+template <typename... Types_>
+struct TypeTag_t<std::pair<Types_...>> {
+    static std::string const &get () {
+        static std::string const TAG{type_tag_of_type_string(type_string_of<std::pair<Types_...>>(), type_tag_of_template(TypeTemplateId::PAIR, type_tag_of<Types_>()...))};
+        return TAG;
+    }
+};
+
 } // end namespace lvd
@@ -2,8 +2,9 @@
 
 #pragma once
 
-#include "lvd/type_string_of.hpp"
 #include <set>
+#include "lvd/type_id.hpp"
+#include "lvd/type_string_of.hpp"
 
 namespace lvd {
 
@@ -15,4 +16,12 @@ struct TypeString_t<std::set<Key_,Rest_...>> {
     }
 };
 
+template <typename Key_, typename... Rest_>
+struct TypeTag_t<std::set<Key_,Rest_...>> {
+    static std::string const &get () {
+        static std::string const TAG{type_tag_of_type_string(type_string_of<std::set<Key_,Rest_...>>(), type_tag_of_template(TypeTemplateId::SET, type_tag_of<Key_>()))};
+        return TAG;
+    }
+};
+
 } // end namespace lvd
@@ -2,8 +2,9 @@
 
 #pragma once
 
-#include "lvd/type_string_of.hpp"
 #include <tuple>
+#include "lvd/type_id.hpp"
+#include "lvd/type_string_of.hpp"
 
 namespace lvd {
 
@@ -15,4 +16,12 @@ struct TypeString_t<std::tuple<Types_...>> {
     }
 };
 
+template <typename... Types_>
+struct TypeTag_t<std::tuple<Types_...>> {
+    static std::string const &get () {
+        static std::string const TAG{type_tag_of_type_string(type_string_of<std::tuple<Types_...>>(), type_tag_of_template(TypeTemplateId::TUPLE, type_tag_of<Types_>()...))};
+        return TAG;
+    }
+};
+
 } // end namespace lvd
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "lvd/type_id.hpp"
 #include "lvd/type_string_of.hpp"
 #include <unordered_map>
 
@@ -15,4 +16,12 @@ struct TypeString_t<std::unordered_map<Key_,Value_,Rest_...>> {
     }
 };
 
+template <typename Key_, typename Value_, typename... Rest_>
+struct TypeTag_t<std::unordered_map<Key_,Value_,Rest_...>> {
+    static std::string const &get () {
+        static std::string const TAG{type_tag_of_type_string(type_string_of<std::unordered_map<Key_,Value_,Rest_...>>(), type_tag_of_template(TypeTemplateId::UNORDERED_MAP, type_tag_of<Key_>(), type_tag_of<Value_>()))};
+        return TAG;
+    }
+};
+
 } // end namespace lvd
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "lvd/type_id.hpp"
 #include "lvd/type_string_of.hpp"
 #include <vector>
 
@@ -15,4 +16,12 @@ struct TypeString_t<std::vector<T_,Rest_...>> {
     }
 };
 
+template <typename T_, typename... Rest_>
+struct TypeTag_t<std::vector<T_,Rest_...>> {
+    static std::string const &get () {
+        static std::string const TAG{type_tag_of_type_string(type_string_of<std::vector<T_,Rest_...>>(), type_tag_of_template(TypeTemplateId::VECTOR, type_tag_of<T_>()))};
+        return TAG;
+    }
+};
+
 } // end namespace lvd
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <stdexcept>
 #include "lvd/type.hpp"
 #include <variant>
 
@@ -18,6 +19,21 @@ template <typename... Types_> struct Visitor_t : Types_... {
     using Types_::operator()...;
 };
 
+// Helper for call_on_indexed_type.  Holds a table, indexed by alternative, of functions which each call
+// function(ty<T>) for their alternative T, so that dispatch is a single indirect call regardless of the number
+// of types (instead of a chain of comparisons whose length is the index).
+template <typename Function_, typename... Types_>
+struct IndexedTypeCallTable_t {
+    using Entry = void (*)(Function_ const &);
+
+    template <typename T_>
+    static void call (Function_ const &function) {
+        function(ty<T_>);
+    }
+
+    static inline Entry constexpr ENTRIES[sizeof...(Types_)] = { &call<Types_>... };
+};
+
 // This is a way to essentially do a switch statement on a variadic sequence of types using
 // an index that's only known at runtime.  Should pass in a lambda of the form
 //
@@ -27,16 +43,14 @@ template <typename... Types_> struct Visitor_t : Types_... {
 //         <do something that is specific to T_>
 //     }
 //
-// The passed-in t will range through Types_... via Type_t.
+// The passed-in t will range through Types_... via Type_t.  Only indices in [TRY_INDEX_, sizeof...(Types_))
+// are accepted; any other index throws.  Dispatch is done through a table, so it takes constant time.
 template <size_t TRY_INDEX_, typename... Types_, typename Function_>
 void call_on_indexed_type (size_t index, Function_ const &function) {
-    if (index == TRY_INDEX_) {
-        function(ty<std::tuple_element_t<TRY_INDEX_,std::tuple<Types_...>>>);
-    } else if constexpr (TRY_INDEX_+1 < sizeof...(Types_)) {
-        call_on_indexed_type<TRY_INDEX_+1,Types_...>(index, function);
-    } else {
+    static_assert(TRY_INDEX_ < sizeof...(Types_));
+    if (index < TRY_INDEX_ || index >= sizeof...(Types_))
         throw std::runtime_error("invalid index for variadic type sequence");
-    }
+    IndexedTypeCallTable_t<Function_,Types_...>::ENTRIES[index](function);
 }
 
 // Used to represent a value of a given type without needing to actually instantiate it.
@@ -0,0 +1,129 @@
+// 2021.01.04 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "lvd/endian.hpp"
+#include <limits>
+#include <type_traits>
+
+namespace lvd {
+
+//
+// LEB128 variable-length encoding for unsigned integers, and zigzag encoding for signed integers.
+// Each byte holds 7 bits of the value, least significant group first, and its high bit is set iff
+// more bytes follow.  Thus values less than 128 take 1 byte, and a uint64_t takes at most 10 bytes.
+// Signed integers are zigzag-encoded first, so that values of small magnitude (including negative
+// ones) are small, i.e. 0 -> 0, -1 -> 1, 1 -> 2, -2 -> 3, etc.
+//
+
+// The max number of bytes a varint-encoded uint64_t can take.
+inline size_t constexpr MAX_VARINT_SIZE = 10;
+
+// Is true iff T_ is varint-encoded when varint encoding is in effect.  1-byte types and bool are excluded,
+// since varint encoding can't make them smaller.
+template <typename T_>
+inline bool constexpr is_varint_encodable_v = std::is_integral_v<T_> && !std::is_same_v<T_,bool> && sizeof(T_) > 1;
+
+inline uint64_t constexpr zigzag_encoded (int64_t x) {
+    return (uint64_t(x) << 1) ^ uint64_t(x >> 63);
+}
+
+inline int64_t constexpr zigzag_decoded (uint64_t x) {
+    return int64_t(x >> 1) ^ -int64_t(x & 1);
+}
+
+// Returns the unsigned value that represents x in varint encoding (i.e. zigzag-encoded if signed).
+template <typename T_, typename = std::enable_if_t<is_varint_encodable_v<T_>>>
+uint64_t constexpr varint_representation_of (T_ x) {
+    if constexpr (std::is_signed_v<T_>)
+        return zigzag_encoded(int64_t(x));
+    else
+        return uint64_t(x);
+}
+
+// Inverse of varint_representation_of.  Returns false if x is out of the range of T_.
+template <typename T_, typename = std::enable_if_t<is_varint_encodable_v<T_>>>
+bool constexpr varint_representation_to (uint64_t x, T_ &dest) {
+    if constexpr (std::is_signed_v<T_>) {
+        auto y = zigzag_decoded(x);
+        if (y < int64_t(std::numeric_limits<T_>::min()) || y > int64_t(std::numeric_limits<T_>::max()))
+            return false;
+        dest = T_(y);
+    } else {
+        if (x > uint64_t(std::numeric_limits<T_>::max()))
+            return false;
+        dest = T_(x);
+    }
+    return true;
+}
+
+// Returns the number of bytes that encode_varint(x, ...) produces.
+inline size_t constexpr varint_size_of (uint64_t x) {
+    size_t retval = 1;
+    while (x >= 0x80) {
+        x >>= 7;
+        ++retval;
+    }
+    return retval;
+}
+
+// Writes the varint encoding of x to dest, which must have at least MAX_VARINT_SIZE bytes available.
+// Returns the number of bytes written.
+inline size_t encode_varint (uint64_t x, std::byte *dest) {
+    size_t i = 0;
+    while (x >= 0x80) {
+        dest[i++] = std::byte(uint8_t(x) | 0x80);
+        x >>= 7;
+    }
+    dest[i++] = std::byte(x);
+    return i;
+}
+
+// Decodes a varint from [begin, end), storing it in dest.  Returns the number of bytes consumed, or 0 if
+// [begin, end) doesn't start with a complete, valid varint (i.e. it's truncated, or it's longer than
+// MAX_VARINT_SIZE, or it overflows uint64_t).
+//
+// If at least 8 bytes are available, this decodes varints of up to 8 bytes (i.e. values less than 2^56)
+// without looping over the bytes: it loads 8 bytes as one word, finds the terminating byte by counting
+// trailing zeros, and packs the 7-bit groups together with a fixed sequence of masks and shifts.
+inline size_t decode_varint (std::byte const *begin, std::byte const *end, uint64_t &dest) {
+    auto available = size_t(end - begin);
+    if (available >= 8 && machine_endianness() == Endianness::LIL) {
+        uint64_t word;
+        std::memcpy(&word, begin, sizeof(word));
+        // The high bit of each byte that terminates a varint is clear.
+        uint64_t terminators = ~word & 0x8080808080808080ull;
+        if (terminators != 0) {
+            size_t size = size_t(__builtin_ctzll(terminators)) / 8 + 1;
+            if (size < 8)
+                word &= (uint64_t(1) << (8*size)) - 1;
+            word &= 0x7F7F7F7F7F7F7F7Full;
+            // Pack pairs of 7-bit groups into 14-bit groups, then 28-bit groups, then one 56-bit group.
+            word = ((word & 0x7F007F007F007F00ull) >> 1) | (word & 0x007F007F007F007Full);
+            word = ((word & 0x3FFF00003FFF0000ull) >> 2) | (word & 0x00003FFF00003FFFull);
+            word = ((word & 0x0FFFFFFF00000000ull) >> 4) | (word & 0x000000000FFFFFFFull);
+            dest = word;
+            return size;
+        }
+        // Otherwise it's at least 9 bytes, which is rare, so fall through to the byte-at-a-time loop.
+    }
+
+    uint64_t value = 0;
+    for (size_t i = 0; i < MAX_VARINT_SIZE && i < available; ++i) {
+        auto b = uint64_t(begin[i]);
+        // The 10th byte can only contribute the top bit of a uint64_t.
+        if (i == MAX_VARINT_SIZE-1 && b > 1)
+            return 0;
+        value |= (b & 0x7F) << (7*i);
+        if ((b & 0x80) == 0) {
+            dest = value;
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+} // end namespace lvd
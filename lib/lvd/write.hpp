@@ -2,37 +2,55 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <charconv>
 #include <cstddef>
-#include <iomanip>
 #include "lvd/Empty.hpp"
 #include "lvd/encoding.hpp"
 #include "lvd/literal.hpp"
+#include "lvd/type_interning.hpp"
 #include "lvd/type_string_of.hpp"
+#include "lvd/varint.hpp"
+#include <limits>
 #include <ostream>
+#include <stdexcept>
+#include <string>
 
 namespace lvd {
 
 // Template-specialize this in order to provide an implementation for writing a value to the stream.
 // Should provide:
 //
-// template <typename CharT_, typename Traits_>
-// std::basic_ostream<CharT_,Traits_> &operator() (
-//      std::basic_ostream<CharT_,Traits_> &out,
+// template <typename Ostream_>
+// Ostream_ &operator() (
+//      Ostream_ &out,
 //      Encoding_ const &enc,
 //      T_ const &src_val
 // ) const
+//
+// where Ostream_ is std::basic_ostream<CharT_,Traits_> or (for BinEncoding_t) ByteWriter, so
+// implementations should only use out.put and out.write.
 template <typename T_, typename Encoding_>
 struct WriteValue_t;
 
+// Defined below.
+template <typename Ostream_, typename T_, auto... Params_>
+Ostream_ &write_length_framed (Ostream_ &out, BinEncoding_t<Params_...> const &enc, T_ const &src_val);
+
 //
-// Convenience function for type deduction.
+// Convenience function for type deduction.  This also handles FramingEncoding::LENGTH_PREFIXED, so that
+// WriteValue_t implementations don't have to.
 //
 
 // NOTE: If you're getting a compile error like "invalid use of incomplete type...", then you
 // need to include <lvd/write_XXX.hpp> for some XXX, e.g. bin_array or text_pair.
-template <typename CharT_, typename Traits_, typename T_, typename Encoding_>
-std::basic_ostream<CharT_,Traits_> &write_value (std::basic_ostream<CharT_,Traits_> &out, Encoding_ const &enc, T_ const &src_val) {
-    return WriteValue_t<T_,Encoding_>()(out, enc, src_val);
+template <typename Ostream_, typename T_, typename Encoding_>
+Ostream_ &write_value (Ostream_ &out, Encoding_ const &enc, T_ const &src_val) {
+    if constexpr (is_length_framed_v<T_,Encoding_>)
+        return write_length_framed(out, enc, src_val);
+    else
+        return WriteValue_t<T_,Encoding_>()(out, enc, src_val);
 }
 
 //
@@ -56,21 +74,26 @@ struct WriteValue_Builtin_t;
 template <typename T_, auto... Params_>
 struct WriteValue_Builtin_t<T_,BinEncoding_t<Params_...>> {
     static_assert(is_endiannated_type_v<T_>);
-    template <typename CharT_, typename Traits_>
-    std::basic_ostream<CharT_,Traits_> &operator() (std::basic_ostream<CharT_,Traits_> &out, BinEncoding_t<Params_...> const &enc, T_ src_val) const {
+    template <typename Ostream_>
+    Ostream_ &operator() (Ostream_ &out, BinEncoding_t<Params_...> const &enc, T_ src_val) const {
         if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
             out << enc.with_demoted_type_encoding().out(type_of(src_val));
 
-        static_assert(sizeof(CharT_) == 1, "only supporting chars of size 1 for now");
+        static_assert(sizeof(typename Ostream_::char_type) == 1, "only supporting chars of size 1 for now");
 
         if constexpr (std::is_same_v<T_,bool>) {
             out.put(src_val ? uint8_t(1) : uint8_t(0));
+        } else if constexpr (enc.int_encoding() == IntEncoding::VARINT && is_varint_encodable_v<T_>) {
+            std::array<std::byte,MAX_VARINT_SIZE> buffer;
+            auto size = encode_varint(varint_representation_of(src_val), buffer.data());
+            out.write(reinterpret_cast<typename Ostream_::char_type const *>(buffer.data()), size);
         } else if constexpr (sizeof(T_) == 1) {
             out.put(char(src_val));
         } else {
             static_assert(sizeof(T_) > 1);
-            endian_change(machine_endianness(), enc.endianness(), src_val);
-            out.write(reinterpret_cast<CharT_ const *>(&src_val), sizeof(src_val));
+            if constexpr (!enc.is_statically_machine_endian())
+                endian_change(machine_endianness(), enc.endianness(), src_val);
+            out.write(reinterpret_cast<typename Ostream_::char_type const *>(&src_val), sizeof(src_val));
         }
         return out;
     }
@@ -83,25 +106,41 @@ struct WriteValue_Builtin_t<T_,TextEncoding_t<Params_...>> {
         if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
             out << ty<T_> << '(';
 
+        // Values are formatted into this buffer with std::to_chars, which is much cheaper than formatting via a
+        // temporary std::ostringstream, and produces the same output.  This is more than enough for any of
+        // the types handled here.
+        std::array<char,64> buffer;
+        char *end = buffer.data();
         if constexpr (std::is_same_v<T_,bool>) {
             out << (src_val ? "true" : "false");
         } else if constexpr (std::is_same_v<T_,std::byte>) {
-            out << "0x" << LVD_FMT(std::hex << std::uppercase << std::setw(2) << std::setfill('0') << uint32_t(src_val));
+            static char const HEX_DIGITS[] = "0123456789ABCDEF";
+            *end++ = '0';
+            *end++ = 'x';
+            *end++ = HEX_DIGITS[uint8_t(src_val) >> 4];
+            *end++ = HEX_DIGITS[uint8_t(src_val) & 0xF];
         } else if constexpr (std::is_same_v<T_,char>) {
             out << literal_of(src_val);
         } else if constexpr (std::is_same_v<T_,int8_t>) {
-            out << int32_t(src_val);
+            end = std::to_chars(buffer.data(), buffer.data()+buffer.size(), int32_t(src_val)).ptr;
         } else if constexpr (std::is_same_v<T_,uint8_t>) {
-            out << uint32_t(src_val);
+            end = std::to_chars(buffer.data(), buffer.data()+buffer.size(), uint32_t(src_val)).ptr;
         } else if constexpr (sizeof(T_) == 1) {
             static_assert(sizeof(T_) == -1, "unhandled case"); // Not sure how static_assert(false) is possible, so this is a hack
         } else if constexpr (std::is_integral_v<T_>) {
-            out << src_val;
+            end = std::to_chars(buffer.data(), buffer.data()+buffer.size(), src_val).ptr;
         } else if constexpr (std::is_floating_point_v<T_>) {
-            out << LVD_FMT(std::scientific << std::setprecision(std::numeric_limits<T_>::max_digits10) << src_val);
+            if constexpr (enc.float_encoding() == FloatEncoding::SHORTEST) {
+                end = std::to_chars(buffer.data(), buffer.data()+buffer.size(), src_val).ptr;
+            } else {
+                // This is specified to produce the same output as printf's %.*e, and therefore as std::scientific
+                // with std::setprecision(max_digits10).
+                end = std::to_chars(buffer.data(), buffer.data()+buffer.size(), src_val, std::chars_format::scientific, std::numeric_limits<T_>::max_digits10).ptr;
+            }
         } else {
             static_assert(sizeof(T_) == -1, "unhandled case"); // Not sure how static_assert(false) is possible, so this is a hack
         }
+        out.write(buffer.data(), end - buffer.data());
 
         if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
             out << ')';
@@ -123,14 +162,99 @@ template <typename Encoding_> struct WriteValue_t<uint64_t,Encoding_> : public W
 template <typename Encoding_> struct WriteValue_t<float,Encoding_> : public WriteValue_Builtin_t<float,Encoding_> { };
 template <typename Encoding_> struct WriteValue_t<double,Encoding_> : public WriteValue_Builtin_t<double,Encoding_> { };
 
+// Writes the count values starting at `values` (without any type info or size), producing the same output as
+// writing each one individually.  This is one out.write call if no byte-swapping is needed, otherwise the
+// values are byte-swapped a chunk at a time in a local buffer, with one out.write call per chunk.
+template <typename T_, typename Ostream_, auto... Params_>
+Ostream_ &write_bin_block (Ostream_ &out, BinEncoding_t<Params_...> const &enc, T_ const *values, size_t count) {
+    static_assert(is_bin_block_encodable_v<T_,BinEncoding_t<Params_...>>);
+    static_assert(sizeof(typename Ostream_::char_type) == 1, "only supporting chars of size 1 for now");
+
+    if constexpr (sizeof(T_) == 1 || enc.is_statically_machine_endian()) {
+        out.write(reinterpret_cast<typename Ostream_::char_type const *>(values), count*sizeof(T_));
+    } else {
+        if (enc.endianness() == machine_endianness()) {
+            out.write(reinterpret_cast<typename Ostream_::char_type const *>(values), count*sizeof(T_));
+        } else {
+            size_t constexpr CHUNK_SIZE = std::max(size_t(1), 0x1000 / sizeof(T_));
+            std::array<T_,CHUNK_SIZE> chunk;
+            for (size_t i = 0; i < count; i += CHUNK_SIZE) {
+                auto chunk_count = std::min(CHUNK_SIZE, count - i);
+                std::copy(values+i, values+i+chunk_count, chunk.data());
+                swap_byte_order_of_each_leaf(chunk.data(), chunk_count);
+                out.write(reinterpret_cast<typename Ostream_::char_type const *>(chunk.data()), chunk_count*sizeof(T_));
+            }
+        }
+    }
+    return out;
+}
+
+// Can be used in place of a std::ostream for binary encodings, and just counts the bytes written to it.  This is
+// used to determine the length of a length-framed value before writing it.
+class ByteCounter {
+public:
+
+    using char_type = char;
+    using traits_type = std::char_traits<char>;
+
+    ByteCounter &put (char_type) {
+        ++m_size;
+        return *this;
+    }
+    ByteCounter &write (char_type const *, std::streamsize count) {
+        m_size += size_t(count);
+        return *this;
+    }
+
+    bool good () const { return true; }
+    bool fail () const { return false; }
+    explicit operator bool () const { return true; }
+
+    size_t size () const { return m_size; }
+
+private:
+
+    size_t m_size = 0;
+};
+
+template <typename T_, auto... Params_>
+ByteCounter &operator<< (ByteCounter &out, Out_t<T_,BinEncoding_t<Params_...>> const &o) {
+    return write_value(out, o.encoding(), o.src_val());
+}
+
+// Writes the byte length of the encoding of src_val, followed by that encoding.  The length is determined by
+// first writing src_val to a ByteCounter, so each level of nested length-framed values costs another pass over
+// its contents (but not another allocation).
+template <typename Ostream_, typename T_, auto... Params_>
+Ostream_ &write_length_framed (Ostream_ &out, BinEncoding_t<Params_...> const &enc, T_ const &src_val) {
+    // Type strings written within a TypeInterningWriteSession depend on what was written before them, so the
+    // length determined below (which is without the session) wouldn't be the length actually written.  This is
+    // checked before anything is written, so that a rejected value doesn't leave a dangling length in out.
+    if constexpr (!std::is_same_v<Ostream_,ByteCounter> && enc.type_encoding() != TypeEncoding::EXCLUDED) {
+        if (TypeInterningWriteSession::of(out) != nullptr)
+            throw std::runtime_error("FramingEncoding::LENGTH_PREFIXED isn't supported within a TypeInterningWriteSession");
+    }
+
+    auto length_enc = enc.template with_type_encoding<TypeEncoding::EXCLUDED>();
+    ByteCounter counter;
+    WriteValue_t<T_,BinEncoding_t<Params_...>>()(counter, enc, src_val);
+    out << length_enc.out(counter.size());
+    if constexpr (std::is_same_v<Ostream_,ByteCounter>) {
+        // Only the length is needed, and that's already known.
+        return out.write(nullptr, std::streamsize(counter.size()));
+    } else {
+        return WriteValue_t<T_,BinEncoding_t<Params_...>>()(out, enc, src_val);
+    }
+}
+
 //
 // One for Empty, which has no content besides its type.
 //
 
 template <auto... Params_>
 struct WriteValue_t<Empty,BinEncoding_t<Params_...>> {
-    template <typename CharT_, typename Traits_>
-    std::basic_ostream<CharT_,Traits_> &operator() (std::basic_ostream<CharT_,Traits_> &out, BinEncoding_t<Params_...> const &enc, Empty const &src_val) const {
+    template <typename Ostream_>
+    Ostream_ &operator() (Ostream_ &out, BinEncoding_t<Params_...> const &enc, Empty const &src_val) const {
         if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
             out << enc.with_demoted_type_encoding().out(type_of(src_val));
         // No content.
@@ -0,0 +1,56 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include "lvd/bitpack.hpp"
+#include "lvd/BitPacked_t.hpp"
+#include "lvd/write.hpp"
+
+namespace lvd {
+
+// Writes a bitmap whose ith bit is bit_of applied to the ith of the count elements starting at `it`.  The bitmap
+// is built in a local buffer a chunk at a time, with one out.write call per chunk.
+template <typename Ostream_, typename Iterator_, typename BitOf_>
+Ostream_ &write_bitmap (Ostream_ &out, Iterator_ it, size_t count, BitOf_ const &bit_of) {
+    static_assert(sizeof(typename Ostream_::char_type) == 1, "only supporting chars of size 1 for now");
+
+    std::array<std::byte,0x1000> chunk;
+    for (size_t n = 0; n < count; n += 8*chunk.size()) {
+        auto chunk_count = std::min(8*chunk.size(), count - n);
+        std::fill(chunk.begin(), chunk.begin() + bitmap_size_of(chunk_count), std::byte{0});
+        for (size_t i = 0; i < chunk_count; ++i, ++it) {
+            if (bit_of(*it))
+                chunk[i/8] |= std::byte(1u << (i%8));
+        }
+        out.write(reinterpret_cast<typename Ostream_::char_type const *>(chunk.data()), bitmap_size_of(chunk_count));
+    }
+    return out;
+}
+
+template <typename Container_, auto... Params_>
+struct WriteValue_t<BitPacked_t<Container_>,BinEncoding_t<Params_...>> {
+    template <typename Ostream_>
+    Ostream_ &operator() (Ostream_ &out, BinEncoding_t<Params_...> const &enc, BitPacked_t<Container_> const &src_val) const {
+        if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
+            out << enc.with_demoted_type_encoding().out(type_of(src_val));
+
+        // This will suppress unnecessary inner element type info, since it's already present in the given type.
+        auto inner_enc = enc.with_demoted_type_encoding();
+        if constexpr (!src_val.has_fixed_size())
+            out << inner_enc.out(src_val.size());
+        if constexpr (src_val.is_optional_container()) {
+            write_bitmap(out, src_val.begin(), src_val.size(), [](auto const &element){ return element.has_value(); });
+            for (auto const &element : src_val) {
+                if (element.has_value())
+                    out << inner_enc.out(*element);
+            }
+            return out;
+        } else {
+            return write_bitmap(out, src_val.begin(), src_val.size(), [](bool element){ return element; });
+        }
+    }
+};
+
+} // end namespace lvd
@@ -0,0 +1,55 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include "lvd/Columnar_t.hpp"
+#include "lvd/write.hpp"
+#include <utility>
+
+namespace lvd {
+
+// Writes the INDEX_th field of each element of src_val (without any type info or size).  If the fields can be
+// block-encoded, they're gathered into a local buffer a chunk at a time, and each chunk is written as a block.
+template <size_t INDEX_, typename Container_, typename Ostream_, auto... Params_>
+Ostream_ &write_bin_column (Ostream_ &out, BinEncoding_t<Params_...> const &enc, Container_ const &src_val) {
+    using Column = ColumnType_t<INDEX_,Container_>;
+    if constexpr (is_bin_block_encodable_v<Column,BinEncoding_t<Params_...>>) {
+        size_t constexpr CHUNK_SIZE = std::max(size_t(1), 0x1000 / sizeof(Column));
+        std::array<Column,CHUNK_SIZE> chunk;
+        auto it = src_val.begin();
+        for (size_t n = 0; n < src_val.size(); n += CHUNK_SIZE) {
+            auto chunk_size = std::min(CHUNK_SIZE, src_val.size() - n);
+            for (size_t i = 0; i < chunk_size; ++i, ++it)
+                chunk[i] = std::get<INDEX_>(*it);
+            write_bin_block(out, enc, chunk.data(), chunk_size);
+        }
+    } else {
+        for (auto const &element : src_val)
+            out << enc.out(std::get<INDEX_>(element));
+    }
+    return out;
+}
+
+template <typename Container_, typename Ostream_, auto... Params_, size_t... INDICES_>
+Ostream_ &write_bin_columns (Ostream_ &out, BinEncoding_t<Params_...> const &enc, Container_ const &src_val, std::index_sequence<INDICES_...>) {
+    (write_bin_column<INDICES_>(out, enc, src_val), ...);
+    return out;
+}
+
+template <typename Container_, auto... Params_>
+struct WriteValue_t<Columnar_t<Container_>,BinEncoding_t<Params_...>> {
+    template <typename Ostream_>
+    Ostream_ &operator() (Ostream_ &out, BinEncoding_t<Params_...> const &enc, Columnar_t<Container_> const &src_val) const {
+        if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
+            out << enc.with_demoted_type_encoding().out(type_of(src_val));
+
+        // This will suppress unnecessary inner element type info, since it's already present in the given type.
+        auto inner_enc = enc.with_demoted_type_encoding();
+        out << inner_enc.out(src_val.size());
+        return write_bin_columns(out, inner_enc, src_val.container(), std::make_index_sequence<src_val.column_count()>());
+    }
+};
+
+} // end namespace lvd
@@ -0,0 +1,57 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include <array>
+#include "lvd/bitpack.hpp"
+#include "lvd/DeltaEncoded_t.hpp"
+#include "lvd/write.hpp"
+
+namespace lvd {
+
+template <typename Container_, auto... Params_>
+struct WriteValue_t<DeltaEncoded_t<Container_>,BinEncoding_t<Params_...>> {
+    template <typename Ostream_>
+    Ostream_ &operator() (Ostream_ &out, BinEncoding_t<Params_...> const &enc, DeltaEncoded_t<Container_> const &src_val) const {
+        static_assert(sizeof(typename Ostream_::char_type) == 1, "only supporting chars of size 1 for now");
+        using Key = typename DeltaEncoded_t<Container_>::Key;
+        using UnsignedKey = typename DeltaEncoded_t<Container_>::UnsignedKey;
+
+        if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
+            out << enc.with_demoted_type_encoding().out(type_of(src_val));
+
+        // This will suppress unnecessary inner element type info, since it's already present in the given type.
+        auto inner_enc = enc.with_demoted_type_encoding();
+        out << inner_enc.out(src_val.size());
+        if (src_val.empty())
+            return out;
+
+        auto it = src_val.begin();
+        Key previous = src_val.key_of(*it);
+        out << inner_enc.out(previous);
+        std::array<uint64_t,DELTA_BLOCK_SIZE> deltas;
+        std::array<std::byte,bit_packed_size_of(DELTA_BLOCK_SIZE,64)+BIT_PACKING_PADDING> packed;
+        for (++it; it != src_val.end(); ) {
+            size_t count = 0;
+            uint64_t all_delta_bits = 0;
+            for ( ; count < DELTA_BLOCK_SIZE && it != src_val.end(); ++count, ++it) {
+                Key key = src_val.key_of(*it);
+                deltas[count] = UnsignedKey(UnsignedKey(key) - UnsignedKey(previous));
+                all_delta_bits |= deltas[count];
+                previous = key;
+            }
+            auto bit_width = bit_width_of(all_delta_bits);
+            out << inner_enc.out(uint8_t(bit_width));
+            pack_bits(deltas.data(), count, bit_width, packed.data());
+            out.write(reinterpret_cast<typename Ostream_::char_type const *>(packed.data()), bit_packed_size_of(count, bit_width));
+        }
+
+        if constexpr (src_val.is_map()) {
+            for (auto const &[key, value] : src_val)
+                out << inner_enc.out(value);
+        }
+        return out;
+    }
+};
+
+} // end namespace lvd
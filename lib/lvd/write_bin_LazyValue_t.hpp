@@ -0,0 +1,19 @@
+// 2021.01.22 - Copyright Victor Dods - Licensed under Apache 2.0
+
+#pragma once
+
+#include "lvd/LazyValue_t.hpp"
+#include "lvd/write.hpp"
+
+namespace lvd {
+
+// This writes the (decoded) value, so that LazyValue_t<T_> has the same encoding as T_.
+template <typename T_, auto... Params_>
+struct WriteValue_t<LazyValue_t<T_>,BinEncoding_t<Params_...>> {
+    template <typename Ostream_>
+    Ostream_ &operator() (Ostream_ &out, BinEncoding_t<Params_...> const &enc, LazyValue_t<T_> const &src_val) const {
+        return out << enc.out(src_val.value());
+    }
+};
+
+} // end namespace lvd
@@ -10,16 +10,20 @@ namespace lvd {
 
 template <typename T_, size_t N_, auto... Params_>
 struct WriteValue_t<std::array<T_,N_>,BinEncoding_t<Params_...>> {
-    template <typename CharT_, typename Traits_>
-    std::basic_ostream<CharT_,Traits_> &operator() (std::basic_ostream<CharT_,Traits_> &out, BinEncoding_t<Params_...> const &enc, std::array<T_,N_> const &src_val) const {
+    template <typename Ostream_>
+    Ostream_ &operator() (Ostream_ &out, BinEncoding_t<Params_...> const &enc, std::array<T_,N_> const &src_val) const {
         if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
             out << enc.with_demoted_type_encoding().out(type_of(src_val));
 
         // This will suppress unnecessary inner element type info, since it's already present in the given type.
         auto inner_enc = enc.with_demoted_type_encoding();
-        for (auto const &element : src_val)
-            out << inner_enc.out(element);
-        return out;
+        if constexpr (is_bin_block_encodable_v<T_,decltype(inner_enc)>) {
+            return write_bin_block(out, inner_enc, src_val.data(), N_);
+        } else {
+            for (auto const &element : src_val)
+                out << inner_enc.out(element);
+            return out;
+        }
     }
 };
 
@@ -12,8 +12,8 @@ struct WriteValue_Container_t;
 
 template <typename Container_, auto... Params_>
 struct WriteValue_Container_t<Container_,BinEncoding_t<Params_...>> {
-    template <typename CharT_, typename Traits_>
-    std::basic_ostream<CharT_,Traits_> &operator() (std::basic_ostream<CharT_,Traits_> &out, BinEncoding_t<Params_...> const &enc, Container_ const &src_val) const {
+    template <typename Ostream_>
+    Ostream_ &operator() (Ostream_ &out, BinEncoding_t<Params_...> const &enc, Container_ const &src_val) const {
         if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
             out << enc.with_demoted_type_encoding().out(type_of(src_val));
 
@@ -10,14 +10,17 @@ namespace lvd {
 
 template <typename... Types_, auto... Params_>
 struct WriteValue_t<std::pair<Types_...>,BinEncoding_t<Params_...>> {
-    template <typename CharT_, typename Traits_>
-    std::basic_ostream<CharT_,Traits_> &operator() (std::basic_ostream<CharT_,Traits_> &out, BinEncoding_t<Params_...> const &enc, std::pair<Types_...> const &src_val) const {
+    template <typename Ostream_>
+    Ostream_ &operator() (Ostream_ &out, BinEncoding_t<Params_...> const &enc, std::pair<Types_...> const &src_val) const {
         if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
             out << enc.with_demoted_type_encoding().out(type_of(src_val));
 
         // This will suppress unnecessary inner element type info, since it's already present in the given type.
         auto inner_enc = enc.with_demoted_type_encoding();
-        return out << inner_enc.out(src_val.first) << inner_enc.out(src_val.second);
+        if constexpr (is_bin_block_encodable_v<std::pair<Types_...>,decltype(inner_enc)>)
+            return write_bin_block(out, inner_enc, &src_val, 1);
+        else
+            return out << inner_enc.out(src_val.first) << inner_enc.out(src_val.second);
     }
 };
 
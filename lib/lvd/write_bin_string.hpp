@@ -10,30 +10,26 @@ namespace lvd {
 
 template <typename... Types_, auto... Params_>
 struct WriteValue_t<std::basic_string<Types_...>,BinEncoding_t<Params_...>> {
-    template <typename CharT_, typename Traits_>
-    std::basic_ostream<CharT_,Traits_> &operator() (std::basic_ostream<CharT_,Traits_> &out, BinEncoding_t<Params_...> const &enc, std::basic_string<Types_...> const &src_val) const {
+    template <typename Ostream_>
+    Ostream_ &operator() (Ostream_ &out, BinEncoding_t<Params_...> const &enc, std::basic_string<Types_...> const &src_val) const {
         if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
             out << enc.with_demoted_type_encoding().out(type_of(src_val));
 
         // This will suppress unnecessary inner element type info, since it's already present in the given type.
         auto inner_enc = enc.with_demoted_type_encoding();
 
-        static_assert(sizeof(CharT_) == 1, "only supporting chars of size 1 for now");
+        static_assert(sizeof(typename Ostream_::char_type) == 1, "only supporting chars of size 1 for now");
 
         out << inner_enc.out(src_val.size()); // TODO: Limit to uint32_t
-        if constexpr (sizeof(src_val[0]) == 1) {
-            // No need to byte-order-swap in this case.
-            out.write(reinterpret_cast<CharT_ const *>(&src_val[0]), src_val.size()*sizeof(src_val[0]));
-        } else if (machine_endianness() == enc.endianness()) {
-            // No need to byte-order-swap in this case.
-            out.write(reinterpret_cast<CharT_ const *>(&src_val[0]), src_val.size()*sizeof(src_val[0]));
+        if constexpr (is_bin_block_encodable_v<typename std::basic_string<Types_...>::value_type,decltype(inner_enc)>) {
+            // This only byte-swaps if needed, and never for 1-byte chars.
+            return write_bin_block(out, inner_enc, src_val.data(), src_val.size());
         } else {
-            static_assert(sizeof(src_val[0]) > 1);
-            // Have to write each element individually, and this will take care of the byte-swap.
+            // E.g. wide chars that are varint-encoded.
             for (auto const &c : src_val)
                 out << inner_enc.out(c);
+            return out;
         }
-        return out;
     }
 };
 
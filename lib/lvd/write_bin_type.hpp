@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "lvd/type_id.hpp"
+#include "lvd/type_interning.hpp"
 #include "lvd/type_string_of.hpp"
 #include "lvd/write.hpp"
 #include "lvd/write_bin_string.hpp"
@@ -10,16 +12,30 @@ namespace lvd {
 
 template <typename T_, auto... Params_>
 struct WriteValue_t<Type_t<T_>,BinEncoding_t<Params_...>> {
-    template <typename CharT_, typename Traits_>
-    std::basic_ostream<CharT_,Traits_> &operator() (std::basic_ostream<CharT_,Traits_> &out, BinEncoding_t<Params_...> const &enc, Type_t<T_> const &src_val) const {
+    template <typename Ostream_>
+    Ostream_ &operator() (Ostream_ &out, BinEncoding_t<Params_...> const &enc, Type_t<T_> const &src_val) const {
         if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
             out << enc.with_demoted_type_encoding().out(std::string("type")); // This is informally defined for now, and may change later.
 
         // This will suppress unnecessary inner element type info, since it's already present in the given type.
         auto inner_enc = enc.with_demoted_type_encoding();
-        // Just encode T_ as its TypeString for now.  Other choices could be the type_info hash (not portable), or
-        // some deterministic index assigned by a registration structure (this is the best).
-        return out << inner_enc.out(type_string_of<T_>());
+        auto varint_enc = inner_enc.template with_int_encoding<IntEncoding::VARINT>();
+        // If a TypeInterningWriteSession is attached, encode T_ as a back-reference to its TypeString if possible,
+        // and otherwise as its TypeString in full.
+        if (auto session = TypeInterningWriteSession::of(out); session != nullptr) {
+            auto const &type_string = type_string_of<T_>();
+            auto back_reference = session->back_reference_of(type_string);
+            out << varint_enc.out(uint64_t(back_reference));
+            if (back_reference == 0)
+                out << inner_enc.out(type_string);
+            return out;
+        }
+        // Otherwise encode T_ as its type tag, which is built from registered TypeIds (as varints, so they typically take
+        // 1 or 2 bytes each), falling back to TypeStrings for unregistered types.
+        static_assert(sizeof(typename Ostream_::char_type) == 1, "only supporting chars of size 1 for now");
+        auto const &type_tag = type_tag_of<T_>();
+        out.write(reinterpret_cast<typename Ostream_::char_type const *>(type_tag.data()), type_tag.size());
+        return out;
     }
 };
 
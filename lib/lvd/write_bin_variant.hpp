@@ -13,8 +13,8 @@ struct WriteValue_t<std::variant<Types_...>,BinEncoding_t<Params_...>> {
     static_assert(sizeof...(Types_) > 0, "empty variants not (yet) supported");
     static_assert(sizeof...(Types_) < 0x10000, "that's a lot of types, guy!");
 
-    template <typename CharT_, typename Traits_>
-    std::basic_ostream<CharT_,Traits_> &operator() (std::basic_ostream<CharT_,Traits_> &out, BinEncoding_t<Params_...> const &enc, std::variant<Types_...> const &src_val) const {
+    template <typename Ostream_>
+    Ostream_ &operator() (Ostream_ &out, BinEncoding_t<Params_...> const &enc, std::variant<Types_...> const &src_val) const {
         if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
             out << enc.with_demoted_type_encoding().out(type_of(src_val));
 
@@ -24,7 +24,7 @@ struct WriteValue_t<std::variant<Types_...>,BinEncoding_t<Params_...>> {
 
         // Write the alternative's type and value itself.  Have to use visit to do this generically.
         return std::visit(
-            [&out, &enc](auto &&src_alternative) -> std::basic_ostream<CharT_,Traits_>& {
+            [&out, &enc](auto &&src_alternative) -> Ostream_& {
                 auto inner_enc = enc.with_demoted_type_encoding();
                 // Write the type, if called for.
                 if (enc.type_encoding() == TypeEncoding::INCLUDED)
@@ -9,6 +9,22 @@
 namespace lvd {
 
 template <typename... Types_, auto... Params_>
-struct WriteValue_t<std::vector<Types_...>,BinEncoding_t<Params_...>> : public WriteValue_Container_t<std::vector<Types_...>,BinEncoding_t<Params_...>> { };
+struct WriteValue_t<std::vector<Types_...>,BinEncoding_t<Params_...>> {
+    template <typename Ostream_>
+    Ostream_ &operator() (Ostream_ &out, BinEncoding_t<Params_...> const &enc, std::vector<Types_...> const &src_val) const {
+        using ValueType = typename std::vector<Types_...>::value_type;
+        // This will suppress unnecessary inner element type info, since it's already present in the given type.
+        auto inner_enc = enc.with_demoted_type_encoding();
+        if constexpr (is_bin_block_encodable_v<ValueType,decltype(inner_enc)>) {
+            // Same output as WriteValue_Container_t, but the elements are written as a block.
+            if constexpr (enc.type_encoding() == TypeEncoding::INCLUDED)
+                out << enc.with_demoted_type_encoding().out(type_of(src_val));
+            out << inner_enc.out(src_val.size());
+            return write_bin_block(out, inner_enc, src_val.data(), src_val.size());
+        } else {
+            return WriteValue_Container_t<std::vector<Types_...>,BinEncoding_t<Params_...>>()(out, enc, src_val);
+        }
+    }
+};
 
 } // end namespace lvd